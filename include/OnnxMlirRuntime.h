@@ -23,10 +23,15 @@
 #endif
 
 #include <onnx-mlir/Runtime/OMEntryPoint.h>
+#include <onnx-mlir/Runtime/OMExternalConstant.h>
 #include <onnx-mlir/Runtime/OMInstrument.h>
+#include <onnx-mlir/Runtime/OMMemoryPool.h>
+#include <onnx-mlir/Runtime/OMOutputBuffers.h>
+#include <onnx-mlir/Runtime/OMScratchArena.h>
 #include <onnx-mlir/Runtime/OMSignature.h>
 #include <onnx-mlir/Runtime/OMTensor.h>
 #include <onnx-mlir/Runtime/OMTensorList.h>
+#include <onnx-mlir/Runtime/OMThreadPool.h>
 
 /*! \mainpage ONNX-MLIR Runtime API documentation
  *
@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---- OMExternalConstant.h - OMExternalConstant Declaration header ----===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the runtime functions accessing the
+// constants that a model stores in a separate file.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMEXTERNALCONSTANT_H
+#define ONNX_MLIR_OMEXTERNALCONSTANT_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Get the address of a constant stored in the constants file of a
+ * model compiled with `--store-constants-to-file`.
+ *
+ * The constants file is mapped into memory, read-only, at the first call and
+ * stays mapped until the process exits. Its pages are backed by the file, so
+ * that they are shared by all processes running the model. A relative file
+ * name is looked up in the directory given by the `ONNX_MLIR_CONSTANTS_PATH`
+ * environment variable if it is set, and otherwise in the directory of the
+ * model library. The process is aborted if the file cannot be mapped.
+ *
+ * When the `ONNX_MLIR_SHARED_CONSTANTS_DIR` environment variable is set, the
+ * file is first copied into that directory, for example `/dev/shm`, under a
+ * name derived from the hash of its content, unless a previous process did it
+ * already. The copy is mapped instead of the file, so that all the processes
+ * running the same model share a single read-only copy of its constants, even
+ * when they load the model from different locations.
+ *
+ * This function is called by the generated code, and is thread safe.
+ *
+ * @param addr address caching the address of the mapped file, NULL before
+ * the first call.
+ * @param fileName name of the constants file.
+ * @param fileSize size in bytes of the constants file.
+ * @param fileHash hash of the content of the constants file.
+ * @param offset offset in bytes of the constant in the file.
+ * @return address of the constant.
+ */
+OM_EXTERNAL_VISIBILITY void *omGetExternalConstantAddr(void **addr,
+    const char *fileName, int64_t fileSize, uint64_t fileHash, int64_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMEXTERNALCONSTANT_H
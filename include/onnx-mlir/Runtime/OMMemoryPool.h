@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- OMMemoryPool.h - OMMemoryPool Declaration header ----------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the memory pools kept across inferences
+// by models compiled with --reuse-memory-pool.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMMEMORYPOOL_H
+#define ONNX_MLIR_OMMEMORYPOOL_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Acquire a memory pool for an inference.
+ *
+ * The memory pool is the buffer supplied by omMemoryPoolSetBuffer if it is
+ * large enough and not used by another inference, or a memory pool released
+ * by a previous inference, or a new one otherwise. This function is called by
+ * the generated code.
+ *
+ * @param size size in bytes of the memory pool.
+ * @param alignment alignment in bytes of the memory pool.
+ * @return address of the memory pool, or NULL if the allocation fails.
+ */
+OM_EXTERNAL_VISIBILITY void *omMemoryPoolAcquire(
+    int64_t size, int64_t alignment);
+
+/**
+ * \brief Release a memory pool acquired by omMemoryPoolAcquire.
+ *
+ * The memory pool is kept for the next inferences. This function is called by
+ * the generated code.
+ *
+ * @param pool address of the memory pool.
+ */
+OM_EXTERNAL_VISIBILITY void omMemoryPoolRelease(void *pool);
+
+/**
+ * \brief Supply the memory of the memory pools.
+ *
+ * The buffer is used as memory pool by one inference at a time, concurrent
+ * inferences use memory pools allocated by the runtime. The buffer is owned
+ * by the caller, and must stay valid until it is replaced. The buffer cannot
+ * be replaced while an inference uses it.
+ *
+ * @param buffer address of the buffer, or NULL to stop using the buffer.
+ * @param size size in bytes of the buffer.
+ * @return 0 on success, or -1 with errno set to EBUSY if an inference uses
+ * the current buffer, which is then kept.
+ */
+OM_EXTERNAL_VISIBILITY int omMemoryPoolSetBuffer(void *buffer, int64_t size);
+
+/**
+ * \brief Get the size of the buffer to supply to omMemoryPoolSetBuffer.
+ *
+ * @return size in bytes of a buffer that can hold the largest memory pool
+ * acquired so far, whatever the address of the buffer.
+ */
+OM_EXTERNAL_VISIBILITY int64_t omMemoryPoolGetMaxSize(void);
+
+/**
+ * \brief Free the memory pools kept for the next inferences.
+ *
+ * Memory pools used by running inferences are kept when released.
+ */
+OM_EXTERNAL_VISIBILITY void omMemoryPoolReleaseAll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMMEMORYPOOL_H
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- OMOutputBuffers.h - OMOutputBuffers Declaration header ------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the output buffers supplied by the caller
+// to models compiled with --caller-output-buffers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMOUTPUTBUFFERS_H
+#define ONNX_MLIR_OMOUTPUTBUFFERS_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+#include "onnx-mlir/Runtime/OMTensorList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Supply the output buffers of the next inference run by the calling
+ * thread.
+ *
+ * This function is called by the `run_<entry point>_with_outputs` entry
+ * points before running the model, which then computes each output in the
+ * buffer of the corresponding tensor of outputs when the tensor has the data
+ * type and shape of the output, and its buffer is suitably aligned.
+ *
+ * @param outputs list of tensors whose buffers receive the outputs, owned by
+ * the caller.
+ */
+OM_EXTERNAL_VISIBILITY void omOutputBuffersBegin(OMTensorList *outputs);
+
+/**
+ * \brief Allocate the buffer of an output of the model.
+ *
+ * This function is called by the generated code. The buffer is the one of the
+ * tensor supplied for the output by omOutputBuffersBegin, if any, when the
+ * tensor has the data type and shape of the output, is contiguous, and its
+ * buffer has the requested size and alignment. Otherwise, it is allocated
+ * with malloc with room to align it.
+ *
+ * @param index index of the output.
+ * @param dataType ONNX data type of the output.
+ * @param rank rank of the output.
+ * @param shape shape of the output.
+ * @param size size in bytes of the output.
+ * @param alignment alignment in bytes of the output.
+ * @return address of the allocation, freed by the output tensor unless it is
+ * the supplied buffer, or NULL if the allocation fails.
+ */
+OM_EXTERNAL_VISIBILITY void *omOutputAlloc(int64_t index, int64_t dataType,
+    int64_t rank, const int64_t *shape, int64_t size, int64_t alignment);
+
+/**
+ * \brief Complete the inference started after omOutputBuffersBegin.
+ *
+ * The tensors of results computed in the supplied buffers do not own them.
+ * The other results are copied into the supplied tensors that have their
+ * data type, shape and strides. This function is called by the
+ * `run_<entry point>_with_outputs` entry points after running the model.
+ *
+ * @param results list of the output tensors returned by the model, or NULL
+ * if the inference failed.
+ * @return results.
+ */
+OM_EXTERNAL_VISIBILITY OMTensorList *omOutputBuffersEnd(OMTensorList *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMOUTPUTBUFFERS_H
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- OMScratchArena.h - OMScratchArena Declaration header --------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the per-thread scratch arenas holding the
+// internal buffers of models compiled with --scratch-arena.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMSCRATCHARENA_H
+#define ONNX_MLIR_OMSCRATCHARENA_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Allocate a buffer from the scratch arena of the calling thread.
+ *
+ * The buffer reuses the memory of a buffer previously freed by the calling
+ * thread when one is large enough, and is allocated with malloc otherwise.
+ * This function is called by the generated code.
+ *
+ * @param size size in bytes of the buffer.
+ * @param alignment alignment in bytes of the buffer.
+ * @return address of the buffer, or NULL if the allocation fails.
+ */
+OM_EXTERNAL_VISIBILITY void *omScratchAlloc(int64_t size, int64_t alignment);
+
+/**
+ * \brief Free a buffer allocated by omScratchAlloc, possibly by another
+ * thread.
+ *
+ * The memory of the buffer is kept in the scratch arena of the calling thread
+ * for its next allocations. This function is called by the generated code.
+ *
+ * @param buffer address of the buffer.
+ */
+OM_EXTERNAL_VISIBILITY void omScratchFree(void *buffer);
+
+/**
+ * \brief Release the memory kept in the scratch arena of the calling thread.
+ *
+ * The memory kept by a thread is released when the thread exits, except on
+ * Windows.
+ */
+OM_EXTERNAL_VISIBILITY void omScratchRelease(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMSCRATCHARENA_H
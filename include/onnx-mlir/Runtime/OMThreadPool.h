@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- OMThreadPool.h - OMThreadPool Declaration header ----------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the runtime thread pool API functions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMTHREADPOOL_H
+#define ONNX_MLIR_OMTHREADPOOL_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "onnx-mlir/Compiler/OMCompilerMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Function executing the iterations [begin, end) of a parallel loop.
+ */
+typedef void (*OMParallelForBody)(int64_t begin, int64_t end, void *ctx);
+
+/**
+ * \brief Set the number of threads used to run parallel loops of a model,
+ * including the calling thread.
+ *
+ * By default, the number of threads is read from the `ONNX_MLIR_NUM_THREADS`
+ * environment variable and falls back to the number of online processors.
+ * Worker threads are created lazily and reused across inferences.
+ *
+ * @param numThreads number of threads, a value smaller than 1 restores the
+ * default.
+ */
+OM_EXTERNAL_VISIBILITY void omSetNumThreads(int64_t numThreads);
+
+/**
+ * \brief Get the number of threads used to run parallel loops of a model.
+ *
+ * @return number of threads, including the calling thread.
+ */
+OM_EXTERNAL_VISIBILITY int64_t omGetNumThreads(void);
+
+/**
+ * \brief Run the iterations [0, numIterations) of a parallel loop on the
+ * thread pool. Returns once all iterations have been executed.
+ *
+ * Iterations are split into ranges that are distributed among the threads.
+ * Threads running out of work steal ranges from the other threads. When the
+ * pool is already busy (e.g. nested parallel loops or concurrent inferences),
+ * the loop is executed by the calling thread.
+ *
+ * @param body function executing a range of iterations.
+ * @param numIterations number of iterations of the parallel loop.
+ * @param ctx opaque pointer passed to each invocation of body.
+ */
+OM_EXTERNAL_VISIBILITY void omParallelFor(
+    OMParallelForBody body, int64_t numIterations, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMTHREADPOOL_H
@@ -198,11 +198,45 @@ llvm::cl::opt<bool> enableParallel("parallel",
                    "Set to 'true' if you want to enable parallelization."),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<bool> enableSimdElementwise("simd-elementwise",
+    llvm::cl::desc("Enable SIMD code generation for element-wise ops "
+                   "(default=false)\n"
+                   "Set to 'true' if you want to vectorize element-wise ops."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> enableFuseElementwise("fuse-elementwise",
+    llvm::cl::desc("Fuse chains of element-wise ops into a single loop nest "
+                   "(default=false)\n"
+                   "Set to 'true' if you want to fuse element-wise ops."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<int64_t> l1CacheSize("l1-cache-size",
+    llvm::cl::desc("Size in KiB of the L1 data cache of the target, used to "
+                   "block loop nests (default=32)."),
+    llvm::cl::init(32), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<int64_t> l2CacheSize("l2-cache-size",
+    llvm::cl::desc("Size in KiB of the L2 cache of the target, used to block "
+                   "loop nests (default=1024)."),
+    llvm::cl::init(1024), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<int64_t> l3CacheSize("l3-cache-size",
+    llvm::cl::desc("Size in KiB of the L3 cache of the target, used to block "
+                   "loop nests (default=8192)."),
+    llvm::cl::init(8192), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> enableSimdDataLayout("simd-data-layout",
     llvm::cl::desc("Enable SIMD optimization for convolution (default=false)\n"
                    "Set to 'true' if you want to enable SIMD optimizations."),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<bool> enableConvAlgorithmSelection("conv-algorithm-selection",
+    llvm::cl::desc("Select the im2col or Winograd lowering of convolutions "
+                   "with a cost model (default=false)\n"
+                   "Set to 'true' if you want to enable this selection. "
+                   "Winograd may change the\nrounding of the results."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> verifyInputTensors("verifyInputTensors",
     llvm::cl::desc(
         "Verify input tensors whenever the entry point function is called.\n"
@@ -210,6 +244,73 @@ llvm::cl::opt<bool> verifyInputTensors("verifyInputTensors",
         "at runtime."),
     llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
 
+llvm::cl::opt<bool> storeConstantsToFile("store-constants-to-file",
+    llvm::cl::desc(
+        "Store the data of large constants to a separate file instead of "
+        "embedding it in the generated code (default=false).\n"
+        "Identical constants are stored once. The file, named "
+        "<output>.constants.bin, must be located next to the generated "
+        "library or in the directory given by the ONNX_MLIR_CONSTANTS_PATH "
+        "environment variable. It is mapped into memory at the first use of "
+        "a constant, and its pages are shared by all processes running the "
+        "model. Processes loading the model from different locations share "
+        "a copy of the file placed in the directory given by the "
+        "ONNX_MLIR_SHARED_CONSTANTS_DIR environment variable, if set."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> useScratchArena("scratch-arena",
+    llvm::cl::desc(
+        "Allocate the internal buffers of the model from per-thread scratch "
+        "arenas (default=false).\n"
+        "Buffers freed by a thread are kept for its next inferences, so that "
+        "threads running the model concurrently neither contend on the "
+        "allocator nor allocate memory pools again at each inference. "
+        "omScratchRelease frees the buffers kept by the calling thread."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> reuseMemoryPool("reuse-memory-pool",
+    llvm::cl::desc(
+        "Keep the memory pools bundling the internal buffers of the model "
+        "allocated across inferences (default=false).\n"
+        "A memory pool is allocated at the first inference, and reused by "
+        "the next ones instead of being allocated and freed each time. The "
+        "caller can also supply the memory of the pool with "
+        "omMemoryPoolSetBuffer. omMemoryPoolReleaseAll frees the kept "
+        "memory pools. Requires --enable-memory-bundling."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> callerOutputBuffers("caller-output-buffers",
+    llvm::cl::desc(
+        "Emit an entry point run_<name>_with_outputs next to each entry "
+        "point, taking the output tensors supplied by the caller "
+        "(default=false).\n"
+        "The model computes each output in the buffer of the supplied tensor "
+        "when the buffer has the size of the output and is suitably aligned, "
+        "instead of allocating it, and copies the other outputs into the "
+        "supplied tensors with their type and shape."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> planStaticMemory("plan-static-memory",
+    llvm::cl::desc(
+        "Assign the offsets of the internal buffers in the static memory "
+        "pools based on their live intervals (default=false).\n"
+        "Buffers of any size that are not live at the same time share memory, "
+        "so that a memory pool only holds the buffers live at its peak. "
+        "Requires --enable-memory-bundling."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> enableInPlaceElementwise("in-place-elementwise",
+    llvm::cl::desc(
+        "Compute element-wise ops in the buffer of an operand that has no "
+        "other use (default=false).\n"
+        "Set to 'true' if you want to reuse the buffers of dead operands."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
+llvm::cl::opt<bool> reportMemoryPlan("report-memory-plan",
+    llvm::cl::desc("Report the peak memory of the static memory pools planned "
+                   "by --plan-static-memory (default=false)."),
+    llvm::cl::init(false), llvm::cl::cat(OnnxMlirOptions));
+
 llvm::cl::opt<bool> allowSorting("allowSorting",
     llvm::cl::desc("Perform topological sort on onnx graph"),
     llvm::cl::init(true), llvm::cl::cat(OnnxMlirOptions));
@@ -402,7 +503,7 @@ std::string getOptimizationLevelOption() {
 // Support for Xopt.
 void setXoptOption(const std::vector<std::string> &flags) {
   for (const std::string &flag : flags)
-    Xllc.addValue(flag);
+    Xopt.addValue(flag);
 }
 
 void clearXoptOption() { Xopt.clear(); }
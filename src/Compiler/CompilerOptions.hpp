@@ -59,6 +59,13 @@ extern llvm::cl::list<std::string> Xopt;
 extern llvm::cl::list<std::string> Xllc;
 extern llvm::cl::opt<std::string> mllvm;
 extern llvm::cl::opt<bool> verifyInputTensors;
+extern llvm::cl::opt<bool> storeConstantsToFile;
+extern llvm::cl::opt<bool> useScratchArena;
+extern llvm::cl::opt<bool> reuseMemoryPool;
+extern llvm::cl::opt<bool> callerOutputBuffers;
+extern llvm::cl::opt<bool> planStaticMemory;
+extern llvm::cl::opt<bool> enableInPlaceElementwise;
+extern llvm::cl::opt<bool> reportMemoryPlan;
 extern llvm::cl::opt<bool> allowSorting;
 extern llvm::cl::opt<std::string> reportHeapBefore;
 extern llvm::cl::opt<std::string> reportHeapAfter;
@@ -72,7 +79,13 @@ extern llvm::cl::opt<int> onnxOpTransformThreshold;
 extern llvm::cl::opt<bool> onnxOpTransformReport;
 extern llvm::cl::opt<bool> onnxConstPropReport;
 extern llvm::cl::opt<bool> enableParallel;
+extern llvm::cl::opt<bool> enableSimdElementwise;
+extern llvm::cl::opt<bool> enableFuseElementwise;
 extern llvm::cl::opt<bool> enableSimdDataLayout;
+extern llvm::cl::opt<bool> enableConvAlgorithmSelection;
+extern llvm::cl::opt<int64_t> l1CacheSize;
+extern llvm::cl::opt<int64_t> l2CacheSize;
+extern llvm::cl::opt<int64_t> l3CacheSize;
 
 // The customEnvFlags must be scanned before the normal options.
 bool parseCustomEnvFlagsCommandLineOption(int argc, const char *const *argv,
@@ -62,8 +62,13 @@ void addONNXToMLIRPasses(mlir::PassManager &pm, bool targetCPU) {
   // Convolution Optimization for CPU: enable when there are no accelerators.
   if (targetCPU) {
     pm.addNestedPass<func::FuncOp>(
-        onnx_mlir::createConvOptONNXToONNXPass(enableSimdDataLayout));
+        onnx_mlir::createConvOptONNXToONNXPass(
+            enableSimdDataLayout, enableConvAlgorithmSelection));
     pm.addPass(onnx_mlir::createShapeInferencePass());
+    // Keep activations in the SIMD data layout between convolutions.
+    if (enableSimdDataLayout)
+      pm.addNestedPass<func::FuncOp>(
+          onnx_mlir::createONNXLayoutPropagationPass());
   }
   // There are more opportunities for const propagation once all tensors have
   // inferred shapes.
@@ -73,7 +78,8 @@ void addONNXToMLIRPasses(mlir::PassManager &pm, bool targetCPU) {
   if (onnxOpTransformThreshold > 0) {
     // Dynamic iterate in ONNXOpTransformPass
     pm.addPass(onnx_mlir::createONNXOpTransformPass(onnxOpTransformThreshold,
-        onnxOpTransformReport, targetCPU, enableSimdDataLayout));
+        onnxOpTransformReport, targetCPU, enableSimdDataLayout,
+        enableConvAlgorithmSelection));
   } else {
     // Statically add extra passes
     for (int i = 0; i < repeatOnnxTransform; i++) {
@@ -128,7 +134,11 @@ void addONNXToKrnlPasses(mlir::PassManager &pm, int optLevel, bool enableCSE,
   if (enableInstrumentONNXSignature)
     pm.addNestedPass<func::FuncOp>(
         onnx_mlir::createInstrumentONNXSignaturePass());
-  pm.addPass(onnx_mlir::createLowerToKrnlPass(optLevel, enableParallel));
+  pm.addPass(onnx_mlir::createLowerToKrnlPass(optLevel,
+      /*enableSIMD=*/enableSimdElementwise,
+      /*enableFusion=*/enableFuseElementwise, enableParallel,
+      /*enableInPlace=*/enableInPlaceElementwise, l1CacheSize, l2CacheSize,
+      l3CacheSize));
   // An additional pass of canonicalization is helpful because lowering
   // from ONNX dialect to Standard dialect exposes additional canonicalization
   // opportunities.
@@ -152,6 +162,12 @@ void addKrnlToLLVMPasses(
   pm.addNestedPass<func::FuncOp>(mlir::createConvertVectorToSCFPass());
   pm.addPass(mlir::createLowerAffinePass());
 
+  // Run the parallel loops with the runtime thread pool. This must happen
+  // before hoisting allocations so that buffers local to a parallel iteration
+  // stay private to each thread.
+  if (enableParallel)
+    pm.addPass(krnl::createLowerParallelToRuntimePass());
+
   // After affine is lowered, KrnlRegion for affine scope can be removed.
   pm.addNestedPass<func::FuncOp>(krnl::createLowerKrnlRegionPass());
 
@@ -168,13 +184,19 @@ void addKrnlToLLVMPasses(
     pm.addNestedPass<func::FuncOp>(krnl::createKrnlEnableMemoryPoolPass());
     pm.addNestedPass<func::FuncOp>(krnl::createKrnlBundleMemoryPoolsPass());
     pm.addPass(mlir::createCanonicalizerPass());
-    pm.addNestedPass<func::FuncOp>(krnl::createKrnlOptimizeMemoryPoolsPass());
+    if (planStaticMemory)
+      pm.addNestedPass<func::FuncOp>(
+          krnl::createKrnlPlanStaticMemoryPass(reportMemoryPlan));
+    else
+      pm.addNestedPass<func::FuncOp>(
+          krnl::createKrnlOptimizeMemoryPoolsPass());
   }
 
   pm.addNestedPass<func::FuncOp>(krnl::createConvertSeqToMemrefPass());
   pm.addNestedPass<func::FuncOp>(mlir::createConvertSCFToCFPass());
 
-  pm.addPass(krnl::createConvertKrnlToLLVMPass(verifyInputTensors));
+  pm.addPass(krnl::createConvertKrnlToLLVMPass(verifyInputTensors,
+      useScratchArena, reuseMemoryPool, callerOutputBuffers));
   pm.addPass(mlir::createReconcileUnrealizedCastsPass());
   pm.addPass(mlir::createCanonicalizerPass());
 }
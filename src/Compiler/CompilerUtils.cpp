@@ -15,13 +15,20 @@
 #include "mlir/Support/FileUtilities.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Export.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/MC/SubtargetFeature.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Host.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/StringSaver.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Target/TargetMachine.h"
@@ -37,6 +44,7 @@
 #include "src/Version/Version.hpp"
 
 #include <charconv>
+#include <mutex>
 #include <regex>
 
 #define DEBUG_TYPE "compiler_utils"
@@ -373,32 +381,35 @@ std::string getTargetFilename(
   llvm_unreachable("all cases should be handled in switch");
 }
 
-// Write LLVM optimized bitcode.
-// Returns 0 on success, error code on failure.
-static int genLLVMBitcode(const mlir::OwningOpRef<ModuleOp> &module,
-    std::string outputNameNoExt, std::string optimizedBitcodeNameWithExt) {
-  std::error_code error;
+// Get the LLVM Target object corresponding to the target triple (if valid).
+static const llvm::Target *getLLVMTarget(
+    const std::string &targetTriple, const Location &loc) {
+  std::string error;
+  const llvm::Target *LLVMTarget =
+      llvm::TargetRegistry::lookupTarget(targetTriple, error);
+  if (!LLVMTarget) {
+    emitError(loc, Twine("Target architecture is unknown: ") + error);
+    return nullptr;
+  }
 
-  // Write bitcode to a file.
-  std::string unoptimizedBitcodeNameWithExt =
-      outputNameNoExt + ".unoptimized.bc";
-  llvm::FileRemover unoptimizedBitcodeRemover(
-      unoptimizedBitcodeNameWithExt, !keepFiles(KeepFilesOfType::Bitcode));
+  return LLVMTarget;
+}
 
-  // outputNameNoExt might contain a directory, which must exist.
-  // Otherwise, a "No such file or directory" error will be returned.
-  llvm::raw_fd_ostream moduleBitcodeStream(
-      unoptimizedBitcodeNameWithExt, error, llvm::sys::fs::OF_None);
-  if (error) {
-    llvm::errs() << unoptimizedBitcodeNameWithExt << ": " << error.message()
-                 << "\n";
-    return InvalidTemporaryFileAccess;
-  }
+static std::string getTargetTriple() {
+  return (mtriple != "") ? mtriple.getValue() : kDefaultTriple;
+}
+static std::string getTargetCpu() {
+  return (mcpu != "") ? mcpu.getValue() : "";
+}
 
-  llvm::LLVMContext llvmContext;
+// Translate the module to LLVM IR, tailored for onnx-mlir, and write it to a
+// .ll file when it is kept.
+// Returns 0 on success, error code on failure.
+static int translateToLLVMIR(const mlir::OwningOpRef<ModuleOp> &module,
+    std::string outputNameNoExt, llvm::LLVMContext &llvmContext,
+    std::unique_ptr<llvm::Module> &llvmModule) {
   mlir::registerLLVMDialectTranslation(*(module.get().getContext()));
-  std::unique_ptr<llvm::Module> llvmModule =
-      mlir::translateModuleToLLVMIR(*module, llvmContext);
+  llvmModule = mlir::translateModuleToLLVMIR(*module, llvmContext);
   if (!llvmModule) {
     llvm::errs() << "Failed to translate module to LLVMIR.\n";
     return CompilerFailureInMLIRToLLVM;
@@ -408,9 +419,12 @@ static int genLLVMBitcode(const mlir::OwningOpRef<ModuleOp> &module,
   tailorLLVMIR(*llvmModule);
 
   // Write LLVMIR to a file.
+  if (!keepFiles(KeepFilesOfType::LLVMIR))
+    return CompilerSuccess;
+  std::error_code error;
   std::string llvmirNameWithExt = outputNameNoExt + ".ll";
-  llvm::FileRemover llvmirRemover(
-      llvmirNameWithExt, !keepFiles(KeepFilesOfType::LLVMIR));
+  // outputNameNoExt might contain a directory, which must exist.
+  // Otherwise, a "No such file or directory" error will be returned.
   llvm::raw_fd_ostream moduleLLVMIRStream(
       llvmirNameWithExt, error, llvm::sys::fs::OF_None);
   if (error) {
@@ -419,15 +433,49 @@ static int genLLVMBitcode(const mlir::OwningOpRef<ModuleOp> &module,
   }
   llvmModule->print(moduleLLVMIRStream, nullptr);
   moduleLLVMIRStream.flush();
+  return CompilerSuccess;
+}
 
-  // Write unoptimized bitcode to a file.
-  llvm::WriteBitcodeToFile(*llvmModule, moduleBitcodeStream);
+// Write LLVM bitcode to a file.
+// Returns 0 on success, error code on failure.
+static int writeBitcode(
+    const llvm::Module &llvmModule, std::string bitcodeNameWithExt) {
+  std::error_code error;
+  llvm::raw_fd_ostream moduleBitcodeStream(
+      bitcodeNameWithExt, error, llvm::sys::fs::OF_None);
+  if (error) {
+    llvm::errs() << bitcodeNameWithExt << ": " << error.message() << "\n";
+    return InvalidTemporaryFileAccess;
+  }
+  llvm::WriteBitcodeToFile(llvmModule, moduleBitcodeStream);
   moduleBitcodeStream.flush();
+  return CompilerSuccess;
+}
+
+// Write LLVM optimized bitcode, using LLVM's 'opt' tool.
+// Returns 0 on success, error code on failure.
+static int genLLVMBitcode(const mlir::OwningOpRef<ModuleOp> &module,
+    std::string outputNameNoExt, std::string optimizedBitcodeNameWithExt) {
+  llvm::LLVMContext llvmContext;
+  std::unique_ptr<llvm::Module> llvmModule;
+  int rc =
+      translateToLLVMIR(module, outputNameNoExt, llvmContext, llvmModule);
+  if (rc != CompilerSuccess)
+    return rc;
+
+  // Write unoptimized bitcode to a file.
+  std::string unoptimizedBitcodeNameWithExt =
+      outputNameNoExt + ".unoptimized.bc";
+  llvm::FileRemover unoptimizedBitcodeRemover(
+      unoptimizedBitcodeNameWithExt, !keepFiles(KeepFilesOfType::Bitcode));
+  rc = writeBitcode(*llvmModule, unoptimizedBitcodeNameWithExt);
+  if (rc != CompilerSuccess)
+    return rc;
 
   // Use the LLVM's 'opt' command to optimize the bitcode.
   std::string optPath = getToolPath("opt", kOptPath);
   Command optBitcode(/*exePath=*/optPath);
-  int rc = optBitcode.appendStr(getOptimizationLevelOption())
+  rc = optBitcode.appendStr(getOptimizationLevelOption())
                .appendStr(getTargetTripleOption())
                .appendStr(getTargetArchOption())
                .appendStr(getTargetCPUOption())
@@ -439,7 +487,7 @@ static int genLLVMBitcode(const mlir::OwningOpRef<ModuleOp> &module,
   return rc != 0 ? CompilerFailureInLLVMOpt : CompilerSuccess;
 }
 
-// Compile LLVM bitcode to object file.
+// Compile LLVM bitcode to object file, using LLVM's 'llc' tool.
 // Return 0 on success, error code on failure.
 static int genModelObject(
     std::string bitcodeNameWithExt, std::string &modelObjNameWithExt) {
@@ -460,6 +508,220 @@ static int genModelObject(
   return rc != 0 ? CompilerFailureInLLVMToObj : CompilerSuccess;
 }
 
+// Split the -mllvm options between the code generation options handled by
+// 'llc' itself, which set the features and options of the target machine, and
+// the options of the LLVM libraries linked in onnx-mlir. The latter are global
+// to the process, so they are only parsed once: later compilations must use
+// the same options.
+// Return 0 on success, error code on failure.
+static int parseLLVMOption(
+    SmallVectorImpl<std::string> &attrs, llvm::TargetOptions &options) {
+  static std::mutex parsedMutex;
+  static llvm::Optional<std::string> parsedFlags;
+
+  llvm::BumpPtrAllocator allocator;
+  llvm::StringSaver saver(allocator);
+  SmallVector<const char *, 8> tokens;
+  llvm::cl::TokenizeGNUCommandLine(getLLVMOption(), saver, tokens);
+  SmallVector<const char *, 8> argv = {"onnx-mlir"};
+  std::string flags;
+  for (const char *token : tokens) {
+    StringRef flag = StringRef(token).ltrim('-');
+    if (flag.consume_front("mattr=")) {
+      SmallVector<StringRef, 4> features;
+      flag.split(features, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+      for (StringRef feature : features)
+        attrs.emplace_back(feature.str());
+    } else if (flag == "enable-unsafe-fp-math") {
+      options.UnsafeFPMath = true;
+    } else if (flag == "enable-no-infs-fp-math") {
+      options.NoInfsFPMath = true;
+    } else if (flag == "enable-no-nans-fp-math") {
+      options.NoNaNsFPMath = true;
+    } else if (flag == "enable-no-signed-zeros-fp-math") {
+      options.NoSignedZerosFPMath = true;
+    } else if (flag.consume_front("fp-contract=")) {
+      if (flag == "fast")
+        options.AllowFPOpFusion = llvm::FPOpFusion::Fast;
+      else if (flag == "on")
+        options.AllowFPOpFusion = llvm::FPOpFusion::Standard;
+      else if (flag == "off")
+        options.AllowFPOpFusion = llvm::FPOpFusion::Strict;
+      else {
+        llvm::errs() << "Unknown -fp-contract value: " << flag << "\n";
+        return InvalidCompilerOption;
+      }
+    } else if (flag.consume_front("float-abi=")) {
+      if (flag == "default")
+        options.FloatABIType = llvm::FloatABI::Default;
+      else if (flag == "soft")
+        options.FloatABIType = llvm::FloatABI::Soft;
+      else if (flag == "hard")
+        options.FloatABIType = llvm::FloatABI::Hard;
+      else {
+        llvm::errs() << "Unknown -float-abi value: " << flag << "\n";
+        return InvalidCompilerOption;
+      }
+    } else {
+      argv.push_back(token);
+      flags += (flags.empty() ? "" : " ") + std::string(token);
+    }
+  }
+
+  if (flags.empty())
+    return CompilerSuccess;
+  std::lock_guard<std::mutex> lock(parsedMutex);
+  if (parsedFlags.has_value()) {
+    if (*parsedFlags == flags)
+      return CompilerSuccess;
+    llvm::errs() << "The -mllvm options \"" << flags
+                 << "\" differ from the options \"" << *parsedFlags
+                 << "\" of a previous compilation in this process.\n";
+    return InvalidCompilerOption;
+  }
+  parsedFlags = flags;
+  if (!llvm::cl::ParseCommandLineOptions(
+          argv.size(), argv.data(), "", &llvm::errs()))
+    return InvalidCompilerOption;
+  return CompilerSuccess;
+}
+
+// Create the target machine for the target triple, arch, cpu, and -mattr
+// options, generating position independent code as
+// 'llc -relocation-model=pic'. As in 'llc', '-mcpu=native' selects the host
+// cpu and its features, and constructors are emitted in .init_array.
+static std::unique_ptr<llvm::TargetMachine> createTargetMachine(
+    ArrayRef<std::string> attrs, llvm::TargetOptions options) {
+  llvm::Triple triple(getTargetTriple());
+  std::string error;
+  const llvm::Target *LLVMTarget =
+      llvm::TargetRegistry::lookupTarget(march, triple, error);
+  if (!LLVMTarget) {
+    llvm::errs() << "Target architecture is unknown: " << error << "\n";
+    return nullptr;
+  }
+  std::string cpu = getTargetCpu();
+  llvm::SubtargetFeatures features;
+  if (cpu == "native") {
+    cpu = llvm::sys::getHostCPUName().str();
+    llvm::StringMap<bool> hostFeatures;
+    if (llvm::sys::getHostCPUFeatures(hostFeatures))
+      for (const auto &hostFeature : hostFeatures)
+        features.AddFeature(hostFeature.first(), hostFeature.second);
+  }
+  for (const std::string &attr : attrs)
+    features.AddFeature(attr);
+  options.UseInitArray = true;
+
+  llvm::CodeGenOpt::Level codeGenLevel = llvm::CodeGenOpt::None;
+  switch (OptimizationLevel) {
+  case OptLevel::O0:
+    codeGenLevel = llvm::CodeGenOpt::None;
+    break;
+  case OptLevel::O1:
+    codeGenLevel = llvm::CodeGenOpt::Less;
+    break;
+  case OptLevel::O2:
+    codeGenLevel = llvm::CodeGenOpt::Default;
+    break;
+  case OptLevel::O3:
+    codeGenLevel = llvm::CodeGenOpt::Aggressive;
+    break;
+  }
+  return std::unique_ptr<llvm::TargetMachine>(
+      LLVMTarget->createTargetMachine(triple.getTriple(), cpu,
+          features.getString(), options, llvm::Reloc::PIC_, llvm::None,
+          codeGenLevel));
+}
+
+// Optimize the LLVM module with the default pipeline of the new pass manager
+// for the optimization level, as 'opt -O<n>'.
+static void optimizeLLVMModule(
+    llvm::Module &llvmModule, llvm::TargetMachine &targetMachine) {
+  llvm::LoopAnalysisManager loopAM;
+  llvm::FunctionAnalysisManager functionAM;
+  llvm::CGSCCAnalysisManager cgsccAM;
+  llvm::ModuleAnalysisManager moduleAM;
+  llvm::PassBuilder passBuilder(&targetMachine);
+  passBuilder.registerModuleAnalyses(moduleAM);
+  passBuilder.registerCGSCCAnalyses(cgsccAM);
+  passBuilder.registerFunctionAnalyses(functionAM);
+  passBuilder.registerLoopAnalyses(loopAM);
+  passBuilder.crossRegisterProxies(loopAM, functionAM, cgsccAM, moduleAM);
+
+  llvm::ModulePassManager modulePM;
+  switch (OptimizationLevel) {
+  case OptLevel::O0:
+    modulePM = passBuilder.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+    break;
+  case OptLevel::O1:
+    modulePM =
+        passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O1);
+    break;
+  case OptLevel::O2:
+    modulePM =
+        passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    break;
+  case OptLevel::O3:
+    modulePM =
+        passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+    break;
+  }
+  modulePM.run(llvmModule, moduleAM);
+}
+
+// Optimize the module and compile it to an object file within onnx-mlir,
+// without writing the LLVM IR to disk for the 'opt' and 'llc' tools.
+// Bitcode files are only written when they are kept.
+// Return 0 on success, error code on failure.
+static int genModelObjectInProcess(const mlir::OwningOpRef<ModuleOp> &module,
+    std::string outputNameNoExt, std::string modelObjNameWithExt) {
+  SmallVector<std::string, 4> attrs;
+  llvm::TargetOptions options;
+  int rc = parseLLVMOption(attrs, options);
+  if (rc != CompilerSuccess)
+    return rc;
+  std::unique_ptr<llvm::TargetMachine> targetMachine =
+      createTargetMachine(attrs, options);
+  if (!targetMachine)
+    return CompilerFailureInLLVMOpt;
+
+  llvm::LLVMContext llvmContext;
+  std::unique_ptr<llvm::Module> llvmModule;
+  rc = translateToLLVMIR(module, outputNameNoExt, llvmContext, llvmModule);
+  if (rc != CompilerSuccess)
+    return rc;
+  if (keepFiles(KeepFilesOfType::Bitcode)) {
+    rc = writeBitcode(*llvmModule, outputNameNoExt + ".unoptimized.bc");
+    if (rc != CompilerSuccess)
+      return rc;
+  }
+
+  optimizeLLVMModule(*llvmModule, *targetMachine);
+  if (keepFiles(KeepFilesOfType::Bitcode)) {
+    rc = writeBitcode(*llvmModule, outputNameNoExt + ".bc");
+    if (rc != CompilerSuccess)
+      return rc;
+  }
+
+  std::error_code error;
+  llvm::ToolOutputFile modelObjFile(
+      modelObjNameWithExt, error, llvm::sys::fs::OF_None);
+  if (error) {
+    llvm::errs() << modelObjNameWithExt << ": " << error.message() << "\n";
+    return InvalidOutputFileAccess;
+  }
+  llvm::legacy::PassManager codeGenPM;
+  if (targetMachine->addPassesToEmitFile(codeGenPM, modelObjFile.os(),
+          /*DwoOut=*/nullptr, llvm::CGFT_ObjectFile)) {
+    llvm::errs() << "Target does not support object file emission.\n";
+    return CompilerFailureInLLVMToObj;
+  }
+  codeGenPM.run(*llvmModule);
+  modelObjFile.keep();
+  return CompilerSuccess;
+}
+
 // Return 0 on success, error code on failure.
 static int genJniObject(const mlir::OwningOpRef<ModuleOp> &module,
     std::string jniSharedLibPath, std::string jniObjPath) {
@@ -536,6 +798,14 @@ static int genJniJar(const mlir::OwningOpRef<ModuleOp> &module,
 // Return 0 on success, error code on failure
 static int compileModuleToObject(const mlir::OwningOpRef<ModuleOp> &module,
     std::string outputNameWithoutExt, std::string &objectNameWithExt) {
+  // Options for the 'opt' and 'llc' tools may not be known to the LLVM
+  // libraries linked in onnx-mlir, so these tools are only used when such
+  // options are given.
+  if (getXoptOption().empty() && getXllcOption().empty()) {
+    objectNameWithExt = getTargetFilename(outputNameWithoutExt, EmitObj);
+    return genModelObjectInProcess(
+        module, outputNameWithoutExt, objectNameWithExt);
+  }
   std::string bitcodeNameWithExt = outputNameWithoutExt + ".bc";
   int rc = genLLVMBitcode(module, outputNameWithoutExt, bitcodeNameWithExt);
   if (rc != CompilerSuccess)
@@ -740,6 +1010,14 @@ static int emitOutputFiles(std::string outputNameNoExt,
   } break;
   case EmitLib: {
     addCompilerConfig(CCM_SHARED_LIB_DEPS, {"cruntime"});
+#ifndef _WIN32
+    // The runtime thread pool running parallel loops relies on pthreads.
+    if (enableParallel)
+      addCompilerConfig(CCM_SHARED_LIB_DEPS, {"pthread"});
+    // The runtime locates the constants file next to the model library.
+    if (storeConstantsToFile)
+      addCompilerConfig(CCM_SHARED_LIB_DEPS, {"dl", "pthread"});
+#endif
     std::string sharedLibNameWithExt;
     int rc = compileModuleToSharedLibrary(
         module, outputNameNoExt, sharedLibNameWithExt);
@@ -756,6 +1034,14 @@ static int emitOutputFiles(std::string outputNameNoExt,
   } break;
   case EmitJNI: {
     addCompilerConfig(CCM_SHARED_LIB_DEPS, {"jniruntime", "cruntime"});
+#ifndef _WIN32
+    // The runtime thread pool running parallel loops relies on pthreads.
+    if (enableParallel)
+      addCompilerConfig(CCM_SHARED_LIB_DEPS, {"pthread"});
+    // The runtime locates the constants file next to the model library.
+    if (storeConstantsToFile)
+      addCompilerConfig(CCM_SHARED_LIB_DEPS, {"dl", "pthread"});
+#endif
     int rc = compileModuleToJniJar(module, outputNameNoExt);
     if (rc != CompilerSuccess)
       return rc;
@@ -797,27 +1083,6 @@ static int emitOutputFiles(std::string outputNameNoExt,
   return CompilerSuccess;
 } // end anonymous namespace
 
-// Get the LLVM Target object corresponding to the target triple (if valid).
-static const llvm::Target *getLLVMTarget(
-    const std::string &targetTriple, const Location &loc) {
-  std::string error;
-  const llvm::Target *LLVMTarget =
-      llvm::TargetRegistry::lookupTarget(targetTriple, error);
-  if (!LLVMTarget) {
-    emitError(loc, Twine("Target architecture is unknown: ") + error);
-    return nullptr;
-  }
-
-  return LLVMTarget;
-}
-
-static std::string getTargetTriple() {
-  return (mtriple != "") ? mtriple.getValue() : kDefaultTriple;
-}
-static std::string getTargetCpu() {
-  return (mcpu != "") ? mcpu.getValue() : "";
-}
-
 /// Return the module datalayout string. The datalayout string is determined
 /// by creating a target machine using the target triple and target cpu.
 static std::string getDataLayout(const Location &loc) {
@@ -868,6 +1133,11 @@ static int setupModule(mlir::OwningOpRef<ModuleOp> &module,
   if (!accelsAttr.empty())
     moduleOp.setAttr("onnx-mlir.accels", ArrayAttr::get(&context, accelsAttr));
 
+  // Request the data of large constants to be stored next to the output.
+  if (storeConstantsToFile)
+    moduleOp.setAttr("onnx-mlir.constants-file",
+        StringAttr::get(&context, outputNameNoExt + ".constants.bin"));
+
   if (keepFiles(KeepFilesOfType::MLIR)) {
     std::string mlirNameWithExt = outputNameNoExt + ".input.mlir";
     int rc = outputCode(module, mlirNameWithExt);
@@ -15,6 +15,7 @@
 #include "mlir/Analysis/DataLayoutAnalysis.h"
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Affine/LoopUtils.h"
+#include "mlir/Dialect/Affine/Utils.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/BuiltinTypes.h"
@@ -437,15 +438,16 @@ static void removeOps(llvm::SmallPtrSetImpl<Operation *> &opsToErase) {
 
 static LogicalResult interpretOperation(Operation *op, OpBuilder &builder,
     llvm::SmallDenseMap<Value, AffineForOp, 4> &loopRefToOp,
-    llvm::SmallPtrSetImpl<Operation *> &opsToErase, LoopBodyMover &mover) {
+    llvm::SmallPtrSetImpl<Operation *> &opsToErase, LoopBodyMover &mover,
+    SmallVectorImpl<AffineForOp> &loopsToParallelize) {
   // Recursively interpret nested operations.
   for (auto &region : op->getRegions())
     for (auto &block : region.getBlocks()) {
       auto &blockOps = block.getOperations();
       for (auto itr = blockOps.begin(); itr != blockOps.end();) {
         LLVM_DEBUG(llvm::dbgs() << DEBUG_TYPE << " Call interpretOperation \n");
-        if (failed(interpretOperation(
-                &(*itr), builder, loopRefToOp, opsToErase, mover)))
+        if (failed(interpretOperation(&(*itr), builder, loopRefToOp,
+                opsToErase, mover, loopsToParallelize)))
           return failure();
         else
           ++itr;
@@ -562,6 +564,16 @@ static LogicalResult interpretOperation(Operation *op, OpBuilder &builder,
     assert(succeeded(res) && "failed to unroll");
     opsToErase.insert(op);
     return success();
+  } else if (auto parallelOp = dyn_cast_or_null<KrnlParallelOp>(op)) {
+    LLVM_DEBUG(llvm::dbgs()
+               << DEBUG_TYPE << " interpret parallel op " << parallelOp << "\n");
+    // Record the affine for loops to parallelize. They are converted to
+    // affine.parallel loops once all other loop transformations are done, as
+    // blocking, permutation and body movement all operate on affine for loops.
+    for (Value loopRef : parallelOp.loops())
+      loopsToParallelize.emplace_back(loopRefToOp[loopRef]);
+    opsToErase.insert(op);
+    return success();
   }
 
   return success();
@@ -645,8 +657,9 @@ void ConvertKrnlToAffinePass::runOnOperation() {
   // only erase after iteration completes.
   llvm::SmallDenseMap<Value, AffineForOp, 4> loopRefToOp;
   llvm::SmallPtrSet<Operation *, 4> opsToErase;
-  if (failed(interpretOperation(
-          funcOp, builder, loopRefToOp, opsToErase, mover))) {
+  SmallVector<AffineForOp, 4> loopsToParallelize;
+  if (failed(interpretOperation(funcOp, builder, loopRefToOp, opsToErase,
+          mover, loopsToParallelize))) {
     signalPassFailure();
     return;
   }
@@ -725,6 +738,15 @@ void ConvertKrnlToAffinePass::runOnOperation() {
   }
 
   delete currUnrollAndJamList;
+
+  // Convert the loops marked by krnl.parallel into affine.parallel loops.
+  for (AffineForOp loop : loopsToParallelize) {
+    if (failed(affineParallelize(loop))) {
+      loop.emitError("failed to parallelize loop");
+      signalPassFailure();
+      return;
+    }
+  }
 }
 
 std::unique_ptr<Pass> createConvertKrnlToAffinePass() {
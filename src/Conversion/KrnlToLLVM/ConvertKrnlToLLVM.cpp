@@ -365,6 +365,13 @@ struct ConvertKrnlToLLVMPass
   ConvertKrnlToLLVMPass(bool verifyInputTensors) {
     this->verifyInputTensors = verifyInputTensors;
   }
+  ConvertKrnlToLLVMPass(bool verifyInputTensors, bool useScratchArena,
+      bool reuseMemoryPool, bool useOutputBuffers) {
+    this->verifyInputTensors = verifyInputTensors;
+    this->useScratchArena = useScratchArena;
+    this->reuseMemoryPool = reuseMemoryPool;
+    this->useOutputBuffers = useOutputBuffers;
+  }
 
   StringRef getArgument() const override { return "convert-krnl-to-llvm"; }
 
@@ -380,6 +387,22 @@ struct ConvertKrnlToLLVMPass
           "Data type and shape are verified. Enable this may introduce "
           "overhead in inferencing."),
       llvm::cl::init(false)};
+
+  Option<bool> useScratchArena{*this, "use-scratch-arena",
+      llvm::cl::desc("Allocate the buffers that the model deallocates from "
+                     "per-thread scratch arenas reused across inferences."),
+      llvm::cl::init(false)};
+
+  Option<bool> reuseMemoryPool{*this, "reuse-memory-pool",
+      llvm::cl::desc("Keep the static memory pools of the functions allocated "
+                     "across inferences, or use a buffer supplied by the "
+                     "caller through omMemoryPoolSetBuffer."),
+      llvm::cl::init(false)};
+
+  Option<bool> useOutputBuffers{*this, "use-output-buffers",
+      llvm::cl::desc("Emit entry points taking output tensors supplied by the "
+                     "caller, whose buffers receive the outputs of the model."),
+      llvm::cl::init(false)};
 };
 
 void ConvertKrnlToLLVMPass::runOnOperation() {
@@ -403,6 +426,23 @@ void ConvertKrnlToLLVMPass::runOnOperation() {
         UnitAttr::get(&getContext()));
   }
 
+  // Store the data of large constants to the file requested by the driver, if
+  // any.
+  if (auto constantsFile =
+          module->getAttrOfType<StringAttr>("onnx-mlir.constants-file")) {
+    if (failed(krnl::storeConstantsToFile(module, constantsFile.getValue())))
+      return signalPassFailure();
+  }
+
+  // Memory pools are marked first so that they are not lowered to the scratch
+  // arenas.
+  if (reuseMemoryPool)
+    krnl::markReusedMemoryPools(module);
+  if (useScratchArena)
+    krnl::markScratchAllocations(module);
+  if (useOutputBuffers)
+    krnl::markOutputAllocations(module);
+
   // Determine whether an output OMTensor should own the underlying buffer or
   // not.
   SmallVector<bool, 4> outputOMTensorOwnerships;
@@ -454,6 +494,11 @@ std::unique_ptr<Pass> createConvertKrnlToLLVMPass() {
 std::unique_ptr<Pass> createConvertKrnlToLLVMPass(bool verifyInputTensors) {
   return std::make_unique<ConvertKrnlToLLVMPass>(verifyInputTensors);
 }
+std::unique_ptr<Pass> createConvertKrnlToLLVMPass(bool verifyInputTensors,
+    bool useScratchArena, bool reuseMemoryPool, bool useOutputBuffers) {
+  return std::make_unique<ConvertKrnlToLLVMPass>(
+      verifyInputTensors, useScratchArena, reuseMemoryPool, useOutputBuffers);
+}
 
 void populateKrnlToLLVMConversion(LLVMTypeConverter &typeConverter,
     RewritePatternSet &patterns, MLIRContext *ctx,
@@ -467,6 +512,7 @@ void populateKrnlToLLVMConversion(LLVMTypeConverter &typeConverter,
   krnl::populateLoweringKrnlCallOpPattern(typeConverter, patterns, ctx);
   krnl::populateLoweringKrnlFindIndexOpPattern(typeConverter, patterns, ctx);
   krnl::populateLoweringKrnlGlobalOpPattern(typeConverter, patterns, ctx);
+  krnl::populateLoweringRuntimeAllocPattern(typeConverter, patterns, ctx);
   krnl::populateLoweringKrnlGetRefOpPattern(typeConverter, patterns, ctx);
   krnl::populateLoweringKrnlInstrumentOpPattern(typeConverter, patterns, ctx);
   krnl::populateLoweringKrnlMemcpyOpPattern(typeConverter, patterns, ctx);
@@ -21,6 +21,12 @@
 
 const std::string DEFAULT_DYN_ENTRY_POINT = "run_main_graph";
 
+// Attribute of the entry points that also get a variant taking the output
+// tensors supplied by the caller, named after the entry point with the
+// OUTPUT_BUFFERS_ENTRY_POINT_SUFFIX suffix.
+const std::string OUTPUT_BUFFERS_ATTR = "krnl.output_buffers";
+const std::string OUTPUT_BUFFERS_ENTRY_POINT_SUFFIX = "_with_outputs";
+
 namespace onnx_mlir {
 namespace krnl {
 
@@ -83,6 +89,10 @@ void populateLoweringKrnlStrlenOpPattern(mlir::TypeConverter &typeConverter,
 void populateLoweringKrnlStrncmpOpPattern(mlir::TypeConverter &typeConverter,
     mlir::RewritePatternSet &patterns, mlir::MLIRContext *ctx);
 
+void populateLoweringRuntimeAllocPattern(
+    mlir::LLVMTypeConverter &typeConverter, mlir::RewritePatternSet &patterns,
+    mlir::MLIRContext *ctx);
+
 void populateLoweringKrnlUnaryMathOpPattern(mlir::TypeConverter &typeConverter,
     mlir::RewritePatternSet &patterns, mlir::MLIRContext *ctx);
 
@@ -90,6 +100,24 @@ void populateLoweringKrnlVectorTypeCastOpPattern(
     mlir::LLVMTypeConverter &typeConverter, mlir::RewritePatternSet &patterns,
     mlir::MLIRContext *ctx);
 
+/// Mark the allocations of the buffers deallocated by the model to be lowered
+/// to the per-thread scratch arenas of the runtime.
+void markScratchAllocations(mlir::ModuleOp &module);
+
+/// Mark the static memory pools of the functions to be lowered to the memory
+/// pools of the runtime, which are kept allocated across inferences.
+void markReusedMemoryPools(mlir::ModuleOp &module);
+
+/// Mark the allocations of the outputs of the entry points to be lowered to
+/// the output buffers supplied by the caller, and the entry points to get a
+/// variant taking these buffers.
+void markOutputAllocations(mlir::ModuleOp &module);
+
+/// Store the data of the large constants of the module to the given file, and
+/// mark their KrnlGlobalOps to be lowered to reads from the mapped file.
+mlir::LogicalResult storeConstantsToFile(
+    mlir::ModuleOp &module, llvm::StringRef filePath);
+
 void determineOwnershipForOutputOMTensors(mlir::ModuleOp &module,
     llvm::SmallVectorImpl<bool> &outputOMTensorOwnerships);
 
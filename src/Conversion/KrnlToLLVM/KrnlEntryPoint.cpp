@@ -4,7 +4,7 @@
 
 //===------ KrnlEntryPoint.cpp - Lower KrnlEntryPointOp -------------------===//
 //
-// Copyright 2019-2022 The IBM Research Authors.
+// Copyright 2019-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
@@ -101,11 +101,14 @@ public:
         inSigGlobalOps, outSigGlobalOps);
 
     // Start lowering the op.
+    bool withOutputBuffers = op->hasAttr(OUTPUT_BUFFERS_ATTR);
     rewriter.eraseOp(op);
     auto dynEntryPointFuncTy =
         LLVM::LLVMFunctionType::get(opaquePtrTy, {opaquePtrTy}, false);
     LLVM::LLVMFuncOp dynamicEntryPointFunc =
         create.llvm.func(dynEntryPointName, dynEntryPointFuncTy);
+    if (withOutputBuffers)
+      emitEntryPointWithOutputBuffers(rewriter, loc, module, dynEntryPointName);
     auto &entryPointEntryBlock =
         createEntryBlock(dynEntryPointFuncTy, dynamicEntryPointFunc, loc);
     rewriter.setInsertionPointToStart(&entryPointEntryBlock);
@@ -302,6 +305,34 @@ private:
     return *entryPointEntryBlock;
   }
 
+  // Emit the variant of the dynamic entry point that takes the output tensors
+  // supplied by the caller as second argument. It runs the dynamic entry point
+  // between calls to omOutputBuffersBegin and omOutputBuffersEnd, so that the
+  // outputs allocated by omOutputAlloc use the supplied buffers.
+  void emitEntryPointWithOutputBuffers(PatternRewriter &rewriter, Location loc,
+      ModuleOp module, StringRef dynEntryPointName) const {
+    OpBuilder::InsertionGuard guard(rewriter);
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
+    MLIRContext *context = module.getContext();
+    Type opaquePtrTy = LLVM::LLVMPointerType::get(IntegerType::get(context, 8));
+    Type funcTy = LLVM::LLVMFunctionType::get(
+        opaquePtrTy, {opaquePtrTy, opaquePtrTy}, false);
+    LLVM::LLVMFuncOp funcOp = create.llvm.func(
+        dynEntryPointName.str() + OUTPUT_BUFFERS_ENTRY_POINT_SUFFIX, funcTy);
+    Block &entryBlock = createEntryBlock(funcTy, funcOp, loc);
+    rewriter.setInsertionPointToStart(&entryBlock);
+
+    FlatSymbolRefAttr beginRef = create.llvm.getOrInsertSymbolRef(module,
+        "omOutputBuffersBegin", LLVM::LLVMVoidType::get(context),
+        {opaquePtrTy});
+    FlatSymbolRefAttr endRef = create.llvm.getOrInsertSymbolRef(
+        module, "omOutputBuffersEnd", opaquePtrTy, {opaquePtrTy});
+    create.llvm.call({}, beginRef, {entryBlock.getArgument(1)});
+    Value results = create.llvm.call(
+        opaquePtrTy, dynEntryPointName, {entryBlock.getArgument(0)});
+    create.llvm._return(create.llvm.call(opaquePtrTy, endRef, {results}));
+  }
+
   void fillPtrToMemRefWithOMTensor(Value &rtMemRef, Value &ptrToMemRef,
       PatternRewriter &rewriter, const Location &loc,
       const RuntimeAPIRegistry &apiRegistry, ModuleOp &module) const {
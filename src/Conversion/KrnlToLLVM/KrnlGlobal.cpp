@@ -10,6 +10,10 @@
 //
 // This file lowers the KrnlGlobalOp operator.
 //
+// With the store-constants-to-file option, the data of large constants is
+// stored once per distinct content in a separate file, and the generated code
+// maps that file into memory at the first use of one of these constants.
+//
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Conversion/LLVMCommon/Pattern.h"
@@ -17,11 +21,19 @@
 #include "mlir/IR/DialectResourceBlobManager.h"
 #include "llvm/ADT/TypeSwitch.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
+#include "src/Conversion/KrnlToLLVM/ConvertKrnlToLLVM.hpp"
 #include "src/Conversion/KrnlToLLVM/KrnlToLLVMHelper.hpp"
 #include "src/Dialect/Mlir/DialectBuilder.hpp"
 #include "src/Support/KrnlSupport.hpp"
 
+#include <unordered_map>
+
 #define DEBUG_TYPE "krnl_to_llvm"
 
 using namespace mlir;
@@ -29,6 +41,123 @@ using namespace mlir;
 namespace onnx_mlir {
 namespace krnl {
 
+// Attribute giving the offset in the constants file of the data of a
+// KrnlGlobalOp.
+static constexpr llvm::StringLiteral CONSTANT_OFFSET_ATTR =
+    "krnl.constant_file_offset";
+// Module attributes giving the name and the size of the constants file.
+static constexpr llvm::StringLiteral CONSTANTS_FILE_NAME_ATTR =
+    "onnx-mlir.constants-file-name";
+static constexpr llvm::StringLiteral CONSTANTS_FILE_SIZE_ATTR =
+    "onnx-mlir.constants-file-size";
+// Module attribute giving the hash of the content of the constants file, which
+// identifies the file when it is shared among processes.
+static constexpr llvm::StringLiteral CONSTANTS_FILE_HASH_ATTR =
+    "onnx-mlir.constants-file-hash";
+// Name of the global caching the address of the mapped constants file.
+static constexpr llvm::StringLiteral CONSTANTS_ADDR_GLOBAL =
+    "om_constants_file_addr";
+// Minimum alignment of the data in the constants file, a cache line.
+static constexpr uint64_t CONSTANT_MIN_ALIGNMENT = 64;
+
+static int64_t computeSizeInBytes(KrnlGlobalOp &krnlGlobalOp) {
+  // Compute total number of elements.
+  const auto shape = (krnlGlobalOp.shape()).dyn_cast<ArrayAttr>();
+  int64_t numElements = 1;
+  for (unsigned int i = 0; i < shape.size(); ++i)
+    numElements *= shape[i].cast<IntegerAttr>().getInt();
+
+  const auto type = krnlGlobalOp.getResult().getType();
+  const auto memRefTy = type.cast<mlir::MemRefType>();
+
+  return numElements * getMemRefEltSizeInBytes(memRefTy);
+}
+
+// Return the data of a KrnlGlobalOp that is lowered to an array of bytes, or
+// None if its value is lowered otherwise (splat, small or string constants).
+static Optional<ArrayRef<char>> getByteArrayData(KrnlGlobalOp &krnlGlobalOp) {
+  if (!krnlGlobalOp.value().has_value())
+    return llvm::None;
+  Attribute value = krnlGlobalOp.value().value();
+  ArrayRef<char> rawData;
+  if (auto resourceAttr = value.dyn_cast<DenseResourceElementsAttr>()) {
+    AsmResourceBlob *blob = resourceAttr.getRawHandle().getBlob();
+    if (!blob)
+      return llvm::None;
+    rawData = blob->getData();
+  } else if (auto denseAttr = value.dyn_cast<DenseElementsAttr>()) {
+    if (denseAttr.isSplat() || computeSizeInBytes(krnlGlobalOp) <= 1024 ||
+        denseAttr.getElementType().isa<StringType>())
+      return llvm::None;
+    rawData = denseAttr.getRawData();
+  } else
+    return llvm::None;
+  if ((int64_t)rawData.size() != computeSizeInBytes(krnlGlobalOp))
+    return llvm::None;
+  return rawData;
+}
+
+LogicalResult storeConstantsToFile(ModuleOp &module, StringRef filePath) {
+  MLIRContext *context = module.getContext();
+  std::error_code ec;
+  llvm::raw_fd_ostream os(filePath, ec, llvm::sys::fs::OF_None);
+  if (ec)
+    return module.emitError("cannot open constants file '")
+           << filePath << "': " << ec.message();
+
+  // Offsets of the data already stored in the file, by hash of the data.
+  std::unordered_multimap<uint64_t, std::pair<ArrayRef<char>, uint64_t>>
+      storedData;
+  // Offset and hash of each data stored in the file, in file order.
+  SmallVector<uint64_t, 32> fileLayout;
+  uint64_t fileSize = 0;
+  module.walk([&](KrnlGlobalOp krnlGlobalOp) {
+    Optional<ArrayRef<char>> data = getByteArrayData(krnlGlobalOp);
+    if (!data)
+      return;
+    uint64_t alignment = std::max(
+        CONSTANT_MIN_ALIGNMENT, krnlGlobalOp.alignment().value_or(0));
+
+    // Reuse identical data stored with a compatible alignment.
+    uint64_t hash = llvm::xxHash64(StringRef(data->data(), data->size()));
+    Optional<uint64_t> offset;
+    auto range = storedData.equal_range(hash);
+    for (auto it = range.first; it != range.second && !offset; ++it)
+      if (it->second.first == *data && it->second.second % alignment == 0)
+        offset = it->second.second;
+
+    if (!offset) {
+      offset = llvm::alignTo(fileSize, alignment);
+      os.write_zeros(*offset - fileSize);
+      os.write(data->data(), data->size());
+      fileSize = *offset + data->size();
+      storedData.emplace(hash, std::make_pair(*data, *offset));
+      fileLayout.append({*offset, hash});
+    }
+    krnlGlobalOp->setAttr(CONSTANT_OFFSET_ATTR,
+        IntegerAttr::get(IntegerType::get(context, 64), *offset));
+  });
+
+  os.close();
+  if (os.has_error())
+    return module.emitError("cannot write constants file '")
+           << filePath << "': " << os.error().message();
+
+  // The generated code looks for the file by name and identifies its content
+  // by hash, see omGetExternalConstantAddr.
+  module->removeAttr("onnx-mlir.constants-file");
+  module->setAttr(CONSTANTS_FILE_NAME_ATTR,
+      StringAttr::get(context, llvm::sys::path::filename(filePath)));
+  module->setAttr(CONSTANTS_FILE_SIZE_ATTR,
+      IntegerAttr::get(IntegerType::get(context, 64), fileSize));
+  uint64_t fileHash = llvm::xxHash64(StringRef(
+      reinterpret_cast<const char *>(fileLayout.data()),
+      fileLayout.size() * sizeof(uint64_t)));
+  module->setAttr(CONSTANTS_FILE_HASH_ATTR,
+      IntegerAttr::get(IntegerType::get(context, 64), fileHash));
+  return success();
+}
+
 class KrnlGlobalOpLowering : public ConvertToLLVMPattern {
 public:
   explicit KrnlGlobalOpLowering(
@@ -49,6 +178,17 @@ public:
         typeConverter->convertType(memRefTy.getElementType());
     Type globalType = constantElementType;
 
+    // Constants stored in the constants file are read from the mapped file.
+    if (auto offsetAttr =
+            krnlGlobalOp->getAttrOfType<IntegerAttr>(CONSTANT_OFFSET_ATTR)) {
+      Value address =
+          lowerExternalConstant(krnlGlobalOp, offsetAttr.getInt(), rewriter);
+      MemRefDescriptor memRefDescr =
+          createMemRefDescriptor(address, memRefTy, loc, rewriter);
+      rewriter.replaceOp(op, {memRefDescr});
+      return success();
+    }
+
     // The llvm type of the global (example: [2 x [8 x float]]).
     const auto shape = (krnlGlobalOp.shape()).dyn_cast<ArrayAttr>();
     if (shape.empty())
@@ -180,17 +320,52 @@ private:
     return global;
   }
 
-  int64_t computeSizeInBytes(KrnlGlobalOp &krnlGlobalOp) const {
-    // Compute total number of elements.
-    const auto shape = (krnlGlobalOp.shape()).dyn_cast<ArrayAttr>();
-    int64_t numElements = 1;
-    for (unsigned int i = 0; i < shape.size(); ++i)
-      numElements *= ArrayAttrIntVal(shape, i);
+  // Return the address of the data of a constant stored in the constants
+  // file at the given offset. The file is mapped into memory by the runtime at
+  // the first call, and its address is cached in a global of the module.
+  Value lowerExternalConstant(KrnlGlobalOp &krnlGlobalOp, int64_t offset,
+      ConversionPatternRewriter &rewriter) const {
+    MLIRContext *context = krnlGlobalOp.getContext();
+    Location loc = krnlGlobalOp.getLoc();
+    ModuleOp module = krnlGlobalOp->getParentOfType<ModuleOp>();
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
 
-    const auto type = krnlGlobalOp.getResult().getType();
-    const auto memRefTy = type.cast<mlir::MemRefType>();
+    Type i8PtrTy = LLVM::LLVMPointerType::get(IntegerType::get(context, 8));
+    Type i8PtrPtrTy = LLVM::LLVMPointerType::get(i8PtrTy);
+    Type i64Ty = IntegerType::get(context, 64);
+
+    LLVM::GlobalOp addrGlobal =
+        module.lookupSymbol<LLVM::GlobalOp>(CONSTANTS_ADDR_GLOBAL);
+    if (!addrGlobal) {
+      OpBuilder::InsertionGuard insertGuard(rewriter);
+      rewriter.setInsertionPointToStart(module.getBody());
+      addrGlobal = create.llvm.globalOp(i8PtrTy,
+          /*isConstant=*/false, LLVM::Linkage::Internal, CONSTANTS_ADDR_GLOBAL,
+          Attribute());
+      Block *block = rewriter.createBlock(&addrGlobal.getInitializerRegion());
+      rewriter.setInsertionPoint(block, block->begin());
+      create.llvm._return(create.llvm.nullI8Ptr());
+    }
 
-    return numElements * getMemRefEltSizeInBytes(memRefTy);
+    StringRef fileName =
+        module->getAttrOfType<StringAttr>(CONSTANTS_FILE_NAME_ATTR).getValue();
+    int64_t fileSize =
+        module->getAttrOfType<IntegerAttr>(CONSTANTS_FILE_SIZE_ATTR).getInt();
+    int64_t fileHash =
+        module->getAttrOfType<IntegerAttr>(CONSTANTS_FILE_HASH_ATTR).getInt();
+    LLVM::GlobalOp fileNameGlobal = krnl::getOrCreateGlobalString(
+        fileName, loc, rewriter, module, getTypeConverter());
+
+    FlatSymbolRefAttr getAddrRef =
+        create.llvm.getOrInsertSymbolRef(module, "omGetExternalConstantAddr",
+            i8PtrTy, {i8PtrPtrTy, i8PtrTy, i64Ty, i64Ty, i64Ty});
+    Value addrPtr = create.llvm.addressOf(addrGlobal);
+    Value fileNamePtr =
+        krnl::getPtrToGlobalString(fileNameGlobal, loc, rewriter);
+    return create.llvm.call(i8PtrTy, getAddrRef,
+        {addrPtr, fileNamePtr, create.llvm.constant(i64Ty, fileSize),
+            create.llvm.constant(i64Ty, fileHash),
+            create.llvm.constant(i64Ty, offset)});
   }
 
   // Store the given address into a MemRefDescriptor (a struct).
@@ -0,0 +1,321 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-- RuntimeAlloc.cpp - Lower internal buffers to runtime allocators ---===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the allocations of the internal buffers of a model, i.e.
+// the buffers deallocated by the model itself, to calls to the allocators of
+// the runtime that keep buffers across inferences:
+// - the per-thread scratch arenas (omScratchAlloc and omScratchFree), which
+//   keep the buffers freed by a thread for its next allocations, so that
+//   threads running the model concurrently neither contend on the allocator
+//   nor allocate their buffers again at each inference;
+// - the memory pools (omMemoryPoolAcquire and omMemoryPoolRelease), which
+//   keep the memory pools bundled by the BundleMemoryPools pass allocated
+//   from one inference to the next, or use a buffer supplied by the caller;
+// - the output buffers supplied by the caller (omOutputAlloc), which receive
+//   the outputs of the model when they fit, so that the caller does not copy
+//   them. Other outputs are allocated with malloc, and freed by the caller.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Conversion/LLVMCommon/Pattern.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+
+#include "src/Conversion/KrnlToLLVM/ConvertKrnlToLLVM.hpp"
+#include "src/Conversion/KrnlToLLVM/KrnlToLLVMHelper.hpp"
+#include "src/Dialect/Mlir/DialectBuilder.hpp"
+#include "src/Support/KrnlSupport.hpp"
+
+#define DEBUG_TYPE "krnl_to_llvm"
+
+using namespace mlir;
+
+namespace onnx_mlir {
+namespace krnl {
+
+// Attributes marking the alloc and dealloc ops of internal buffers.
+static constexpr llvm::StringLiteral SCRATCH_ATTR = "krnl.scratch";
+static constexpr llvm::StringLiteral MEMORY_POOL_ATTR = "krnl.memory_pool";
+// Attribute giving the index of the output allocated by an alloc op.
+static constexpr llvm::StringLiteral OUTPUT_ATTR = "krnl.output";
+
+// Return whether the buffer allocated by allocOp is deallocated by the model.
+static bool isDeallocated(memref::AllocOp allocOp) {
+  return llvm::any_of(allocOp->getUsers(),
+      [](Operation *user) { return isa<memref::DeallocOp>(user); });
+}
+
+// Mark allocOp and its dealloc ops with the given attribute.
+static void markAllocation(memref::AllocOp allocOp, StringRef attrName) {
+  UnitAttr unitAttr = UnitAttr::get(allocOp.getContext());
+  allocOp->setAttr(attrName, unitAttr);
+  for (Operation *user : allocOp->getUsers())
+    if (isa<memref::DeallocOp>(user))
+      user->setAttr(attrName, unitAttr);
+}
+
+void markScratchAllocations(ModuleOp &module) {
+  module.walk([&](memref::AllocOp allocOp) {
+    // Buffers that are not deallocated by the model are outputs. Memory pools
+    // reused across inferences are left to the memory pool allocator.
+    if (!isDeallocated(allocOp) || allocOp->hasAttr(MEMORY_POOL_ATTR))
+      return;
+    markAllocation(allocOp, SCRATCH_ATTR);
+  });
+}
+
+void markReusedMemoryPools(ModuleOp &module) {
+  module.walk([&](memref::AllocOp allocOp) {
+    // Only the static memory pools allocated once per call, i.e. in the body
+    // of the function, are reused. Memory pools are 1-D byte buffers used by
+    // krnl.getref ops.
+    MemRefType memRefType = allocOp.getType();
+    if (!isa<func::FuncOp>(allocOp->getParentOp()) ||
+        !checkOpResultIsUsedByGetRef(&allocOp) || memRefType.getRank() != 1 ||
+        !hasAllConstantDimensions(memRefType) ||
+        getMemRefEltSizeInBytes(memRefType) != 1 || !isDeallocated(allocOp))
+      return;
+    markAllocation(allocOp, MEMORY_POOL_ATTR);
+  });
+}
+
+// Return the alloc op of the buffer returned as value, if value is the buffer
+// or a view of the buffer starting at its first element.
+static memref::AllocOp getOutputAlloc(Value value) {
+  while (Operation *op = value.getDefiningOp()) {
+    if (auto allocOp = dyn_cast<memref::AllocOp>(op))
+      return allocOp;
+    if (auto castOp = dyn_cast<memref::CastOp>(op))
+      value = castOp.getSource();
+    else if (auto castOp = dyn_cast<memref::ReinterpretCastOp>(op)) {
+      if (!castOp.getOffsets().empty() ||
+          llvm::any_of(castOp.getStaticOffsets(),
+              [](int64_t offset) { return offset != 0; }))
+        return nullptr;
+      value = castOp.getSource();
+    } else
+      return nullptr;
+  }
+  return nullptr;
+}
+
+void markOutputAllocations(ModuleOp &module) {
+  module.walk([&](KrnlEntryPointOp entryOp) {
+    entryOp->setAttr(OUTPUT_BUFFERS_ATTR, UnitAttr::get(module.getContext()));
+    auto funcOp = module.lookupSymbol<func::FuncOp>(
+        entryOp->getAttrOfType<SymbolRefAttr>(
+            KrnlEntryPointOp::getEntryPointFuncAttrName()));
+    if (!funcOp)
+      return;
+    funcOp.walk([&](func::ReturnOp returnOp) {
+      // Buffers returned as several outputs are left to malloc, since each
+      // output tensor frees them.
+      llvm::MapVector<Operation *, int64_t> outputAllocs;
+      llvm::SmallPtrSet<Operation *, 4> sharedAllocs;
+      for (auto output : llvm::enumerate(returnOp.getOperands())) {
+        memref::AllocOp allocOp = getOutputAlloc(output.value());
+        if (allocOp && !outputAllocs.insert({allocOp, output.index()}).second)
+          sharedAllocs.insert(allocOp);
+      }
+      // Only the buffers allocated once per call, i.e. in the body of the
+      // function, receive the outputs supplied by the caller.
+      for (auto &outputAlloc : outputAllocs) {
+        Operation *allocOp = outputAlloc.first;
+        if (sharedAllocs.contains(allocOp) ||
+            allocOp->getParentOp() != funcOp.getOperation() ||
+            isDeallocated(cast<memref::AllocOp>(allocOp)))
+          continue;
+        allocOp->setAttr(OUTPUT_ATTR,
+            IntegerAttr::get(IntegerType::get(module.getContext(), 64),
+                outputAlloc.second));
+      }
+    });
+  });
+}
+
+// Lower the allocations marked with attrName to calls to the allocFuncName
+// function of the runtime, which takes the size and alignment in bytes of the
+// buffer and returns its address.
+class RuntimeAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp> {
+public:
+  RuntimeAllocOpLowering(LLVMTypeConverter &typeConverter, StringRef attrName,
+      StringRef allocFuncName, PatternBenefit benefit)
+      : ConvertOpToLLVMPattern<memref::AllocOp>(typeConverter, benefit),
+        attrName(attrName), allocFuncName(allocFuncName) {}
+
+  LogicalResult matchAndRewrite(memref::AllocOp allocOp, OpAdaptor adaptor,
+      ConversionPatternRewriter &rewriter) const override {
+    if (!allocOp->hasAttr(attrName))
+      return failure();
+    MemRefType memRefType = allocOp.getType();
+    if (!isConvertibleAndHasIdentityMaps(memRefType))
+      return failure();
+    Location loc = allocOp.getLoc();
+    ModuleOp module = allocOp->getParentOfType<ModuleOp>();
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
+
+    SmallVector<Value, 4> sizes;
+    SmallVector<Value, 4> strides;
+    Value sizeBytes;
+    getMemRefDescriptorSizes(loc, memRefType, adaptor.getDynamicSizes(),
+        rewriter, sizes, strides, sizeBytes);
+
+    // Align the buffer as requested, and at least on its element size.
+    Type i64Ty = rewriter.getI64Type();
+    int64_t alignment = allocOp.getAlignment().value_or(0);
+    alignment =
+        std::max(alignment, (int64_t)getMemRefEltSizeInBytes(memRefType));
+    Type i8PtrTy = getVoidPtrType();
+    FlatSymbolRefAttr allocRef = create.llvm.getOrInsertSymbolRef(
+        module, allocFuncName, i8PtrTy, {i64Ty, i64Ty});
+    Value buffer = create.llvm.call(i8PtrTy, allocRef,
+        {sizeBytes, create.llvm.constant(i64Ty, alignment)});
+
+    Value ptr = create.llvm.bitcast(getElementPtrType(memRefType), buffer);
+    Value memRefDescriptor = createMemRefDescriptor(
+        loc, memRefType, ptr, ptr, sizes, strides, rewriter);
+    rewriter.replaceOp(allocOp, {memRefDescriptor});
+    return success();
+  }
+
+private:
+  std::string attrName;
+  std::string allocFuncName;
+};
+
+// Lower the deallocations marked with attrName to calls to the freeFuncName
+// function of the runtime, which takes the address of the buffer.
+class RuntimeDeallocOpLowering
+    : public ConvertOpToLLVMPattern<memref::DeallocOp> {
+public:
+  RuntimeDeallocOpLowering(LLVMTypeConverter &typeConverter,
+      StringRef attrName, StringRef freeFuncName, PatternBenefit benefit)
+      : ConvertOpToLLVMPattern<memref::DeallocOp>(typeConverter, benefit),
+        attrName(attrName), freeFuncName(freeFuncName) {}
+
+  LogicalResult matchAndRewrite(memref::DeallocOp deallocOp, OpAdaptor adaptor,
+      ConversionPatternRewriter &rewriter) const override {
+    if (!deallocOp->hasAttr(attrName))
+      return failure();
+    Location loc = deallocOp.getLoc();
+    ModuleOp module = deallocOp->getParentOfType<ModuleOp>();
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
+
+    Type i8PtrTy = getVoidPtrType();
+    FlatSymbolRefAttr freeRef = create.llvm.getOrInsertSymbolRef(module,
+        freeFuncName, LLVM::LLVMVoidType::get(getContext()), {i8PtrTy});
+    MemRefDescriptor memRefDescriptor(adaptor.getMemref());
+    Value buffer = create.llvm.bitcast(
+        i8PtrTy, memRefDescriptor.allocatedPtr(rewriter, loc));
+    create.llvm.call({}, freeRef, {buffer});
+    rewriter.eraseOp(deallocOp);
+    return success();
+  }
+
+private:
+  std::string attrName;
+  std::string freeFuncName;
+};
+
+// Lower the allocations of outputs to calls to omOutputAlloc, which takes the
+// index, data type and shape of the output, and the size and alignment in
+// bytes of the buffer. It returns the buffer supplied by the caller, or an
+// allocation in which the buffer is aligned, like the default lowering to
+// malloc.
+class OutputAllocOpLowering : public ConvertOpToLLVMPattern<memref::AllocOp> {
+public:
+  OutputAllocOpLowering(
+      LLVMTypeConverter &typeConverter, PatternBenefit benefit)
+      : ConvertOpToLLVMPattern<memref::AllocOp>(typeConverter, benefit) {}
+
+  LogicalResult matchAndRewrite(memref::AllocOp allocOp, OpAdaptor adaptor,
+      ConversionPatternRewriter &rewriter) const override {
+    auto indexAttr = allocOp->getAttrOfType<IntegerAttr>(OUTPUT_ATTR);
+    MemRefType memRefType = allocOp.getType();
+    if (!indexAttr || !isConvertibleAndHasIdentityMaps(memRefType))
+      return failure();
+    Location loc = allocOp.getLoc();
+    ModuleOp module = allocOp->getParentOfType<ModuleOp>();
+    MultiDialectBuilder<LLVMBuilder> create(rewriter, loc);
+
+    SmallVector<Value, 4> sizes;
+    SmallVector<Value, 4> strides;
+    Value sizeBytes;
+    getMemRefDescriptorSizes(loc, memRefType, adaptor.getDynamicSizes(),
+        rewriter, sizes, strides, sizeBytes);
+
+    Type i64Ty = rewriter.getI64Type();
+    int64_t alignment = allocOp.getAlignment().value_or(0);
+    alignment =
+        std::max(alignment, (int64_t)getMemRefEltSizeInBytes(memRefType));
+    Type i8PtrTy = getVoidPtrType();
+    Type i64PtrTy = LLVM::LLVMPointerType::get(i64Ty);
+
+    // Pass the shape of the output in an array on the stack.
+    int64_t rank = memRefType.getRank();
+    Value shape = create.llvm.null(i64PtrTy);
+    if (rank > 0) {
+      shape = create.llvm._alloca(
+          i64PtrTy, create.llvm.constant(i64Ty, rank), /*alignment=*/0);
+      for (int64_t i = 0; i < rank; ++i)
+        create.llvm.store(sizes[i],
+            create.llvm.getElemPtr(
+                i64PtrTy, shape, {create.llvm.constant(i64Ty, i)}));
+    }
+
+    FlatSymbolRefAttr allocRef = create.llvm.getOrInsertSymbolRef(module,
+        "omOutputAlloc", i8PtrTy,
+        {i64Ty, i64Ty, i64Ty, i64PtrTy, i64Ty, i64Ty});
+    Value alignmentVal = create.llvm.constant(i64Ty, alignment);
+    Value buffer = create.llvm.call(i8PtrTy, allocRef,
+        {create.llvm.constant(i64Ty, indexAttr.getInt()),
+            create.llvm.constant(i64Ty,
+                krnl::mlirTypeToOnnxType(memRefType.getElementType())),
+            create.llvm.constant(i64Ty, rank), shape, sizeBytes,
+            alignmentVal});
+
+    // Align the buffer: padding = (alignment - buffer % alignment) % alignment.
+    Value bufferInt = rewriter.create<LLVM::PtrToIntOp>(loc, i64Ty, buffer);
+    Value misalignment =
+        rewriter.create<LLVM::URemOp>(loc, bufferInt, alignmentVal);
+    Value padding = rewriter.create<LLVM::URemOp>(loc,
+        rewriter.create<LLVM::SubOp>(loc, alignmentVal, misalignment),
+        alignmentVal);
+    Value alignedBuffer = create.llvm.getElemPtr(i8PtrTy, buffer, {padding});
+
+    Type elementPtrTy = getElementPtrType(memRefType);
+    Value memRefDescriptor = createMemRefDescriptor(loc, memRefType,
+        create.llvm.bitcast(elementPtrTy, buffer),
+        create.llvm.bitcast(elementPtrTy, alignedBuffer), sizes, strides,
+        rewriter);
+    rewriter.replaceOp(allocOp, {memRefDescriptor});
+    return success();
+  }
+};
+
+void populateLoweringRuntimeAllocPattern(LLVMTypeConverter &typeConverter,
+    RewritePatternSet &patterns, MLIRContext *ctx) {
+  // Take precedence over the default lowering to malloc and free.
+  patterns.insert<RuntimeAllocOpLowering>(
+      typeConverter, SCRATCH_ATTR, "omScratchAlloc", /*benefit=*/2);
+  patterns.insert<RuntimeDeallocOpLowering>(
+      typeConverter, SCRATCH_ATTR, "omScratchFree", /*benefit=*/2);
+  patterns.insert<RuntimeAllocOpLowering>(
+      typeConverter, MEMORY_POOL_ATTR, "omMemoryPoolAcquire", /*benefit=*/2);
+  patterns.insert<RuntimeDeallocOpLowering>(
+      typeConverter, MEMORY_POOL_ATTR, "omMemoryPoolRelease", /*benefit=*/2);
+  patterns.insert<OutputAllocOpLowering>(typeConverter, /*benefit=*/2);
+}
+
+} // namespace krnl
+} // namespace onnx_mlir
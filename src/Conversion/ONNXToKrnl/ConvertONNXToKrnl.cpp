@@ -15,6 +15,7 @@
 
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Shape/IR/Shape.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "src/Compiler/CompilerOptions.hpp"
 
 #include "src/Accelerators/Accelerator.hpp"
@@ -167,7 +168,7 @@ std::map<std::string, std::string> ONNXEntryPointLowering::typeMap = {
 
 void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
     TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
-    bool enableParallel) {
+    bool enableSIMD, bool enableFusion, bool enableParallel) {
   // Type conversion for function signatures.
   // Call MLIR FuncOp signature conversion when result type is
   // a ranked tensor.
@@ -184,14 +185,18 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
   // Math
   populateLoweringONNXClipOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXCumSumOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXElementwiseOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXGemmOpPattern(patterns, typeConverter, ctx, enableTiling);
+  populateLoweringONNXElementwiseOpPattern(
+      patterns, typeConverter, ctx, enableSIMD, enableFusion, enableParallel);
+  populateLoweringONNXGemmOpPattern(
+      patterns, typeConverter, ctx, enableTiling, enableFusion, enableParallel);
   populateLoweringONNXHardmaxOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXReductionOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXSoftmaxOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXReductionOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
+  populateLoweringONNXSoftmaxOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXTopKOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXMatMulOpPattern(
-      patterns, typeConverter, ctx, enableTiling);
+      patterns, typeConverter, ctx, enableTiling, enableFusion, enableParallel);
   populateLoweringONNXRandomNormalOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXRandomNormalLikeOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXLRNOpPattern(patterns, typeConverter, ctx);
@@ -206,14 +211,17 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
   populateLoweringONNXPadOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXUnsqueezeOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXUnsqueezeV11OpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXTransposeOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXGatherOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXTransposeOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
+  populateLoweringONNXGatherOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXGatherElementsOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXGatherNDOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXIdentityOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXConstantOfShapeOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXConstantOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXConcatOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXConcatOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
   populateLoweringONNXConcatShapeTransposeOpPattern(
       patterns, typeConverter, ctx);
   populateLoweringONNXDepthToSpaceOpPattern(patterns, typeConverter, ctx);
@@ -241,9 +249,11 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
 
   // Neural network
   populateLoweringONNXConvOpPattern(
+      patterns, typeConverter, ctx, enableFusion, enableParallel);
+  populateLoweringONNXNormalizationOpPattern(
+      patterns, typeConverter, ctx, enableParallel);
+  populateLoweringONNXPoolingOpPattern(
       patterns, typeConverter, ctx, enableParallel);
-  populateLoweringONNXNormalizationOpPattern(patterns, typeConverter, ctx);
-  populateLoweringONNXPoolingOpPattern(patterns, typeConverter, ctx);
   // Recurrent neural network
   populateLoweringONNXGRUOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXLSTMOpPattern(patterns, typeConverter, ctx);
@@ -279,18 +289,31 @@ struct FrontendToKrnlLoweringPass
   FrontendToKrnlLoweringPass() = default;
   FrontendToKrnlLoweringPass(const FrontendToKrnlLoweringPass &pass)
       : PassWrapper<FrontendToKrnlLoweringPass, OperationPass<ModuleOp>>() {}
-  FrontendToKrnlLoweringPass(
-      bool emitDealloc, bool enableTiling, bool enableParallel) {
+  FrontendToKrnlLoweringPass(bool emitDealloc, bool enableTiling,
+      bool enableSIMD, bool enableFusion, bool enableParallel) {
     // Below, need explicit assignment to enable implicit conversion of bool to
     // Option<bool>.
     this->emitDealloc = emitDealloc;
     this->enableTiling = enableTiling;
+    this->enableSIMD = enableSIMD;
+    this->enableFusion = enableFusion;
     this->enableParallel = enableParallel;
   }
-  FrontendToKrnlLoweringPass(int optLevel, bool enableParallel)
+  FrontendToKrnlLoweringPass(int optLevel, bool enableSIMD, bool enableFusion,
+      bool enableParallel)
       : FrontendToKrnlLoweringPass(
-            /*emitDealloc=*/false, /*enableTiling=*/optLevel >= 3,
-            enableParallel) {}
+            /*emitDealloc=*/false, /*enableTiling=*/optLevel >= 3, enableSIMD,
+            enableFusion, enableParallel) {}
+  FrontendToKrnlLoweringPass(int optLevel, bool enableSIMD, bool enableFusion,
+      bool enableParallel, bool enableInPlace, int64_t l1CacheSize,
+      int64_t l2CacheSize, int64_t l3CacheSize)
+      : FrontendToKrnlLoweringPass(
+            optLevel, enableSIMD, enableFusion, enableParallel) {
+    this->enableInPlace = enableInPlace;
+    this->l1CacheSize = l1CacheSize;
+    this->l2CacheSize = l2CacheSize;
+    this->l3CacheSize = l3CacheSize;
+  }
 
   void runOnOperation() final;
 
@@ -316,8 +339,27 @@ public:
   Option<bool> enableTiling{*this, "enable-tiling",
       llvm::cl::desc("Enable loop tiling and unrolling optimizations"),
       llvm::cl::init(false)};
+  Option<bool> enableSIMD{*this, "enable-simd",
+      llvm::cl::desc("Enable SIMD code generation for element-wise ops"),
+      llvm::cl::init(false)};
+  Option<bool> enableFusion{*this, "enable-fusion",
+      llvm::cl::desc("Fuse chains of element-wise ops into single loop nests"),
+      llvm::cl::init(false)};
   Option<bool> enableParallel{*this, "enable-parallel",
       llvm::cl::desc("Enable parallelization"), llvm::cl::init(false)};
+  Option<bool> enableInPlace{*this, "enable-in-place",
+      llvm::cl::desc("Compute element-wise ops in place in the buffer of an "
+                     "operand without other uses"),
+      llvm::cl::init(false)};
+  Option<int64_t> l1CacheSize{*this, "l1-cache-size",
+      llvm::cl::desc("Size in KiB of the L1 data cache of the target"),
+      llvm::cl::init(32)};
+  Option<int64_t> l2CacheSize{*this, "l2-cache-size",
+      llvm::cl::desc("Size in KiB of the L2 cache of the target"),
+      llvm::cl::init(1024)};
+  Option<int64_t> l3CacheSize{*this, "l3-cache-size",
+      llvm::cl::desc("Size in KiB of the L3 cache of the target"),
+      llvm::cl::init(8192)};
 };
 
 void FrontendToKrnlLoweringPass::runOnOperation() {
@@ -326,6 +368,14 @@ void FrontendToKrnlLoweringPass::runOnOperation() {
   // Set up whether emitting dealloc for allocated memrefs or not.
   ONNXToKrnl_gEmitDealloc = emitDealloc;
 
+  // Set up whether element-wise ops may be computed in place.
+  ONNXToKrnl_gEnableInPlace = enableInPlace;
+
+  // Set up the cache sizes used to block loop nests.
+  ONNXToKrnl_gL1CacheSize = l1CacheSize * 1024;
+  ONNXToKrnl_gL2CacheSize = l2CacheSize * 1024;
+  ONNXToKrnl_gL3CacheSize = l3CacheSize * 1024;
+
   // The first thing to define is the conversion target. This will define the
   // final target for this lowering.
   ConversionTarget target(getContext());
@@ -334,7 +384,8 @@ void FrontendToKrnlLoweringPass::runOnOperation() {
   // this lowering.
   target.addLegalDialect<KrnlDialect, AffineDialect, arith::ArithDialect,
       func::FuncDialect, linalg::LinalgDialect, math::MathDialect,
-      memref::MemRefDialect, shape::ShapeDialect, scf::SCFDialect>();
+      memref::MemRefDialect, shape::ShapeDialect, scf::SCFDialect,
+      vector::VectorDialect>();
   // Needed to support unsigned int computations. To be removed if we use a
   // scheme that does not rely on the UnrealizedConversionCastOp.
   target.addLegalOp<::mlir::UnrealizedConversionCastOp>();
@@ -405,8 +456,8 @@ void FrontendToKrnlLoweringPass::runOnOperation() {
   });
 
   // Define patterns.
-  populateONNXToKrnlConversionPattern(
-      patterns, krnlTypeConverter, &getContext(), enableTiling, enableParallel);
+  populateONNXToKrnlConversionPattern(patterns, krnlTypeConverter,
+      &getContext(), enableTiling, enableSIMD, enableFusion, enableParallel);
 
   // Rewrite patterns for accelerators.
   for (auto *accel : onnx_mlir::accel::Accelerator::getAccelerators())
@@ -424,14 +475,25 @@ std::unique_ptr<Pass> createLowerToKrnlPass() {
   return std::make_unique<FrontendToKrnlLoweringPass>();
 }
 
-std::unique_ptr<Pass> createLowerToKrnlPass(int optLevel, bool enableParallel) {
-  return std::make_unique<FrontendToKrnlLoweringPass>(optLevel, enableParallel);
+std::unique_ptr<Pass> createLowerToKrnlPass(int optLevel, bool enableSIMD,
+    bool enableFusion, bool enableParallel) {
+  return std::make_unique<FrontendToKrnlLoweringPass>(
+      optLevel, enableSIMD, enableFusion, enableParallel);
+}
+
+std::unique_ptr<Pass> createLowerToKrnlPass(int optLevel, bool enableSIMD,
+    bool enableFusion, bool enableParallel, bool enableInPlace,
+    int64_t l1CacheSize, int64_t l2CacheSize, int64_t l3CacheSize) {
+  return std::make_unique<FrontendToKrnlLoweringPass>(optLevel, enableSIMD,
+      enableFusion, enableParallel, enableInPlace, l1CacheSize, l2CacheSize,
+      l3CacheSize);
 }
 
-std::unique_ptr<Pass> createLowerToKrnlPass(
-    bool emitDealloc, bool enableTiling, bool enableParallel) {
+std::unique_ptr<Pass> createLowerToKrnlPass(bool emitDealloc,
+    bool enableTiling, bool enableSIMD, bool enableFusion,
+    bool enableParallel) {
   return std::make_unique<FrontendToKrnlLoweringPass>(
-      emitDealloc, enableTiling, enableParallel);
+      emitDealloc, enableTiling, enableSIMD, enableFusion, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -4,12 +4,17 @@
 
 //===------------ CategoryMapper.cpp - Lowering CategoryMapper Op ---------===//
 //
-// Copyright 2021-2022 The IBM Research Authors.
+// Copyright 2021-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
 // This file lowers the ONNX CategoryMapper Operator to Krnl dialect.
 //
+// The categories are placed in a perfect hash table at compile time. The
+// index of every input value in the table is looked up by a single runtime
+// call, and a Krnl loop then stores the mapped value of the valid indices and
+// the default value of the others.
+//
 //===----------------------------------------------------------------------===//
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
@@ -31,7 +36,6 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
   using PerfectHashTable = struct {
     Value G;
     Value V;
-    Value len;
   };
 
   // When true causes injection of print stmts in the generated code.
@@ -131,6 +135,12 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
 
     // Lookup the index in the perfect hash table corresponding to
     // each input value.
+    MemRefType indicesType =
+        MemRefType::get(memRefType.getShape(), rewriter.getIntegerType(64));
+    Value indices = insertAllocAndDeallocSimple(rewriter, op, indicesType, loc,
+        shapeHelper.getOutputDims(), /*insertDealloc=*/true);
+    emitFindIndices(indices, X, elementType, perfectHashTable, create);
+
     LiteralIndexExpr zeroIE(0);
     SmallVector<IndexExpr, 4> lbs(rank, zeroIE);
     SmallVector<IndexExpr, 4> ubs;
@@ -142,7 +152,7 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
     ValueRange loopDef = create.krnl.defineLoops(rank);
     create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
         [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-          // Determine the index of 'inputElem' in the perfect hash table
+          // Load the index of 'inputElem' in the perfect hash table
           // 'pHash'. Note: the index might not be valid (this happens
           // when the 'inputElem' is not present in the perfect hash
           // table).
@@ -151,10 +161,10 @@ struct ONNXCategoryMapperOpLowering : public ConversionPattern {
           if (emitPrintStmts)
             create.krnl.printf("inputElem: ", inputElem, elementType);
 
-          Value index, isIndexValid;
-          std::tie(index, isIndexValid) =
-              emitFindIndex(inputElem, elementType, perfectHashTable,
-                  constantForCatsInt64s, constantForCatsStrings, create);
+          Value index = rewriter.create<arith::IndexCastOp>(loc,
+              rewriter.getIndexType(), createKrnl.load(indices, loopInd));
+          Value isIndexValid = emitIsIndexValid(inputElem, index, elementType,
+              constantForCatsInt64s, constantForCatsStrings, create);
 
           if (emitPrintStmts)
             create.krnl.printf("index: ", index, index.getType());
@@ -204,7 +214,6 @@ private:
           {static_cast<int64_t>(V.size())}, builder.getIntegerType(32));
       res.G = create.krnl.constant(type, "G", builder.getI32TensorAttr(G));
       res.V = create.krnl.constant(type, "V", builder.getI32TensorAttr(V));
-      res.len = create.math.constant(builder.getIntegerType(32), G.size());
       return res;
     };
 
@@ -271,27 +280,33 @@ private:
     return inputElem;
   }
 
-  // Determine the index of 'inputElem' in the perfect hash table 'pHash'.
-  // Return the index and a true/false value depending on whether the index is
-  // valid or not.
-  std::tuple<Value, Value> emitFindIndex(Value inputElem, Type elementType,
-      const PerfectHashTable &pHash, Value constantForCatsInt64s,
-      Value constantForCatsStrings, const LocalDialectBuilder &create) const {
-    OpBuilder builder = create.krnl.getBuilder();
-    Value index = create.krnl.findIndex(inputElem, pHash.G, pHash.V, pHash.len);
+  // Determine the index of each element of 'X' in the perfect hash table
+  // 'pHash' with a single runtime call, and store them into 'indices'.
+  void emitFindIndices(Value indices, Value X, Type elementType,
+      const PerfectHashTable &pHash, const LocalDialectBuilder &create) const {
+    StringRef funcName = elementType.isa<krnl::StringType>()
+                             ? "find_indices_str"
+                             : "find_indices_i64";
+    SmallVector<Value, 3> operands = {X, pHash.G, pHash.V};
+    create.krnl.getBuilder().create<KrnlCallOp>(
+        create.krnl.getLoc(), funcName, indices, operands);
+  }
 
-    std::tuple<Value, Value> res;
+  // Return whether 'index', the index of 'inputElem' in the perfect hash table,
+  // is valid, i.e. whether 'inputElem' is in the dictionary.
+  Value emitIsIndexValid(Value inputElem, Value index, Type elementType,
+      Value constantForCatsInt64s, Value constantForCatsStrings,
+      const LocalDialectBuilder &create) const {
+    OpBuilder builder = create.krnl.getBuilder();
+    Value isIndexValid;
     TypeSwitch<Type>(elementType)
         .Case<IntegerType>([&](IntegerType type) {
-          // Determine whether the index returned is valid.
-          // The index is valid if 'inputElem' compares equal to the string in
-          // 'constantForCatsInt64s'.
+          // The index is valid if 'inputElem' compares equal to the integer
+          // in 'constantForCatsInt64s'.
           Value compareVal = create.krnl.load(constantForCatsInt64s, {index});
-          Value isIndexValid = create.math.eq(inputElem, compareVal);
-          res = std::make_tuple(index, isIndexValid);
+          isIndexValid = create.math.eq(inputElem, compareVal);
         })
         .Case<krnl::StringType>([&](krnl::StringType type) {
-          // Determine whether the index returned is valid.
           // The index is valid if 'inputElem' compares equal to the string in
           // 'constantForCatsStrings'.
           Value compareVal = create.krnl.load(constantForCatsStrings, {index});
@@ -299,15 +314,14 @@ private:
           Value strncmpRes =
               create.krnl.strncmp(inputElem, compareVal, strlenRes);
           Value zeroVal = create.math.constant(builder.getIntegerType(32), 0);
-          Value isIndexValid = create.math.eq(strncmpRes, zeroVal);
-          res = std::make_tuple(index, isIndexValid);
+          isIndexValid = create.math.eq(strncmpRes, zeroVal);
         })
         .Default([&](Type type) {
           llvm::errs() << "type: " << type << "\n";
           llvm_unreachable("Illegal KeyTy");
         });
 
-    return res;
+    return isIndexValid;
   }
 
   // Store the result in the 'alloc' buffer.
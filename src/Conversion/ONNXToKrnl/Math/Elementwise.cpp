@@ -27,6 +27,138 @@ Value emitPostProcessingFor(ConversionPatternRewriter &rewriter, Location loc,
   return scalarResult;
 }
 
+/// Return true if the computation emitted by emitScalarOpFor and
+/// emitPostProcessingFor for this op also accepts vectors of its element type.
+/// Specialize this for a new Op whose computation is vector friendly.
+template <typename Op>
+bool hasSIMDSupport() {
+  return false;
+}
+template <>
+bool hasSIMDSupport<ONNXAbsOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXAddOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXCeilOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXDivOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXExpOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXFloorOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXMaxOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXMeanOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXMinOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXMulOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXNegOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXPowOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXReciprocalOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXReluOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXSigmoidOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXSqrtOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXSubOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXSumOp>() { return true; }
+template <>
+bool hasSIMDSupport<ONNXTanhOp>() { return true; }
+
+/// Return the number of elements computed per iteration by the SIMD code of an
+/// element-wise op, or 0 if the op must use the scalar code. SIMD code is
+/// generated for float types when all the operands have the static shape and
+/// the identity layout of the output, except for single-element operands which
+/// are broadcast. Other broadcasts, and innermost dimensions shorter than the
+/// machine vector length, use the scalar code.
+template <typename Op>
+static int64_t getSIMDVectorLength(bool enableSIMD, MemRefType outputType,
+    ArrayRef<Value> operands, const VectorBuilder &createVec) {
+  if (!enableSIMD || !hasSIMDSupport<Op>())
+    return 0;
+  Type elementType = outputType.getElementType();
+  int64_t rank = outputType.getRank();
+  if (rank == 0 || !elementType.isa<FloatType>() ||
+      !outputType.hasStaticShape() || !outputType.getLayout().isIdentity())
+    return 0;
+  ArrayRef<int64_t> shape = outputType.getShape();
+  for (Value operand : operands) {
+    MemRefType operandType = operand.getType().dyn_cast<MemRefType>();
+    if (!operandType || operandType.getElementType() != elementType ||
+        !operandType.hasStaticShape() || !operandType.getLayout().isIdentity())
+      return 0;
+    if (operandType.getShape() != shape && operandType.getNumElements() != 1)
+      return 0;
+  }
+  int64_t VL = createVec.getMachineVectorLength(elementType);
+  if (shape[rank - 1] < VL)
+    return 0;
+  return VL;
+}
+
+/// Emit the SIMD loop nest of an element-wise op for which getSIMDVectorLength
+/// returned VL. The innermost dimension is blocked by VL: each iteration loads
+/// one vector per operand (single-element operands are broadcast), computes the
+/// result vector with emitVectorOp, and stores it in alloc. Return true if the
+/// innermost dimension is not a multiple of VL, in which case the innermost
+/// lower bound in lbs is set to the first element left to the scalar code.
+static bool emitSIMDLoopNest(ConversionPatternRewriter &rewriter, Location loc,
+    bool enableParallel, Value alloc, ArrayRef<Value> operands, int64_t VL,
+    SmallVectorImpl<IndexExpr> &lbs,
+    function_ref<Value(ArrayRef<Value> vectorOperands)> emitVectorOp) {
+  MultiDialectBuilder<KrnlBuilder, MathBuilder, VectorBuilder> create(
+      rewriter, loc);
+  MemRefType outputType = alloc.getType().cast<MemRefType>();
+  ArrayRef<int64_t> shape = outputType.getShape();
+  int64_t rank = outputType.getRank();
+  int64_t numVectors = shape[rank - 1] / VL;
+  VectorType vecType = VectorType::get({VL}, outputType.getElementType());
+
+  // Iterate over the outer dimensions and over the vectors of the innermost
+  // dimension.
+  SmallVector<IndexExpr, 4> simdLbs(rank, LiteralIndexExpr(0));
+  SmallVector<IndexExpr, 4> simdUbs;
+  for (int64_t i = 0; i < rank - 1; ++i)
+    simdUbs.emplace_back(LiteralIndexExpr(shape[i]));
+  simdUbs.emplace_back(LiteralIndexExpr(numVectors));
+  iterateIEOptionalParallel(create.krnl, enableParallel,
+      std::max<int64_t>(rank - 1, 1), simdLbs, simdUbs,
+      [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+        SmallVector<Value, 4> indices(loopInd.begin(), loopInd.end());
+        indices[rank - 1] = create.math.mul(
+            loopInd[rank - 1], create.math.constantIndex(VL));
+        SmallVector<Value, 4> vectorOperands;
+        for (Value operand : operands) {
+          MemRefType operandType = operand.getType().cast<MemRefType>();
+          if (operandType.getShape() == shape) {
+            vectorOperands.emplace_back(
+                create.vec.load(vecType, operand, indices));
+            continue;
+          }
+          // Broadcast single-element operands.
+          SmallVector<Value, 4> zeros(
+              operandType.getRank(), create.math.constantIndex(0));
+          Value scalar = createKrnl.load(operand, zeros);
+          vectorOperands.emplace_back(create.vec.broadcast(vecType, scalar));
+        }
+        create.vec.store(emitVectorOp(vectorOperands), alloc, indices);
+      },
+      /*workPerIteration=*/VL);
+
+  if (numVectors * VL == shape[rank - 1])
+    return false;
+  lbs[rank - 1] = LiteralIndexExpr(numVectors * VL);
+  return true;
+}
+
 template <>
 struct ScalarOp<ONNXTanhOp> {
   using FOp = math::TanhOp;
@@ -528,12 +660,12 @@ Value emitScalarOpFor<ONNXMaxOp>(ConversionPatternRewriter &rewriter,
   Value lhs = scalarOperands[0];
   Value rhs = scalarOperands[1];
   Value max;
-  if (elementType.isa<FloatType>()) {
+  if (MathBuilder::isFloatWithVector(elementType)) {
     max = rewriter.create<arith::CmpFOp>(
         loc, arith::CmpFPredicate::OGT, lhs, rhs);
     return rewriter.create<arith::SelectOp>(loc, max, lhs, rhs);
-  } else if (elementType.isa<IntegerType>()) {
-    if (elementType.isUnsignedInteger()) {
+  } else if (MathBuilder::isIntegerWithVector(elementType)) {
+    if (MathBuilder::isUnsignedIntegerWithVector(elementType)) {
       max = rewriter.create<arith::CmpIOp>(
           loc, arith::CmpIPredicate::ugt, lhs, rhs);
     } else {
@@ -559,11 +691,11 @@ Value emitScalarOpFor<ONNXMinOp>(ConversionPatternRewriter &rewriter,
   Value lhs = scalarOperands[0];
   Value rhs = scalarOperands[1];
   Value min;
-  if (elementType.isa<FloatType>()) {
+  if (MathBuilder::isFloatWithVector(elementType)) {
     min = rewriter.create<arith::CmpFOp>(
         loc, arith::CmpFPredicate::OLT, lhs, rhs);
-  } else if (elementType.isa<IntegerType>()) {
-    if (elementType.isUnsignedInteger())
+  } else if (MathBuilder::isIntegerWithVector(elementType)) {
+    if (MathBuilder::isUnsignedIntegerWithVector(elementType))
       min = rewriter.create<arith::CmpIOp>(
           loc, arith::CmpIPredicate::ult, lhs, rhs);
     else
@@ -584,9 +716,9 @@ Value emitScalarOpFor<ONNXNegOp>(ConversionPatternRewriter &rewriter,
     ArrayRef<Value> scalarOperands) {
   Value operand = scalarOperands[0];
 
-  if (elementType.isa<FloatType>()) {
+  if (MathBuilder::isFloatWithVector(elementType)) {
     return rewriter.create<arith::NegFOp>(loc, operand);
-  } else if (elementType.isa<IntegerType>()) {
+  } else if (MathBuilder::isIntegerWithVector(elementType)) {
     MathBuilder createMath(rewriter, loc);
     Value zero = createMath.constant(elementType, 0);
     return createMath.sub(zero, operand); // 0 - X = -X
@@ -818,13 +950,251 @@ Value emitScalarOpFor<ONNXRoundOp>(ConversionPatternRewriter &rewriter,
     llvm_unreachable("unsupported element type");
   }
 }
+
+//===----------------------------------------------------------------------===//
+// Fusion of chains of element-wise ops.
+//===----------------------------------------------------------------------===//
+
+/// A list of element-wise ops whose computation can be emitted by
+/// emitScalarOpFor given the Operation only.
+template <typename... Ops>
+struct ElementwiseOpList {
+  static bool contains(Operation *op) { return isa<Ops...>(op); }
+
+  static bool hasSIMDSupport(Operation *op) {
+    return ((isa<Ops>(op) && onnx_mlir::hasSIMDSupport<Ops>()) || ...);
+  }
+
+  static Value emitScalarOpFor(ConversionPatternRewriter &rewriter,
+      Location loc, Operation *op, Type elementType,
+      ArrayRef<Value> scalarOperands) {
+    Value result;
+    ((isa<Ops>(op) && (result = onnx_mlir::emitScalarOpFor<Ops>(rewriter,
+                           loc, op, elementType, scalarOperands))) ||
+        ...);
+    assert(result && "unsupported fused op");
+    return result;
+  }
+};
+
+// Unary ops that can be fused after another element-wise op.
+using FusibleUnaryOps = ElementwiseOpList<ONNXAbsOp, ONNXAtanOp, ONNXCeilOp,
+    ONNXCosOp, ONNXCoshOp, ONNXEluOp, ONNXErfOp, ONNXExpOp, ONNXFloorOp,
+    ONNXHardSigmoidOp, ONNXLeakyReluOp, ONNXLogOp, ONNXNegOp,
+    ONNXReciprocalOp, ONNXReluOp, ONNXRoundOp, ONNXSeluOp, ONNXSigmoidOp,
+    ONNXSignOp, ONNXSinOp, ONNXSinhOp, ONNXSoftplusOp, ONNXSoftsignOp,
+    ONNXSqrtOp, ONNXTanOp, ONNXTanhOp>;
+
+// Binary ops that can be fused after another element-wise op, which computes
+// one of their operands.
+using FusibleBinaryOps = ElementwiseOpList<ONNXAddOp, ONNXDivOp, ONNXMaxOp,
+    ONNXMinOp, ONNXMulOp, ONNXPowOp, ONNXSubOp, ONNXSumOp>;
+
+bool ElementwiseFusionHelper::hasSIMDSupport() const {
+  return llvm::all_of(fusedOps, [](Operation *op) {
+    return isa<ONNXClipOp>(op) || FusibleUnaryOps::hasSIMDSupport(op) ||
+           FusibleBinaryOps::hasSIMDSupport(op);
+  });
+}
+
+Value ElementwiseFusionHelper::emitFusedOps(KrnlBuilder &createKrnl,
+    ValueRange outputIndices, Type elementType, Value rootResult) const {
+  if (fusedOps.empty())
+    return rootResult;
+  SmallVector<Value, 4> fusedOperandValues;
+  MathBuilder createMath(createKrnl);
+  int64_t outputRank = outputIndices.size();
+  for (Value operand : fusedOperands) {
+    ArrayRef<int64_t> shape = operand.getType().cast<MemRefType>().getShape();
+    int64_t rank = shape.size();
+    SmallVector<Value, 4> indices;
+    for (int64_t d = 0; d < rank; ++d)
+      indices.emplace_back(shape[d] == 1
+                               ? createMath.constantIndex(0)
+                               : outputIndices[outputRank - rank + d]);
+    fusedOperandValues.emplace_back(createKrnl.load(operand, indices));
+  }
+  return emitFusedOps(elementType, rootResult, fusedOperandValues);
+}
+
+Value ElementwiseFusionHelper::emitFusedOps(Type elementOrVectorType,
+    Value rootResult, ArrayRef<Value> fusedOperandValues) const {
+  assert(fusedOperandValues.size() == fusedOperands.size() &&
+         "expected a value per fused operand");
+  Value result = rootResult;
+  for (int64_t i = 0, e = fusedOps.size(); i < e; ++i) {
+    Operation *fusedOp = fusedOps[i];
+    Location loc = fusedOp->getLoc();
+    ArrayRef<int64_t> operandIndices = fusedOperandIndices[i];
+    if (isa<ONNXClipOp>(fusedOp)) {
+      // Same computation as the Clip lowering.
+      MathBuilder createMath(rewriter, loc);
+      if (operandIndices[0] >= 0) {
+        Value minVal = fusedOperandValues[operandIndices[0]];
+        Value lessThanMin = createMath.slt(result, minVal);
+        result = createMath.select(lessThanMin, minVal, result);
+      }
+      if (operandIndices[1] >= 0) {
+        Value maxVal = fusedOperandValues[operandIndices[1]];
+        Value lessThanMax = createMath.slt(result, maxVal);
+        result = createMath.select(lessThanMax, result, maxVal);
+      }
+      continue;
+    }
+    if (operandIndices.empty()) {
+      result = FusibleUnaryOps::emitScalarOpFor(
+          rewriter, loc, fusedOp, elementOrVectorType, {result});
+      continue;
+    }
+    // Preserve the order of the operands of non-commutative ops.
+    Value other = fusedOperandValues[operandIndices[0]];
+    SmallVector<Value, 2> operands = {result, other};
+    if (!chainIsFirstOperand[i])
+      std::swap(operands[0], operands[1]);
+    result = FusibleBinaryOps::emitScalarOpFor(
+        rewriter, loc, fusedOp, elementOrVectorType, operands);
+  }
+  return result;
+}
+
+void ElementwiseFusionHelper::findFusibleOps() {
+  if (rootOp->getNumResults() != 1)
+    return;
+  auto outputType = rootOp->getResult(0).getType().dyn_cast<RankedTensorType>();
+  if (!outputType || !outputType.hasStaticShape())
+    return;
+  ArrayRef<int64_t> outputShape = outputType.getShape();
+
+  // Return the converted value of an operand not computed by the chain if it
+  // is available before the loop nest and is a memref that can be broadcast to
+  // the output shape, or a null value otherwise.
+  auto getBroadcastableOperand = [&](Value operand) -> Value {
+    Operation *operandDef = operand.getDefiningOp();
+    if (operandDef && operandDef->getBlock() == rootOp->getBlock() &&
+        !operandDef->isBeforeInBlock(rootOp))
+      return nullptr;
+    Value convertedOperand = rewriter.getRemappedValue(operand);
+    auto operandType =
+        convertedOperand ? convertedOperand.getType().dyn_cast<MemRefType>()
+                         : MemRefType();
+    if (!operandType || !operandType.hasStaticShape() ||
+        operandType.getElementType() != outputType.getElementType() ||
+        operandType.getRank() > outputType.getRank())
+      return nullptr;
+    ArrayRef<int64_t> operandShape = operandType.getShape();
+    int64_t rankOffset = outputShape.size() - operandShape.size();
+    for (int64_t d = 0, e = operandShape.size(); d < e; ++d)
+      if (operandShape[d] != 1 &&
+          operandShape[d] != outputShape[rankOffset + d])
+        return nullptr;
+    return convertedOperand;
+  };
+
+  Value chainValue = rootOp->getResult(0);
+  while (chainValue.hasOneUse()) {
+    Operation *user = *chainValue.getUsers().begin();
+    if (user->getBlock() != rootOp->getBlock() ||
+        user->getNumResults() != 1 ||
+        user->getResult(0).getType() != outputType)
+      break;
+    if (FusibleUnaryOps::contains(user) && user->getNumOperands() == 1) {
+      fusedOps.emplace_back(user);
+      fusedOperandIndices.emplace_back();
+      chainIsFirstOperand.emplace_back(true);
+      chainValue = user->getResult(0);
+      continue;
+    }
+    if (auto clipOp = dyn_cast<ONNXClipOp>(user)) {
+      // The chain computes the input; min and max are optional scalars.
+      if (clipOp.input() != chainValue)
+        break;
+      SmallVector<int64_t, 2> operandIndices;
+      SmallVector<Value, 2> bounds;
+      for (Value bound : {clipOp.min(), clipOp.max()}) {
+        if (isFromNone(bound)) {
+          operandIndices.emplace_back(-1);
+          continue;
+        }
+        Value convertedBound = getBroadcastableOperand(bound);
+        if (!convertedBound ||
+            convertedBound.getType().cast<MemRefType>().getNumElements() != 1)
+          break;
+        operandIndices.emplace_back(fusedOperands.size() + bounds.size());
+        bounds.emplace_back(convertedBound);
+      }
+      if (operandIndices.size() != 2)
+        break;
+      fusedOps.emplace_back(user);
+      fusedOperandIndices.emplace_back(operandIndices);
+      chainIsFirstOperand.emplace_back(true);
+      fusedOperands.append(bounds.begin(), bounds.end());
+      chainValue = user->getResult(0);
+      continue;
+    }
+    if (!FusibleBinaryOps::contains(user) || user->getNumOperands() != 2)
+      break;
+    bool isFirstOperand = user->getOperand(0) == chainValue;
+    Value other =
+        getBroadcastableOperand(user->getOperand(isFirstOperand ? 1 : 0));
+    if (!other)
+      break;
+    fusedOps.emplace_back(user);
+    fusedOperandIndices.emplace_back(
+        SmallVector<int64_t, 2>{(int64_t)fusedOperands.size()});
+    chainIsFirstOperand.emplace_back(isFirstOperand);
+    fusedOperands.emplace_back(other);
+    chainValue = user->getResult(0);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// In-place computation of element-wise ops.
+//===----------------------------------------------------------------------===//
+
+/// Return the buffer of the operand operandIndex of op if the result of op can
+/// be computed in place in it, or nullptr otherwise. This is the case when
+/// the operand is only used by op, and is computed in a buffer of the type of
+/// the result by an op whose lowering allocates a new buffer, as opposed to
+/// ops returning a view of their operands. Element-wise ops compute each
+/// element of their result from the elements of their operands at the same
+/// indices, which are thus no longer needed once the element is stored.
+static Value getInPlaceBuffer(Operation *op, ArrayRef<Value> operands,
+    int64_t operandIndex, MemRefType resultType) {
+  // Deallocs emitted during the lowering would free a buffer that is still
+  // used by the result.
+  if (!ONNXToKrnl_gEnableInPlace || ONNXToKrnl_gEmitDealloc)
+    return nullptr;
+  Value input = op->getOperand(operandIndex);
+  Operation *producer = input.getDefiningOp();
+  if (!input.hasOneUse() || !producer ||
+      !(FusibleUnaryOps::contains(producer) ||
+          FusibleBinaryOps::contains(producer) ||
+          isa<ONNXClipOp, ONNXConvOp, ONNXGemmOp, ONNXMatMulOp>(producer)))
+    return nullptr;
+  Value buffer = operands[operandIndex];
+  auto allocOp = buffer.getDefiningOp<memref::AllocOp>();
+  if (!allocOp || allocOp->getBlock() != op->getBlock() ||
+      buffer.getType() != resultType)
+    return nullptr;
+  return buffer;
+}
+
 // Element-wise unary ops lowering to Krnl dialect.
 //===----------------------------------------------------------------------===//
 template <typename ElementwiseUnaryOp>
 struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
-  ONNXElementwiseUnaryOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  bool enableSIMD = false;
+  bool enableFusion = false;
+  bool enableParallel = false;
+
+  ONNXElementwiseUnaryOpLowering(TypeConverter &typeConverter,
+      MLIRContext *ctx, bool enableSIMD, bool enableFusion, bool enableParallel)
       : ConversionPattern(
-            typeConverter, ElementwiseUnaryOp::getOperationName(), 1, ctx) {}
+            typeConverter, ElementwiseUnaryOp::getOperationName(), 1, ctx) {
+    this->enableSIMD = enableSIMD;
+    this->enableFusion = enableFusion;
+    this->enableParallel = enableParallel;
+  }
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     Location loc = ONNXLoc<ElementwiseUnaryOp>(op);
@@ -850,38 +1220,69 @@ struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
     MemRefType memRefType = convertedType.cast<MemRefType>();
 
     // Shape helper.
-    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder> create(
-        rewriter, loc);
+    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder, VectorBuilder>
+        create(rewriter, loc);
     ONNXUnaryOpShapeHelper shapeHelper(op, operands, &create.krnlIE);
     shapeHelper.computeShapeAndAssertOnFailure();
 
-    // Insert an allocation for the result of this operation.
-    Value alloc = insertAllocAndDeallocSimple(
-        rewriter, op, memRefType, loc, shapeHelper.getOutputDims(), alignment);
+    // Element-wise ops consuming the result of this operation that are
+    // computed in the same loop nest.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
+    // Insert an allocation for the result of this operation, unless it can be
+    // computed in place.
+    Value alloc = getInPlaceBuffer(op, operands, 0, memRefType);
+    if (!alloc)
+      alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+          memRefType, loc, shapeHelper.getOutputDims(), alignment);
 
     // Only create krnl.iterate if one of the operands is not scalar tensor.
     if (!hasAllScalarValues(operands)) {
-      ValueRange loopDef = create.krnl.defineLoops(memRefType.getRank());
-      SmallVector<IndexExpr, 4> lbs(memRefType.getRank(), LiteralIndexExpr(0));
+      int64_t rank = memRefType.getRank();
+      SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(X, ubs);
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
-          [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-            Value loadedVal = createKrnl.load(X, loopInd);
-            auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
-                rewriter, loc, op, memRefType.getElementType(), {loadedVal});
-            // Store result in the resulting array.
-            createKrnl.store(loweredOpResult, alloc, loopInd);
-          });
+      // Compute vectors of the innermost dimension with SIMD code when
+      // possible, and leave the remaining elements to the scalar code.
+      bool hasScalarElements = true;
+      SmallVector<Value, 4> simdOperands = {X};
+      simdOperands.append(fusion.getFusedOperands().begin(),
+          fusion.getFusedOperands().end());
+      if (int64_t VL = getSIMDVectorLength<ElementwiseUnaryOp>(
+              enableSIMD && fusion.hasSIMDSupport(), memRefType, simdOperands,
+              create.vec))
+        hasScalarElements = emitSIMDLoopNest(rewriter, loc, enableParallel,
+            alloc, simdOperands, VL, lbs, [&](ArrayRef<Value> vectorOperands) {
+              Type vecType = vectorOperands[0].getType();
+              Value result = emitScalarOpFor<ElementwiseUnaryOp>(
+                  rewriter, loc, op, vecType, vectorOperands[0]);
+              return fusion.emitFusedOps(
+                  vecType, result, vectorOperands.drop_front());
+            });
+      // All loops but the innermost one may run in parallel.
+      if (hasScalarElements)
+        iterateIEOptionalParallel(create.krnl, enableParallel,
+            std::max<int64_t>(rank - 1, 1), lbs, ubs,
+            [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+              Value loadedVal = createKrnl.load(X, loopInd);
+              auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
+                  rewriter, loc, op, memRefType.getElementType(), {loadedVal});
+              loweredOpResult = fusion.emitFusedOps(createKrnl, loopInd,
+                  memRefType.getElementType(), loweredOpResult);
+              // Store result in the resulting array.
+              createKrnl.store(loweredOpResult, alloc, loopInd);
+            });
     } else {
       Value loadedVal = create.krnl.load(X);
       auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
           rewriter, loc, op, memRefType.getElementType(), {loadedVal});
+      loweredOpResult = fusion.emitFusedOps(
+          create.krnl, {}, memRefType.getElementType(), loweredOpResult);
       // Store result in the resulting array.
       create.krnl.store(loweredOpResult, alloc);
     }
 
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
     return success();
   }
 };
@@ -892,12 +1293,19 @@ struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
 //===----------------------------------------------------------------------===//
 template <typename ElementwiseBinaryOp>
 struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
+  bool enableSIMD = false;
+  bool enableFusion = false;
+  bool enableParallel = false;
   bool isUniBroadcasting = false;
 
   ONNXElementwiseBinaryOpLowering(TypeConverter &typeConverter,
-      MLIRContext *ctx, bool isUniBroadcasting = false)
+      MLIRContext *ctx, bool enableSIMD, bool enableFusion,
+      bool enableParallel, bool isUniBroadcasting = false)
       : ConversionPattern(
             typeConverter, ElementwiseBinaryOp::getOperationName(), 1, ctx) {
+    this->enableSIMD = enableSIMD;
+    this->enableFusion = enableFusion;
+    this->enableParallel = enableParallel;
     this->isUniBroadcasting = isUniBroadcasting;
   }
 
@@ -919,49 +1327,81 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
     uint64_t outputRank = outputMemRefType.getRank();
 
     // Shape helper.
-    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder> create(
-        rewriter, loc);
+    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder, VectorBuilder>
+        create(rewriter, loc);
     ONNXBroadcastOpShapeHelper shapeHelper(
         op, operands, &create.krnlIE, nullptr, isUniBroadcasting);
     shapeHelper.computeShapeAndAssertOnFailure();
 
-    // Insert an allocation and deallocation for the result of this operation.
-    Value alloc = insertAllocAndDeallocSimple(rewriter, op, outputMemRefType,
-        loc, shapeHelper.getOutputDims(), alignment);
+    // Element-wise ops consuming the result of this operation that are
+    // computed in the same loop nest.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
+    // Insert an allocation and deallocation for the result of this operation,
+    // unless it can be computed in place in an operand. With dynamic shapes,
+    // the operand may be broadcast to the result.
+    Value alloc;
+    if (hasAllConstantDimensions(outputMemRefType))
+      for (int64_t i = 0; i < 2 && !alloc; ++i)
+        alloc = getInPlaceBuffer(op, operands, i, outputMemRefType);
+    if (!alloc)
+      alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+          outputMemRefType, loc, shapeHelper.getOutputDims(), alignment);
 
     // Only create krnl.iterate if one of the operands is not scalar tensor.
     if (!hasAllScalarValues(operands)) {
-      ValueRange loopDef = create.krnl.defineLoops(outputRank);
       SmallVector<IndexExpr, 4> lbs(outputRank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(alloc, ubs);
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
-          [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-            IndexExprScope innerScope(createKrnl, shapeHelper.getScope());
-            SmallVector<IndexExpr, 4> outputAccessExprs;
-            getIndexExprList<DimIndexExpr>(loopInd, outputAccessExprs);
-
-            // Load the first value.
-            SmallVector<IndexExpr, 4> lhsAccessExprs;
-            LogicalResult res = shapeHelper.getAccessExprs(
-                operands[0], 0, outputAccessExprs, lhsAccessExprs);
-            assert(succeeded(res) && "Could not compute access indices");
-            Value lhs = createKrnl.loadIE(operands[0], lhsAccessExprs);
+      // Compute vectors of the innermost dimension with SIMD code when
+      // possible, and leave broadcasts and the remaining elements to the
+      // scalar code.
+      bool hasScalarElements = true;
+      SmallVector<Value, 4> simdOperands(operands.begin(), operands.end());
+      simdOperands.append(fusion.getFusedOperands().begin(),
+          fusion.getFusedOperands().end());
+      if (int64_t VL = getSIMDVectorLength<ElementwiseBinaryOp>(
+              enableSIMD && fusion.hasSIMDSupport(), outputMemRefType,
+              simdOperands, create.vec))
+        hasScalarElements = emitSIMDLoopNest(rewriter, loc, enableParallel,
+            alloc, simdOperands, VL, lbs, [&](ArrayRef<Value> vectorOperands) {
+              Type vecType = vectorOperands[0].getType();
+              Value result = emitScalarOpFor<ElementwiseBinaryOp>(rewriter,
+                  loc, op, vecType, vectorOperands.take_front(2));
+              return fusion.emitFusedOps(
+                  vecType, result, vectorOperands.drop_front(2));
+            });
+      if (hasScalarElements)
+        iterateIEOptionalParallel(create.krnl, enableParallel,
+            std::max<int64_t>(outputRank - 1, 1), lbs, ubs,
+            [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+              IndexExprScope innerScope(createKrnl, shapeHelper.getScope());
+              SmallVector<IndexExpr, 4> outputAccessExprs;
+              getIndexExprList<DimIndexExpr>(loopInd, outputAccessExprs);
+
+              // Load the first value.
+              SmallVector<IndexExpr, 4> lhsAccessExprs;
+              LogicalResult res = shapeHelper.getAccessExprs(
+                  operands[0], 0, outputAccessExprs, lhsAccessExprs);
+              assert(succeeded(res) && "Could not compute access indices");
+              Value lhs = createKrnl.loadIE(operands[0], lhsAccessExprs);
 
-            // Load the second value.
-            SmallVector<IndexExpr, 4> rhsAccessExprs;
-            res = shapeHelper.getAccessExprs(
-                operands[1], 1, outputAccessExprs, rhsAccessExprs);
-            assert(succeeded(res) && "Could not compute access indices");
-            Value rhs = createKrnl.loadIE(operands[1], rhsAccessExprs);
+              // Load the second value.
+              SmallVector<IndexExpr, 4> rhsAccessExprs;
+              res = shapeHelper.getAccessExprs(
+                  operands[1], 1, outputAccessExprs, rhsAccessExprs);
+              assert(succeeded(res) && "Could not compute access indices");
+              Value rhs = createKrnl.loadIE(operands[1], rhsAccessExprs);
 
-            // Apply the element-wise function.
-            Value result = emitScalarOpFor<ElementwiseBinaryOp>(
-                rewriter, loc, op, outputElementType, {lhs, rhs});
+              // Apply the element-wise function.
+              Value result = emitScalarOpFor<ElementwiseBinaryOp>(
+                  rewriter, loc, op, outputElementType, {lhs, rhs});
+              result = fusion.emitFusedOps(
+                  createKrnl, loopInd, outputElementType, result);
 
-            // Store result in the resulting array.
-            createKrnl.store(result, alloc, loopInd);
-          });
+              // Store result in the resulting array.
+              createKrnl.store(result, alloc, loopInd);
+            });
     } else {
       Value lhs = create.krnl.load(operands[0]);
       Value rhs = create.krnl.load(operands[1]);
@@ -969,12 +1409,14 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
       // Apply the element-wise function.
       Value result = emitScalarOpFor<ElementwiseBinaryOp>(
           rewriter, loc, op, outputElementType, {lhs, rhs});
+      result =
+          fusion.emitFusedOps(create.krnl, {}, outputElementType, result);
 
       // Store result in the resulting array.
       create.krnl.store(result, alloc);
     }
 
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
 
     return success();
   }
@@ -984,10 +1426,18 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
 //===----------------------------------------------------------------------===//
 template <typename ElementwiseVariadicOp>
 struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
-  ONNXElementwiseVariadicOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx)
+  bool enableSIMD = false;
+  bool enableFusion = false;
+  bool enableParallel = false;
+
+  ONNXElementwiseVariadicOpLowering(TypeConverter &typeConverter,
+      MLIRContext *ctx, bool enableSIMD, bool enableFusion, bool enableParallel)
       : ConversionPattern(
-            typeConverter, ElementwiseVariadicOp::getOperationName(), 1, ctx) {}
+            typeConverter, ElementwiseVariadicOp::getOperationName(), 1, ctx) {
+    this->enableSIMD = enableSIMD;
+    this->enableFusion = enableFusion;
+    this->enableParallel = enableParallel;
+  }
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     Location loc = NameLoc::get(StringAttr::get(op->getContext(),
@@ -1007,55 +1457,85 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
     uint64_t outputRank = outputMemRefType.getRank();
 
     // Shape helper.
-    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder> create(
-        rewriter, loc);
+    MultiDialectBuilder<IndexExprBuilderForKrnl, KrnlBuilder, VectorBuilder>
+        create(rewriter, loc);
     ONNXBroadcastOpShapeHelper shapeHelper(op, operands, &create.krnlIE);
     shapeHelper.computeShapeAndAssertOnFailure();
 
+    // Element-wise ops consuming the result of this operation that are
+    // computed in the same loop nest.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
     // Insert an allocation and deallocation for the result of this operation.
-    Value alloc = insertAllocAndDeallocSimple(rewriter, op, outputMemRefType,
-        loc, shapeHelper.getOutputDims(), alignment);
+    Value alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+        outputMemRefType, loc, shapeHelper.getOutputDims(), alignment);
 
     // Only create krnl.iterate if one of the operands is not scalar tensor.
     if (!hasAllScalarValues(operands)) {
-      ValueRange loopDef = create.krnl.defineLoops(outputRank);
       SmallVector<IndexExpr, 4> lbs(outputRank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(alloc, ubs);
 
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
-          [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-            IndexExprScope innerScope(createKrnl, shapeHelper.getScope());
-            SmallVector<IndexExpr, 4> outputAccessExprs;
-            getIndexExprList<DimIndexExpr>(loopInd, outputAccessExprs);
-
-            // Fold over operands for each of their scalar values.
-            // Obtain the first operand.
-            SmallVector<IndexExpr, 4> oprdAccessExprs;
-            LogicalResult res = shapeHelper.getAccessExprs(
-                operands[0], 0, outputAccessExprs, oprdAccessExprs);
-            assert(succeeded(res) && "Could not compute access indices");
-            Value accumulated = createKrnl.loadIE(operands[0], oprdAccessExprs);
-
-            // Iterate over the remaining operands.
-            for (unsigned i = 1; i < numArgs; i++) {
-              // Obtain the next operand.
+      // Compute vectors of the innermost dimension with SIMD code when
+      // possible, and leave broadcasts and the remaining elements to the
+      // scalar code.
+      bool hasScalarElements = true;
+      SmallVector<Value, 4> simdOperands(operands.begin(), operands.end());
+      simdOperands.append(fusion.getFusedOperands().begin(),
+          fusion.getFusedOperands().end());
+      if (int64_t VL = getSIMDVectorLength<ElementwiseVariadicOp>(
+              enableSIMD && fusion.hasSIMDSupport(), outputMemRefType,
+              simdOperands, create.vec))
+        hasScalarElements = emitSIMDLoopNest(rewriter, loc, enableParallel,
+            alloc, simdOperands, VL, lbs, [&](ArrayRef<Value> vectorOperands) {
+              Type vecType = vectorOperands[0].getType();
+              Value accumulated = vectorOperands[0];
+              for (unsigned i = 1; i < numArgs; i++)
+                accumulated = emitScalarOpFor<ElementwiseVariadicOp>(rewriter,
+                    loc, op, vecType, {accumulated, vectorOperands[i]});
+              Value result = emitPostProcessingFor<ElementwiseVariadicOp>(
+                  rewriter, loc, op, vecType, accumulated);
+              return fusion.emitFusedOps(
+                  vecType, result, vectorOperands.drop_front(numArgs));
+            });
+      if (hasScalarElements)
+        iterateIEOptionalParallel(create.krnl, enableParallel,
+            std::max<int64_t>(outputRank - 1, 1), lbs, ubs,
+            [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+              IndexExprScope innerScope(createKrnl, shapeHelper.getScope());
+              SmallVector<IndexExpr, 4> outputAccessExprs;
+              getIndexExprList<DimIndexExpr>(loopInd, outputAccessExprs);
+
+              // Fold over operands for each of their scalar values.
+              // Obtain the first operand.
               SmallVector<IndexExpr, 4> oprdAccessExprs;
               LogicalResult res = shapeHelper.getAccessExprs(
-                  operands[i], i, outputAccessExprs, oprdAccessExprs);
+                  operands[0], 0, outputAccessExprs, oprdAccessExprs);
               assert(succeeded(res) && "Could not compute access indices");
-              Value next = createKrnl.loadIE(operands[i], oprdAccessExprs);
-              // Fold.
-              accumulated = emitScalarOpFor<ElementwiseVariadicOp>(
-                  rewriter, loc, op, outputElementType, {accumulated, next});
-            }
-
-            Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
-                rewriter, loc, op, outputElementType, accumulated);
-
-            // Store result in the resulting array.
-            createKrnl.storeIE(finalResult, alloc, outputAccessExprs);
-          });
+              Value accumulated =
+                  createKrnl.loadIE(operands[0], oprdAccessExprs);
+
+              // Iterate over the remaining operands.
+              for (unsigned i = 1; i < numArgs; i++) {
+                // Obtain the next operand.
+                SmallVector<IndexExpr, 4> oprdAccessExprs;
+                LogicalResult res = shapeHelper.getAccessExprs(
+                    operands[i], i, outputAccessExprs, oprdAccessExprs);
+                assert(succeeded(res) && "Could not compute access indices");
+                Value next = createKrnl.loadIE(operands[i], oprdAccessExprs);
+                // Fold.
+                accumulated = emitScalarOpFor<ElementwiseVariadicOp>(
+                    rewriter, loc, op, outputElementType, {accumulated, next});
+              }
+
+              Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
+                  rewriter, loc, op, outputElementType, accumulated);
+              finalResult = fusion.emitFusedOps(
+                  createKrnl, loopInd, outputElementType, finalResult);
+
+              // Store result in the resulting array.
+              createKrnl.storeIE(finalResult, alloc, outputAccessExprs);
+            });
     } else {
       Value accumulated = create.krnl.load(operands[0]);
 
@@ -1069,10 +1549,12 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
       }
       Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
           rewriter, loc, op, outputElementType, accumulated);
+      finalResult = fusion.emitFusedOps(
+          create.krnl, {}, outputElementType, finalResult);
       // Store result in the resulting array.
       create.krnl.store(finalResult, alloc);
     }
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
     return success();
   }
 };
@@ -1081,9 +1563,14 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
 // where op lowering to Krnl dialect.
 //===----------------------------------------------------------------------===//
 struct ONNXWhereOpLowering : public ConversionPattern {
-  ONNXWhereOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  bool enableParallel = false;
+
+  ONNXWhereOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, ONNXWhereOp::getOperationName(), 1, ctx) {}
+            typeConverter, ONNXWhereOp::getOperationName(), 1, ctx) {
+    this->enableParallel = enableParallel;
+  }
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -1111,11 +1598,11 @@ struct ONNXWhereOpLowering : public ConversionPattern {
 
     // Only create krnl.iterate if one of the operands is not scalar tensor.
     if (!hasAllScalarValues(operands)) {
-      ValueRange loopDef = create.krnl.defineLoops(outputRank);
       SmallVector<IndexExpr, 4> lbs(outputRank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(alloc, ubs);
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+      iterateIEOptionalParallel(create.krnl, enableParallel,
+          std::max<int64_t>(outputRank - 1, 1), lbs, ubs,
           [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
             IndexExprScope innerScope(&rewriter, shapeHelper.getScope());
             SmallVector<IndexExpr, 4> outputAccessExprs;
@@ -1175,7 +1662,8 @@ struct ONNXWhereOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXElementwiseOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableSIMD,
+    bool enableFusion, bool enableParallel) {
   patterns.insert<ONNXElementwiseUnaryOpLowering<mlir::ONNXAbsOp>,
       ONNXElementwiseVariadicOpLowering<mlir::ONNXAddOp>,
       ONNXElementwiseVariadicOpLowering<mlir::ONNXAndOp>,
@@ -1226,10 +1714,13 @@ void populateLoweringONNXElementwiseOpPattern(RewritePatternSet &patterns,
       ONNXElementwiseVariadicOpLowering<mlir::ONNXSubOp>,
       ONNXElementwiseVariadicOpLowering<mlir::ONNXSumOp>,
       ONNXElementwiseUnaryOpLowering<mlir::ONNXTanOp>,
-      ONNXElementwiseUnaryOpLowering<mlir::ONNXTanhOp>, ONNXWhereOpLowering,
-      ONNXElementwiseVariadicOpLowering<mlir::ONNXXorOp>>(typeConverter, ctx);
+      ONNXElementwiseUnaryOpLowering<mlir::ONNXTanhOp>,
+      ONNXElementwiseVariadicOpLowering<mlir::ONNXXorOp>>(
+      typeConverter, ctx, enableSIMD, enableFusion, enableParallel);
   patterns.insert<ONNXElementwiseBinaryOpLowering<mlir::ONNXPReluOp>>(
-      typeConverter, ctx, /*isUniBroadcasting=*/true);
+      typeConverter, ctx, enableSIMD, enableFusion, enableParallel,
+      /*isUniBroadcasting=*/true);
+  patterns.insert<ONNXWhereOpLowering>(typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -18,6 +18,7 @@
 #include "src/Dialect/Krnl/DialectBuilder.hpp"
 #include "src/Dialect/Krnl/KrnlHelper.hpp"
 #include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+#include "src/Dialect/ONNX/OnnxElementsAttrBuilder.hpp"
 
 // Used to trace which op are used, good for profiling apps.
 #define DEBUG_TYPE "gemm"
@@ -31,32 +32,192 @@ using namespace mlir;
 
 namespace onnx_mlir {
 
+// Minimum number of rows of A in a cache block, and number of blocks of rows
+// targeted when they are distributed among threads.
+static constexpr int64_t MIN_I_CACHE_TILE = 32;
+static constexpr int64_t PARALLEL_I_BLOCKS = 8;
+
+// Compute GotoBLAS cache blocks from the cache sizes of the target: a
+// iRegTile x kCacheTile micro-panel of A and a kCacheTile x jRegTile
+// micro-panel of B share half of the L1 cache, a iCacheTile x kCacheTile
+// block of A uses half of the L2 cache, and a kCacheTile x jCacheTile panel
+// of B uses half of the L3 cache. Blocks are not larger than the (padded)
+// matrices, and blocks of rows are made small enough to give work to several
+// threads when parallel.
+static void computeCacheTiles(int64_t elementSize, int64_t iRegTile,
+    int64_t jRegTile, IndexExpr I, IndexExpr J, IndexExpr K,
+    bool enableParallel, int64_t &iCacheTile, int64_t &jCacheTile,
+    int64_t &kCacheTile) {
+  auto roundDown = [](int64_t val, int64_t multiple) {
+    return std::max<int64_t>(val / multiple, 1) * multiple;
+  };
+  auto roundUp = [](int64_t val, int64_t multiple) {
+    return ((val + multiple - 1) / multiple) * multiple;
+  };
+  kCacheTile = roundDown(
+      ONNXToKrnl_gL1CacheSize / 2 / ((iRegTile + jRegTile) * elementSize), 8);
+  if (K.isLiteral())
+    kCacheTile = std::min(kCacheTile, roundUp(K.getLiteral(), 8));
+  iCacheTile = roundDown(
+      ONNXToKrnl_gL2CacheSize / 2 / (kCacheTile * elementSize), iRegTile);
+  if (I.isLiteral()) {
+    iCacheTile = std::min(iCacheTile, roundUp(I.getLiteral(), iRegTile));
+    if (enableParallel) {
+      int64_t parallelTile =
+          roundUp((I.getLiteral() + PARALLEL_I_BLOCKS - 1) / PARALLEL_I_BLOCKS,
+              iRegTile);
+      int64_t minTile = roundUp(MIN_I_CACHE_TILE, iRegTile);
+      iCacheTile = std::min(iCacheTile, std::max(parallelTile, minTile));
+    }
+  }
+  jCacheTile = roundDown(
+      ONNXToKrnl_gL3CacheSize / 2 / (kCacheTile * elementSize), jRegTile);
+  if (J.isLiteral())
+    jCacheTile = std::min(jCacheTile, roundUp(J.getLiteral(), jRegTile));
+}
+
+// Pack a constant B (K x J, or J x K when transposed) at compile time into
+// column panels of jCacheTile columns stacked along the rows: rows
+// [jb * K, (jb + 1) * K) hold B[0:K, jb * jCacheTile:(jb + 1) * jCacheTile].
+// Each kCacheTile x jCacheTile block of B is then contiguous, as in the buffer
+// filled by krnl.copy_to_tile_buffer. jCacheTile is reduced to a divisor of J
+// so that all panels are full. Returns nullptr if B is not a constant, or if
+// no multiple of jRegTile up to jCacheTile divides J.
+static Value emitPackedConstantB(ConversionPatternRewriter &rewriter,
+    Location loc, Value B, bool bTrans, int64_t K, int64_t J, int64_t jRegTile,
+    int64_t &jCacheTile) {
+  DenseElementsAttr bElements = getDenseElementAttrFromConstValue(B);
+  if (!bElements)
+    return nullptr;
+  int64_t panelWidth = std::min(jCacheTile, J);
+  while (panelWidth > 0 && J % panelWidth != 0)
+    panelWidth -= jRegTile;
+  if (panelWidth <= 0)
+    return nullptr;
+  jCacheTile = panelWidth;
+  int64_t numPanels = J / panelWidth;
+  // A single panel of a B that is not transposed is B itself.
+  if (!bTrans && numPanels == 1)
+    return B;
+
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  ElementsAttr packed = bElements;
+  if (bTrans)
+    packed = elementsBuilder.transpose(packed, {1, 0});
+  packed = elementsBuilder.reshape(packed, {K, numPanels, panelWidth});
+  packed = elementsBuilder.transpose(packed, {1, 0, 2});
+  packed = elementsBuilder.reshape(packed, {numPanels * K, panelWidth});
+  // Avoid DisposableElementsAttr during conversion.
+  DenseElementsAttr packedElements =
+      elementsBuilder.toDenseElementsAttr(packed);
+  MultiDialectBuilder<KrnlBuilder> create(rewriter, loc);
+  MemRefType packedType = MemRefType::get(
+      {numPanels * K, panelWidth}, bElements.getType().getElementType());
+  return create.krnl.constant(packedType, "packed_", packedElements,
+      /*offset=*/llvm::None, rewriter.getI64IntegerAttr(BUFFER_ALIGN));
+}
+
 template <typename GemmOp>
 struct ONNXGemmOpLowering : public ConversionPattern {
-  ONNXGemmOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+  ONNXGemmOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableTiling, bool enableFusion, bool enableParallel)
       : ConversionPattern(typeConverter, GemmOp::getOperationName(), 1, ctx),
-        enableTiling(enableTiling) {}
+        enableTiling(enableTiling), enableFusion(enableFusion),
+        enableParallel(enableParallel) {}
 
   bool enableTiling;
+  bool enableFusion;
+  bool enableParallel;
 
   void genericGemm(ONNXGemmOp &gemmOp, ONNXGemmOpAdaptor &operandAdaptor,
       Type elementType, ONNXGemmOpShapeHelper &shapeHelper, Value alloc,
       Value zeroVal, Value alphaVal, Value betaVal,
+      const ElementwiseFusionHelper &fusion,
       ConversionPatternRewriter &rewriter, Location loc) const {
     // R is result (alloc).
     Value A(operandAdaptor.A()), B(operandAdaptor.B()), R(alloc);
 
-    // Create all the loops at once (outer loops followed by inner loop).
     MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
         rewriter, loc);
+    IndexExpr outerUb0 = shapeHelper.getOutputDims()[0];
+    IndexExpr outerUb1 = shapeHelper.getOutputDims()[1];
+    IndexExpr innerUb = shapeHelper.aDims[1];
+
+    // Add a*b to the reduction for output (i, j) and reduction index k.
+    auto emitMulAdd = [&](KrnlBuilder &createKrnl, ValueRange outerIndices,
+                          Value k, Value red) {
+      Value i(outerIndices[0]), j(outerIndices[1]);
+      MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+      // Handle transposed accesses.
+      SmallVector<Value, 2> aAccess, bAccess;
+      if (gemmOp.transA() != 0)
+        aAccess = {k, i};
+      else
+        aAccess = {i, k};
+      if (gemmOp.transB() != 0)
+        bAccess = {j, k};
+      else
+        bAccess = {k, j};
+      // Perform the reduction by adding a*b to reduction.
+      Value aVal = create.krnl.load(A, aAccess);
+      Value bVal = create.krnl.load(B, bAccess);
+      Value tmp = create.math.mul(aVal, bVal);
+      Value rVal = create.krnl.load(red);
+      create.krnl.store(create.math.add(tmp, rVal), red);
+    };
+
+    // Store alpha * reduction + beta * C, followed by the fused element-wise
+    // ops, into the result at (i, j).
+    auto emitAlphaBeta = [&](KrnlBuilder &createKrnl, ValueRange outerIndices,
+                             Value red) {
+      MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+      // Handle alpha/beta coefficients.
+      IndexExprScope innerScope(create.krnl, shapeHelper.getScope());
+      Value res = create.math.mul(alphaVal, create.krnl.load(red));
+      if (shapeHelper.hasBias) {
+        SmallVector<Value, 2> cAccess;
+        for (int x = 2 - shapeHelper.cRank; x < 2; ++x) {
+          // If dim > 1, use loop index, otherwise broadcast on 0's element.
+          DimIndexExpr dim(shapeHelper.cDims[x]);
+          cAccess.emplace_back(
+              IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
+                  .getValue());
+        }
+        Value c = create.krnl.load(operandAdaptor.C(), cAccess);
+        res = create.math.add(res, create.math.mul(betaVal, c));
+      }
+      res = fusion.emitFusedOps(create.krnl, outerIndices, elementType, res);
+      create.krnl.store(res, R, outerIndices);
+    };
+
+    // Parallel outer loops, each iteration with its own reduction value.
+    SmallVector<IndexExpr, 2> outerLbs(2, LiteralIndexExpr(0));
+    SmallVector<IndexExpr, 2> outerUbs{outerUb0, outerUb1};
+    int64_t reductionSize =
+        innerUb.isLiteral() ? innerUb.getLiteral() : gMinParallelWorkSize;
+    if (enableParallel &&
+        isParallelLoopNestProfitable(outerLbs, outerUbs, 2, reductionSize)) {
+      iterateIEParallel(create.krnl, 2, outerLbs, outerUbs,
+          [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+            MultiDialectBuilder<KrnlBuilder, MemRefBuilder> create(createKrnl);
+            Value red = create.mem.alloca(MemRefType::get({}, elementType));
+            create.krnl.store(zeroVal, red);
+            ValueRange innerLoopDef = create.krnl.defineLoops(1);
+            create.krnl.iterateIE(innerLoopDef, innerLoopDef,
+                {LiteralIndexExpr(0)}, {innerUb},
+                [&](KrnlBuilder &createKrnl, ValueRange innerIndex) {
+                  emitMulAdd(createKrnl, outerIndices, innerIndex[0], red);
+                });
+            emitAlphaBeta(create.krnl, outerIndices, red);
+          });
+      return;
+    }
+
+    // Create all the loops at once (outer loops followed by inner loop).
     ValueRange loopDef = create.krnl.defineLoops(3);
     SmallVector<Value, 2> outerLoopDef{loopDef[0], loopDef[1]};
     SmallVector<Value, 1> innerLoopDef{loopDef[2]};
     SmallVector<IndexExpr, 3> loopLbs(3, LiteralIndexExpr(0));
-    IndexExpr outerUb0 = shapeHelper.getOutputDims()[0];
-    IndexExpr outerUb1 = shapeHelper.getOutputDims()[1];
-    IndexExpr innerUb = shapeHelper.aDims[1];
     SmallVector<IndexExpr, 3> loopUbs{outerUb0, outerUb1, innerUb};
     // Create temp, single scalar, no need for default alignment.
     Value red = create.mem.alloca(MemRefType::get({}, elementType));
@@ -69,50 +230,17 @@ struct ONNXGemmOpLowering : public ConversionPattern {
           // Inner loop.
           create.krnl.iterate({}, innerLoopDef, {}, {},
               [&](KrnlBuilder &createKrnl, ValueRange innerIndex) {
-                Value i(outerIndices[0]), j(outerIndices[1]), k(innerIndex[0]);
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-                // Handle transposed accesses.
-                SmallVector<Value, 2> aAccess, bAccess;
-                if (gemmOp.transA() != 0)
-                  aAccess = {k, i};
-                else
-                  aAccess = {i, k};
-                if (gemmOp.transB() != 0)
-                  bAccess = {j, k};
-                else
-                  bAccess = {k, j};
-                // Perform the reduction by adding a*b to reduction.
-                Value aVal = create.krnl.load(A, aAccess);
-                Value bVal = create.krnl.load(B, bAccess);
-                Value tmp = create.math.mul(aVal, bVal);
-                Value rVal = create.krnl.load(red);
-                create.krnl.store(create.math.add(tmp, rVal), red);
+                emitMulAdd(createKrnl, outerIndices, innerIndex[0], red);
               });
-          // Handle alpha/beta coefficients.
-          IndexExprScope innerScope(create.krnl, shapeHelper.getScope());
-          Value res = create.math.mul(alphaVal, create.krnl.load(red));
-          if (shapeHelper.hasBias) {
-            SmallVector<Value, 2> cAccess;
-            for (int x = 2 - shapeHelper.cRank; x < 2; ++x) {
-              // If dim > 1, use loop index, otherwise broadcast on 0's element.
-              DimIndexExpr dim(shapeHelper.cDims[x]);
-              cAccess.emplace_back(
-                  IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
-                      .getValue());
-            }
-            Value c = create.krnl.load(operandAdaptor.C(), cAccess);
-            res = create.math.add(res, create.math.mul(betaVal, c));
-          }
-          create.krnl.store(res, R, outerIndices);
+          emitAlphaBeta(create.krnl, outerIndices, red);
         });
   }
 
   void tiledTransposedGemm(ONNXGemmOp &gemmOp,
       ONNXGemmOpAdaptor &operandAdaptor, Type elementType,
       ONNXGemmOpShapeHelper &shapeHelper, Value alloc, Value zeroVal,
-      Value alphaVal, Value betaVal, ConversionPatternRewriter &rewriter,
-      Location loc) const {
+      Value alphaVal, Value betaVal, const ElementwiseFusionHelper &fusion,
+      ConversionPatternRewriter &rewriter, Location loc) const {
 
     // R is result (alloc).
     Value A(operandAdaptor.A()), B(operandAdaptor.B()), R(alloc);
@@ -130,7 +258,7 @@ struct ONNXGemmOpLowering : public ConversionPattern {
 
     // Prepare for the computations.
     // 1) Define blocking, with simdization along the j axis.
-    const int64_t iCacheTile(32), jCacheTile(64), kCacheTile(256);
+    int64_t iCacheTile(32), jCacheTile(64), kCacheTile(256);
     const int64_t iRegTile(4), jRegTile(16);
 
     bool unrollAndJam = DEBUG_UNROLL_OFF ? false : true;
@@ -157,6 +285,33 @@ struct ONNXGemmOpLowering : public ConversionPattern {
         // length.
       }
     }
+    // When the result is not tiled, use cache blocks derived from the cache
+    // sizes, and distribute the blocks of rows among threads.
+    // A constant B is packed at compile time, which removes the copies of its
+    // panels from each inference.
+    bool parallelizeI = false;
+    Value packedB;
+    if (!mustTileR) {
+      computeCacheTiles(getEltSizeInBytes(elementType), iRegTile, jRegTile, I,
+          J, K, enableParallel, iCacheTile, jCacheTile, kCacheTile);
+      parallelizeI = enableParallel &&
+                     (!I.isLiteral() || I.getLiteral() > iCacheTile);
+      if (K.isLiteral() && J.isLiteral())
+        packedB = emitPackedConstantB(rewriter, loc, B, bTrans, K.getLiteral(),
+            J.getLiteral(), jRegTile, jCacheTile);
+      // Each block of rows then packs its own panels of B, which share the L2
+      // cache of its thread with its block of A.
+      if (parallelizeI && !packedB) {
+        int64_t l2Panel = ONNXToKrnl_gL2CacheSize / 2 /
+                          (kCacheTile * getEltSizeInBytes(elementType));
+        jCacheTile = std::min(
+            jCacheTile, std::max<int64_t>(l2Panel / jRegTile, 1) * jRegTile);
+      }
+    }
+    LLVM_DEBUG(llvm::dbgs() << "Gemm: cache tiles I " << iCacheTile << ", J "
+                            << jCacheTile << ", K " << kCacheTile
+                            << (parallelizeI ? ", parallel I" : "")
+                            << (packedB ? ", packed constant B" : "") << "\n");
 
     // 2) Alloc data for tiles.
     MemRefType aTileType =
@@ -164,10 +319,16 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     MemRefType bTileType =
         MemRefType::get({kCacheTile, jCacheTile}, elementType);
     SmallVector<IndexExpr, 1> empty;
-    Value aBuff = insertAllocAndDeallocSimple(
-        rewriter, gemmOp, aTileType, loc, empty, true, BUFFER_ALIGN);
-    Value bBuff = insertAllocAndDeallocSimple(
-        rewriter, gemmOp, bTileType, loc, empty, true, BUFFER_ALIGN);
+    // Each block of rows packs A and B in its own buffers when the rows are
+    // parallel.
+    Value aBuff;
+    if (!parallelizeI)
+      aBuff = insertAllocAndDeallocSimple(
+          rewriter, gemmOp, aTileType, loc, empty, true, BUFFER_ALIGN);
+    Value bBuff;
+    if (!packedB && !parallelizeI)
+      bBuff = insertAllocAndDeallocSimple(
+          rewriter, gemmOp, bTileType, loc, empty, true, BUFFER_ALIGN);
     Value rBuff;
     if (mustTileR)
       rBuff = insertAllocAndDeallocSimple(
@@ -189,9 +350,31 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     ValueRange kCacheBlock = createKrnl.block(kk, kCacheTile);
     Value kk1(kCacheBlock[0]), kk2(kCacheBlock[1]);
 
+    // Return the panel of B holding its block at (k1, j1), with the start of
+    // that block in bStart, packing it in bBuffer unless B was packed at
+    // compile time.
+    auto getBPanel = [&](KrnlBuilder &createKrnl, Value bBuffer, Value k1,
+                         Value j1, SmallVectorImpl<Value> &bStart) -> Value {
+      bStart.assign({k1, j1});
+      if (packedB) {
+        // Row k of panel j1 / jCacheTile is at row k + panel * K.
+        IndexExprScope panelScope(createKrnl);
+        IndexExpr panelStart =
+            DimIndexExpr(j1).floorDiv(jCacheTile) * K.getLiteral();
+        bStart[0] = (LiteralIndexExpr(0) - panelStart).getValue();
+        return packedB;
+      }
+      if (bTrans)
+        createKrnl.copyToBuffer(bBuffer, B, {j1, k1}, zeroVal, true);
+      else
+        createKrnl.copyToBuffer(bBuffer, B, {k1, j1}, zeroVal, false);
+      return bBuffer;
+    };
+
     // If we must tile the result R, then we put I & J in the outermost.
-    // Otherwise, we follow the more traditional scheme of having J & K in the
-    // outermost.
+    // If the blocks of rows are distributed among threads, I is the
+    // outermost. Otherwise, we follow the more traditional scheme of having
+    // J & K in the outermost.
     if (mustTileR) {
       // (cache) ii1 jj1 kk1,    (reg) jj2, ii2,    (matmul) ii3, jj3, kk3
       createKrnl.permute({ii1, ii2, ii3, jj1, jj2, jj3, kk1, kk2},
@@ -229,9 +412,66 @@ struct ONNXGemmOpLowering : public ConversionPattern {
             createKrnl.copyFromBuffer(rBuff, R, {i1, j1});
           });
 
+    } else if (parallelizeI) {
+      // Does not have to tile the result, and the blocks of rows are computed
+      // in parallel:
+      // (cache) ii1 kk1 jj1, (reg) jj2, ii2, (matmul) ii3, jj3, kk3
+      // Each block of rows allocates its buffers once, packs its block of A
+      // once per kk1, and packs the panels of B that it multiplies.
+      createKrnl.permute({ii1, ii2, ii3, jj1, jj2, jj3, kk1, kk2},
+          {/*i*/ 0, 4, 5, /*j*/ 2, 3, 6, /*k*/ 1, 7});
+      createKrnl.parallel(ii1);
+      // Compute: A[i, k] * b[k, j] -> R[i, j])
+      createKrnl.iterateIE({ii, jj, kk}, {ii1}, {zeroIE, zeroIE, zeroIE},
+          {I, J, K}, [&](KrnlBuilder &createKrnl, ValueRange i1_index) {
+            Value i1(i1_index[0]);
+            MemRefBuilder createMem(createKrnl);
+            Value aBlock = createMem.alignedAlloc(aTileType, BUFFER_ALIGN);
+            Value bBlock;
+            if (!packedB)
+              bBlock = createMem.alignedAlloc(bTileType, BUFFER_ALIGN);
+            createKrnl.iterateIE({}, {kk1}, {}, {},
+                [&](KrnlBuilder &createKrnl, ValueRange k1_index) {
+                  Value k1(k1_index[0]);
+                  if (aTrans)
+                    createKrnl.copyToBuffer(aBlock, A, {k1, i1}, zeroVal, true);
+                  else
+                    createKrnl.copyToBuffer(
+                        aBlock, A, {i1, k1}, zeroVal, false);
+                  createKrnl.iterateIE({}, {jj1}, {}, {},
+                      [&](KrnlBuilder &createKrnl, ValueRange j1_index) {
+                        Value j1(j1_index[0]);
+                        SmallVector<Value, 2> bStart;
+                        Value bPanel =
+                            getBPanel(createKrnl, bBlock, k1, j1, bStart);
+                        createKrnl.iterate({}, {jj2, ii2}, {}, {},
+                            [&](KrnlBuilder &createKrnl,
+                                ValueRange j2_i2_indices) {
+                              Value j2(j2_i2_indices[0]),
+                                  i2(j2_i2_indices[1]);
+                              createKrnl.matmul(aBlock, {i1, k1}, bPanel,
+                                  bStart, R, {z, z},
+                                  /*loops*/ {ii3, jj3, kk2},
+                                  /*compute start*/ {i2, j2, k1},
+                                  /*ubs*/
+                                  {I.getValue(), J.getValue(), K.getValue()},
+                                  /*compute tile*/
+                                  {iRegTile, jRegTile, kCacheTile},
+                                  /* a/b/c tiles*/ {}, {}, {}, simdize,
+                                  unrollAndJam, false);
+                            });
+                      });
+                });
+            if (ONNXToKrnl_gEmitDealloc) {
+              createMem.dealloc(aBlock);
+              if (bBlock)
+                createMem.dealloc(bBlock);
+            }
+          });
     } else {
-      // Does not have to tile the result.
+      // Does not have to tile the result. GotoBLAS scheme:
       // (cache) jj1 kk1, ii1, (reg) jj2, ii2, (matmul) ii3, jj3, kk3
+      // A panel of B is packed for all the blocks of rows ii1.
       // Krnl Rule: put all the values in the permute, including the ones that
       // are not iterated over explicitly. All of the same derived (tiled)
       // variable must be consecutive, and different original variables must be
@@ -246,10 +486,8 @@ struct ONNXGemmOpLowering : public ConversionPattern {
       createKrnl.iterateIE({jj, kk, ii}, {jj1, kk1}, {zeroIE, zeroIE, zeroIE},
           {J, K, I}, [&](KrnlBuilder &createKrnl, ValueRange j1_k1_indices) {
             Value j1(j1_k1_indices[0]), k1(j1_k1_indices[1]);
-            if (bTrans)
-              createKrnl.copyToBuffer(bBuff, B, {j1, k1}, zeroVal, true);
-            else
-              createKrnl.copyToBuffer(bBuff, B, {k1, j1}, zeroVal, false);
+            SmallVector<Value, 2> bStart;
+            Value bPanel = getBPanel(createKrnl, bBuff, k1, j1, bStart);
             createKrnl.iterateIE({}, {ii1}, {}, {},
                 [&](KrnlBuilder &createKrnl, ValueRange i1_index) {
                   Value i1(i1_index[0]);
@@ -260,7 +498,7 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                   createKrnl.iterate({}, {jj2, ii2}, {}, {},
                       [&](KrnlBuilder &createKrnl, ValueRange j2_i2_indices) {
                         Value j2(j2_i2_indices[0]), i2(j2_i2_indices[1]);
-                        createKrnl.matmul(aBuff, {i1, k1}, bBuff, {k1, j1}, R,
+                        createKrnl.matmul(aBuff, {i1, k1}, bPanel, bStart, R,
                             {z, z},
                             /*loops*/ {ii3, jj3, kk2},
                             /*compute start*/ {i2, j2, k1},
@@ -273,16 +511,17 @@ struct ONNXGemmOpLowering : public ConversionPattern {
           });
     }
 
-    // Perform the alpha/beta computations.
+    // Perform the alpha/beta computations and the fused element-wise ops in
+    // a single pass over the result.
     float alphaLit = gemmOp.alpha().convertToFloat();
     float betaLit = gemmOp.beta().convertToFloat();
-    if (alphaLit == 1.0 && (betaLit == 0.0 || !shapeHelper.hasBias)) {
+    if (alphaLit == 1.0 && (betaLit == 0.0 || !shapeHelper.hasBias) &&
+        !fusion.hasFusedOps()) {
       // No need for the multiply/add.
       return;
     }
-    ValueRange outerLoops = createKrnl.defineLoops(2);
-    createKrnl.iterateIE(outerLoops, outerLoops, {zeroIE, zeroIE}, {I, J},
-        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+    iterateIEOptionalParallel(createKrnl, enableParallel, 1, {zeroIE, zeroIE},
+        {I, J}, [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
           // Handle alpha/beta coefficients.
           Value res = createKrnl.load(R, outerIndices);
           MathBuilder createMath(createKrnl);
@@ -303,6 +542,7 @@ struct ONNXGemmOpLowering : public ConversionPattern {
               c = createMath.mul(betaVal, c);
             res = createMath.add(res, c);
           }
+          res = fusion.emitFusedOps(createKrnl, outerIndices, elementType, res);
           createKrnl.store(res, R, outerIndices);
         });
   }
@@ -324,10 +564,14 @@ struct ONNXGemmOpLowering : public ConversionPattern {
            "Failed to convert type to MemRefType");
     MemRefType outputMemRefType = convertedType.cast<MemRefType>();
 
+    // Element-wise ops following the Gemm are computed when storing its result.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
     // Insert an allocation and deallocation for the output of this operation.
     Type elementType = outputMemRefType.getElementType();
-    Value alloc = insertAllocAndDeallocSimple(rewriter, op, outputMemRefType,
-        loc, shapeHelper.getOutputDims(), (int64_t)BUFFER_ALIGN);
+    Value alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+        outputMemRefType, loc, shapeHelper.getOutputDims(),
+        (int64_t)BUFFER_ALIGN);
 
     // Get the constants: zero, alpha,and beta.
     float alphaLit = gemmOp.alpha().convertToFloat();
@@ -373,20 +617,21 @@ struct ONNXGemmOpLowering : public ConversionPattern {
 
     if (enableTiling && !DEBUG_OPTIMIZED_OFF) {
       tiledTransposedGemm(gemmOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, alpha, beta, rewriter, loc);
+          alloc, zero, alpha, beta, fusion, rewriter, loc);
     } else {
       genericGemm(gemmOp, operandAdaptor, elementType, shapeHelper, alloc, zero,
-          alpha, beta, rewriter, loc);
+          alpha, beta, fusion, rewriter, loc);
     }
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
     return success();
   }
 };
 
 void populateLoweringONNXGemmOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
+    bool enableFusion, bool enableParallel) {
   patterns.insert<ONNXGemmOpLowering<ONNXGemmOp>>(
-      typeConverter, ctx, enableTiling);
+      typeConverter, ctx, enableTiling, enableFusion, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -29,22 +29,98 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXMatMulOpLowering : public ConversionPattern {
-  ONNXMatMulOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling)
+  ONNXMatMulOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableTiling, bool enableFusion, bool enableParallel)
       : ConversionPattern(
             typeConverter, mlir::ONNXMatMulOp::getOperationName(), 1, ctx),
-        enableTiling(enableTiling) {}
+        enableTiling(enableTiling), enableFusion(enableFusion),
+        enableParallel(enableParallel) {}
   bool enableTiling;
+  bool enableFusion;
+  bool enableParallel;
   // Handle the generic cases, including when there are broadcasts.
   void replaceGenericMatmul(ONNXMatMulOp &matMulOp,
       ONNXMatMulOpAdaptor &operandAdaptor, Type elementType,
       ONNXMatMulOpShapeHelper &shapeHelper, Value alloc, Value fZero,
+      const ElementwiseFusionHelper &fusion,
       ConversionPatternRewriter &rewriter, Location loc) const {
 
     // Define loops and bounds.
     MultiDialectBuilder<KrnlBuilder, MemRefBuilder> create(rewriter, loc);
     int outerLoopNum = shapeHelper.getOutputDims().size();
     int totLoopNum = outerLoopNum + 1; // Add reduction inner loop.
+    int aRank = shapeHelper.aDims.size();
+    int bRank = aRank; // Add for better readability.
+    IndexExpr innerUb = shapeHelper.aDims[aRank - 1];
+
+    // Accumulate A[outer, k] * B[k, outer] into reductionVal.
+    auto emitMulAdd = [&](KrnlBuilder &createKrnl, ValueRange outerIndices,
+                          Value k, Value reductionVal) {
+      MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+      SmallVector<Value, 4> aAccessFct, bAccessFct;
+      for (int i = 0; i < aRank; ++i) {
+        // Add index if dim is not a padded dimension.
+        if (!shapeHelper.aPadDims[i]) {
+          // For A, reduction index is last
+          if (i == aRank - 1) {
+            aAccessFct.emplace_back(k);
+          } else {
+            aAccessFct.emplace_back(outerIndices[i]);
+          }
+        }
+        if (!shapeHelper.bPadDims[i]) {
+          // For B, reduction index is second to last.
+          if (i == bRank - 2) {
+            bAccessFct.emplace_back(k);
+          } else if (i == outerLoopNum) {
+            // When the rank of A 1D, then the output lost one dimension. E,g,
+            // (5) x (10, 5, 4) -> padded (1, 5) x (10, 5, 4) = (10, 1, 4).
+            // But we drop the "1" so its really (10, 4). When processing the
+            // last dim of the reduction (i=2 here), we would normally access
+            // output[2] but it does not exist, because we lost a dim in the
+            // output due to 1D A.
+            bAccessFct.emplace_back(outerIndices[i - 1]);
+          } else {
+            bAccessFct.emplace_back(outerIndices[i]);
+          }
+        }
+      }
+      // Add mat mul operation.
+      Value loadedA = create.krnl.load(operandAdaptor.A(), aAccessFct);
+      Value loadedB = create.krnl.load(operandAdaptor.B(), bAccessFct);
+      Value loadedY = create.krnl.load(reductionVal);
+      Value AB = create.math.mul(loadedA, loadedB);
+      Value accumulated = create.math.add(loadedY, AB);
+      create.krnl.store(accumulated, reductionVal);
+    };
+
+    // Parallel outer loops, each iteration with its own reduction value.
+    SmallVector<IndexExpr, 4> outerLbs(outerLoopNum, LiteralIndexExpr(0));
+    SmallVector<IndexExpr, 4> outerUbs(shapeHelper.getOutputDims());
+    int64_t reductionSize =
+        innerUb.isLiteral() ? innerUb.getLiteral() : gMinParallelWorkSize;
+    if (enableParallel && isParallelLoopNestProfitable(outerLbs, outerUbs,
+                              outerLoopNum, reductionSize)) {
+      iterateIEParallel(create.krnl, outerLoopNum, outerLbs, outerUbs,
+          [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+            MultiDialectBuilder<KrnlBuilder, MemRefBuilder> create(createKrnl);
+            Value reductionVal =
+                create.mem.alignedAlloca(MemRefType::get({}, elementType));
+            create.krnl.store(fZero, reductionVal);
+            ValueRange innerLoop = create.krnl.defineLoops(1);
+            create.krnl.iterateIE(innerLoop, innerLoop, {LiteralIndexExpr(0)},
+                {innerUb}, [&](KrnlBuilder &createKrnl, ValueRange innerIndex) {
+                  emitMulAdd(createKrnl, outerIndices, innerIndex[0],
+                      reductionVal);
+                });
+            Value accumulated = create.krnl.load(reductionVal);
+            accumulated = fusion.emitFusedOps(
+                create.krnl, outerIndices, elementType, accumulated);
+            create.krnl.store(accumulated, alloc, outerIndices);
+          });
+      return;
+    }
+
     ValueRange loopDef = create.krnl.defineLoops(totLoopNum);
     SmallVector<IndexExpr, 4> loopLbs(totLoopNum, LiteralIndexExpr(0));
     SmallVector<IndexExpr, 4> loopUbs; // All getOutputDimss, plus reduction.
@@ -53,9 +129,6 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
       loopUbs.emplace_back(shapeHelper.getOutputDims()[i]);
       outerLoops.emplace_back(loopDef[i]);
     }
-    int aRank = shapeHelper.aDims.size();
-    int bRank = aRank; // Add for better readability.
-    IndexExpr innerUb = shapeHelper.aDims[aRank - 1];
     loopUbs.emplace_back(innerUb);
     SmallVector<Value, 1> innerLoop{loopDef[totLoopNum - 1]}; // Last loop def.
     // Single scalar, no need for default alignment.
@@ -71,53 +144,34 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
           // Inner loop for reduction.
           create.krnl.iterate({}, innerLoop, {}, {},
               [&](KrnlBuilder &createKrnl, ValueRange innerIndex) {
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-                Value k = innerIndex[0];
-                SmallVector<Value, 4> aAccessFct, bAccessFct;
-                for (int i = 0; i < aRank; ++i) {
-                  // Add index if dim is not a padded dimension.
-                  if (!shapeHelper.aPadDims[i]) {
-                    // For A, reduction index is last
-                    if (i == aRank - 1) {
-                      aAccessFct.emplace_back(k);
-                    } else {
-                      aAccessFct.emplace_back(outerIndices[i]);
-                    }
-                  }
-                  if (!shapeHelper.bPadDims[i]) {
-                    // For B, reduction index is second to last.
-                    if (i == bRank - 2) {
-                      bAccessFct.emplace_back(k);
-                    } else if (i == outerLoopNum) {
-                      // When the rank of A 1D, then the output lost one
-                      // dimension. E,g, (5) x (10, 5, 4) -> padded (1, 5) x
-                      // (10, 5, 4) = (10, 1, 4). But we drop the "1" so its
-                      // really (10, 4). When processing the last dim of the
-                      // reduction (i=2 here), we would normally access
-                      // output[2] but it does not exist, because we lost a dim
-                      // in the output due to 1D A.
-                      bAccessFct.emplace_back(outerIndices[i - 1]);
-                    } else {
-                      bAccessFct.emplace_back(outerIndices[i]);
-                    }
-                  }
-                }
-                // Add mat mul operation.
-                Value loadedA =
-                    create.krnl.load(operandAdaptor.A(), aAccessFct);
-                Value loadedB =
-                    create.krnl.load(operandAdaptor.B(), bAccessFct);
-                Value loadedY = create.krnl.load(reductionVal);
-                Value AB = create.math.mul(loadedA, loadedB);
-                Value accumulated = create.math.add(loadedY, AB);
-                create.krnl.store(accumulated, reductionVal);
+                emitMulAdd(createKrnl, outerIndices, innerIndex[0],
+                    reductionVal);
               });
           Value accumulated = create.krnl.load(reductionVal);
+          accumulated = fusion.emitFusedOps(
+              create.krnl, outerIndices, elementType, accumulated);
           create.krnl.store(accumulated, alloc, outerIndices);
         });
   }
 
+  // Apply the fused element-wise ops to the result computed by krnl.matmul,
+  // in a single pass over the output.
+  void emitFusedOpsEpilogue(Type elementType,
+      ONNXMatMulOpShapeHelper &shapeHelper, Value alloc,
+      const ElementwiseFusionHelper &fusion,
+      ConversionPatternRewriter &rewriter, Location loc) const {
+    KrnlBuilder createKrnl(rewriter, loc);
+    int64_t outputRank = shapeHelper.getOutputDims().size();
+    SmallVector<IndexExpr, 4> lbs(outputRank, LiteralIndexExpr(0));
+    SmallVector<IndexExpr, 4> ubs(shapeHelper.getOutputDims());
+    iterateIEOptionalParallel(createKrnl, enableParallel, 1, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          Value res = createKrnl.load(alloc, indices);
+          res = fusion.emitFusedOps(createKrnl, indices, elementType, res);
+          createKrnl.store(res, alloc, indices);
+        });
+  }
+
   void computeTileSizeForMatMatProduct(DimIndexExpr dimI, DimIndexExpr dimJ,
       DimIndexExpr dimK, int64_t &iRegTile, int64_t &jRegTile,
       int64_t &kRegTile, bool &simdize) const {
@@ -228,7 +282,8 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
 
   // Handle the cases with 2x2 matrices both for A, B, and C without
   // broadcast. Implementation here uses the efficient 1d tiling plus kernel
-  // substitution.
+  // substitution. Unlike Gemm, there is no cache blocking with packed panels
+  // and the loops run on one thread.
   void replace2x2Matmul2d(ONNXMatMulOp &matMulOp,
       ONNXMatMulOpAdaptor &operandAdaptor, Type elementType,
       ONNXMatMulOpShapeHelper &shapeHelper, Value alloc, Value zeroVal,
@@ -408,10 +463,14 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
            "Failed to convert type to MemRefType");
     MemRefType outputMemRefType = convertedType.cast<MemRefType>();
 
+    // Element-wise ops following the MatMul are computed when storing its
+    // result.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
     // Insert an allocation and deallocation for the output of this operation.
     Type elementType = outputMemRefType.getElementType();
-    Value alloc = insertAllocAndDeallocSimple(
-        rewriter, op, outputMemRefType, loc, shapeHelper.getOutputDims());
+    Value alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+        outputMemRefType, loc, shapeHelper.getOutputDims());
 
     // Get the constants: zero.
     Value zero = create.math.constant(elementType, 0);
@@ -420,6 +479,7 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
     int aRank = A.getType().cast<MemRefType>().getShape().size();
     int bRank = B.getType().cast<MemRefType>().getShape().size();
     int cRank = alloc.getType().cast<MemRefType>().getShape().size();
+    bool isFusedInStores = false;
     if (enableTiling && aRank == 2 && bRank == 2) {
       // Optimized Matmul only when 2D and allowed to tile and unroll.
       assert(cRank == 2 && "expected IxK * KxJ = IxJ 2D result");
@@ -458,18 +518,26 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
             /*same static broadcast*/ true, alloc, zero, rewriter, loc);
       } else {
         replaceGenericMatmul(matMulOp, operandAdaptor, elementType, shapeHelper,
-            alloc, zero, rewriter, loc);
+            alloc, zero, fusion, rewriter, loc);
+        isFusedInStores = true;
       }
     }
+    // The krnl.matmul kernels accumulate into the output, so the fused ops are
+    // applied once the result is complete.
+    if (!isFusedInStores && fusion.hasFusedOps())
+      emitFusedOpsEpilogue(
+          elementType, shapeHelper, alloc, fusion, rewriter, loc);
     // Done.
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
     return success();
   }
 }; // namespace onnx_mlir
 
 void populateLoweringONNXMatMulOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling) {
-  patterns.insert<ONNXMatMulOpLowering>(typeConverter, ctx, enableTiling);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableTiling,
+    bool enableFusion, bool enableParallel) {
+  patterns.insert<ONNXMatMulOpLowering>(
+      typeConverter, ctx, enableTiling, enableFusion, enableParallel);
 }
 
 } // namespace onnx_mlir
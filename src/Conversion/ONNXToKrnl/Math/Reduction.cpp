@@ -116,14 +116,55 @@ Value emitScalarOpFor<ONNXReduceMinOp>(ConversionPatternRewriter &rewriter,
   return createMath.select(min, lhs, rhs);
 }
 
+// Return the number of leading input dimensions that are not reduced. Loops
+// over these dimensions write to distinct output elements.
+static int64_t getNumLeadingNonReducedDims(
+    int64_t inRank, const std::map<int64_t, int64_t> &outInDimMap) {
+  int64_t num = 0;
+  for (; num < inRank; ++num) {
+    bool found = false;
+    for (auto &outIn : outInDimMap)
+      if (outIn.second == num)
+        found = true;
+    if (!found)
+      break;
+  }
+  return num;
+}
+
+// Emit a parallel loop nest over the input when profitable, parallelizing its
+// `numParallelLoops` leading dimensions. Return false when nothing was emitted.
+static bool tryEmitParallelReduction(ConversionPatternRewriter &rewriter,
+    Location loc, Value input, int64_t numParallelLoops,
+    function_ref<void(ValueRange inLoopIVs)> bodyBuilderFn) {
+  if (numParallelLoops <= 0)
+    return false;
+  MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(
+      rewriter, loc);
+  IndexExprScope parallelScope(&rewriter, loc);
+  int64_t inRank = input.getType().cast<MemRefType>().getRank();
+  SmallVector<IndexExpr, 4> lbs(inRank, LiteralIndexExpr(0));
+  SmallVector<IndexExpr, 4> ubs;
+  create.krnlIE.getShapeAsDims(input, ubs);
+  if (!isParallelLoopNestProfitable(lbs, ubs, numParallelLoops))
+    return false;
+  iterateIEParallel(create.krnl, numParallelLoops, lbs, ubs,
+      [&](KrnlBuilder &createKrnl, ValueRange inLoopIVs) {
+        bodyBuilderFn(inLoopIVs);
+      });
+  return true;
+}
+
 template <typename ONNXReductionOp>
 struct ONNXReductionOpLowering : public ConversionPattern {
+  bool enableParallel = false;
   bool computeMean = false;
 
-  ONNXReductionOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool computeMean = false)
+  ONNXReductionOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableParallel, bool computeMean = false)
       : ConversionPattern(
             typeConverter, ONNXReductionOp::getOperationName(), 1, ctx) {
+    this->enableParallel = enableParallel;
     this->computeMean = computeMean;
   }
 
@@ -255,47 +296,56 @@ struct ONNXReductionOpLowering : public ConversionPattern {
     // 2. Define an Krnl loop to do reduction.
     rewriter.setInsertionPointAfter(iterateOpInit);
     auto ipMainRegion = rewriter.saveInsertionPoint();
-    std::vector<Value> originalLoops;
-    defineLoops(rewriter, loc, originalLoops, inRank);
-    // Iteration information
-    // TODO use new KrnlDialectBuilder.
-    krnl::KrnlIterateOperandPack pack(rewriter, originalLoops);
-    for (decltype(inRank) i = 0; i < inRank; ++i)
-      addDimensionToPack(rewriter, loc, pack, input, i);
+    auto emitReduction = [&](ValueRange inLoopIVs) {
+      SmallVector<Value, 4> outLoopIVs;
+      Value zeroIndex = nullptr;
+      for (decltype(inRank) i = 0; i < outRank; ++i) {
+        if (outInDimMap.find(i) != outInDimMap.end()) {
+          outLoopIVs.push_back(inLoopIVs[outInDimMap[i]]);
+        } else {
+          if (zeroIndex) {
+            outLoopIVs.push_back(zeroIndex);
+          } else {
+            zeroIndex = create.math.constantIndex(0);
+            outLoopIVs.push_back(zeroIndex);
+          }
+        }
+      }
 
-    KrnlIterateOp iterateOp = create.krnl.iterate(pack);
-    Block &iterationBlock = iterateOp.bodyRegion().front();
+      Value next = create.krnl.load(input, inLoopIVs);
+      Value accumulated = create.krnl.load(alloc, outLoopIVs);
+      accumulated = emitScalarOpFor<ONNXReductionOp>(rewriter, loc, op,
+          memRefOutType.getElementType(), {accumulated, next});
+      create.krnl.store(accumulated, alloc, outLoopIVs);
+    };
+
+    if (!enableParallel ||
+        !tryEmitParallelReduction(rewriter, loc, input,
+            getNumLeadingNonReducedDims(inRank, outInDimMap), emitReduction)) {
+      std::vector<Value> originalLoops;
+      defineLoops(rewriter, loc, originalLoops, inRank);
+      // Iteration information
+      // TODO use new KrnlDialectBuilder.
+      krnl::KrnlIterateOperandPack pack(rewriter, originalLoops);
+      for (decltype(inRank) i = 0; i < inRank; ++i)
+        addDimensionToPack(rewriter, loc, pack, input, i);
 
-    // Perform the insertions into the body of the reduction loop.
-    // Insert instructions inside the KernelIterateOp body.
-    rewriter.setInsertionPointToStart(&iterationBlock);
+      KrnlIterateOp iterateOp = create.krnl.iterate(pack);
+      Block &iterationBlock = iterateOp.bodyRegion().front();
 
-    // Handle the operation:
-    SmallVector<Value, 4> inLoopIVs, outLoopIVs;
-    auto args = iterationBlock.getArguments();
-    for (unsigned int i = 0; i < args.size(); ++i) {
-      inLoopIVs.push_back(args[i]);
-    }
-    Value zeroIndex = nullptr;
-    for (decltype(inRank) i = 0; i < outRank; ++i) {
-      if (outInDimMap.find(i) != outInDimMap.end()) {
-        outLoopIVs.push_back(inLoopIVs[outInDimMap[i]]);
-      } else {
-        if (zeroIndex) {
-          outLoopIVs.push_back(zeroIndex);
-        } else {
-          zeroIndex = create.math.constantIndex(0);
-          outLoopIVs.push_back(zeroIndex);
-        }
+      // Perform the insertions into the body of the reduction loop.
+      // Insert instructions inside the KernelIterateOp body.
+      rewriter.setInsertionPointToStart(&iterationBlock);
+
+      // Handle the operation:
+      SmallVector<Value, 4> inLoopIVs;
+      auto args = iterationBlock.getArguments();
+      for (unsigned int i = 0; i < args.size(); ++i) {
+        inLoopIVs.push_back(args[i]);
       }
+      emitReduction(inLoopIVs);
     }
 
-    Value next = create.krnl.load(input, inLoopIVs);
-    Value accumulated = create.krnl.load(alloc, outLoopIVs);
-    accumulated = emitScalarOpFor<ONNXReductionOp>(
-        rewriter, loc, op, memRefOutType.getElementType(), {accumulated, next});
-    create.krnl.store(accumulated, alloc, outLoopIVs);
-
     // 3. Define an Krnl loop to compute mean (optional).
     rewriter.restoreInsertionPoint(ipMainRegion);
     if (computeMean) {
@@ -326,11 +376,11 @@ struct ONNXReductionOpLowering : public ConversionPattern {
         llvm_unreachable("unsupported element type");
 
       // Compute mean
-      ValueRange loopDef = create.krnl.defineLoops(outRank);
       SmallVector<IndexExpr, 4> lbs(outRank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(alloc, ubs);
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+      iterateIEOptionalParallel(create.krnl, enableParallel,
+          std::max<int64_t>(outRank - 1, 1), lbs, ubs,
           [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
             Value loadData = createKrnl.load(alloc, loopInd);
             Value meanVal = create.math.div(loadData, divisor);
@@ -346,13 +396,14 @@ struct ONNXReductionOpLowering : public ConversionPattern {
 // This duplicated code can be eliminated with if constexpr in c++ 17
 // Or onnx uses input for axes for all ops
 struct ONNXReduceSumOpLowering : public ConversionPattern {
+  bool enableParallel = false;
   bool computeMean = false;
 
-  ONNXReduceSumOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool computeMean = false)
+  ONNXReduceSumOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableParallel, bool computeMean = false)
       : ConversionPattern(
             typeConverter, ONNXReduceSumOp::getOperationName(), 1, ctx),
-        computeMean(computeMean) {}
+        enableParallel(enableParallel), computeMean(computeMean) {}
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -591,48 +642,59 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
     // 2. Define an Krnl loop to do reduction.
     rewriter.setInsertionPointAfter(iterateOpInit);
     auto ipMainRegion = rewriter.saveInsertionPoint();
-    std::vector<Value> originalLoops;
-    defineLoops(rewriter, loc, originalLoops, inRank);
-    // Iteration information
-    // TODO use new KrnlDialectBuilder.
-    krnl::KrnlIterateOperandPack pack(rewriter, originalLoops);
-    for (decltype(inRank) i = 0; i < inRank; ++i)
-      addDimensionToPack(rewriter, loc, pack, input, i);
+    auto emitReduction = [&](ValueRange inLoopIVs) {
+      SmallVector<Value, 4> outLoopIVs;
+      // Value zeroIndex = nullptr;
+      Value zeroIndex = create.math.constantIndex(0);
+      for (decltype(inRank) i = 0; i < outRank; ++i) {
+        if (dynamicAxes) {
+          // For the reduced dim, the output index is always 0
+          Value indexVal = create.math.constantIndex(i);
+          Value mask = create.krnl.load(maskVal, indexVal);
+          Value cond = create.math.eq(mask, trueVal);
+          Value dim = create.math.select(cond, zeroIndex, inLoopIVs[i]);
+          outLoopIVs.push_back(dim);
+        } else if (outInDimMap.find(i) != outInDimMap.end())
+          outLoopIVs.push_back(inLoopIVs[outInDimMap[i]]);
+        else
+          outLoopIVs.push_back(zeroIndex);
+      }
 
-    KrnlIterateOp iterateOp = create.krnl.iterate(pack);
-    Block &iterationBlock = iterateOp.bodyRegion().front();
+      Value next = create.krnl.load(input, inLoopIVs);
+      Value accumulated = create.krnl.load(alloc, outLoopIVs);
+      accumulated = emitScalarOpFor<ONNXReduceSumOp>(rewriter, loc, op,
+          memRefOutType.getElementType(), {accumulated, next});
+      create.krnl.store(accumulated, alloc, outLoopIVs);
+    };
+
+    // With dynamic axes, the reduced dimensions are only known at runtime and
+    // the loop nest stays serial.
+    if (!enableParallel || dynamicAxes ||
+        !tryEmitParallelReduction(rewriter, loc, input,
+            getNumLeadingNonReducedDims(inRank, outInDimMap), emitReduction)) {
+      std::vector<Value> originalLoops;
+      defineLoops(rewriter, loc, originalLoops, inRank);
+      // Iteration information
+      // TODO use new KrnlDialectBuilder.
+      krnl::KrnlIterateOperandPack pack(rewriter, originalLoops);
+      for (decltype(inRank) i = 0; i < inRank; ++i)
+        addDimensionToPack(rewriter, loc, pack, input, i);
 
-    // Perform the insertions into the body of the reduction loop.
-    // Insert instructions inside the KernelIterateOp body.
-    rewriter.setInsertionPointToStart(&iterationBlock);
+      KrnlIterateOp iterateOp = create.krnl.iterate(pack);
+      Block &iterationBlock = iterateOp.bodyRegion().front();
 
-    // Handle the operation:
-    SmallVector<Value, 4> inLoopIVs, outLoopIVs;
-    auto args = iterationBlock.getArguments();
-    for (unsigned int i = 0; i < args.size(); ++i) {
-      inLoopIVs.push_back(args[i]);
-    }
-    // Value zeroIndex = nullptr;
-    Value zeroIndex = create.math.constantIndex(0);
-    for (decltype(inRank) i = 0; i < outRank; ++i) {
-      if (dynamicAxes) {
-        // For the reduced dim, the output index is always 0
-        Value indexVal = create.math.constantIndex(i);
-        Value mask = create.krnl.load(maskVal, indexVal);
-        Value cond = create.math.eq(mask, trueVal);
-        Value dim = create.math.select(cond, zeroIndex, inLoopIVs[i]);
-        outLoopIVs.push_back(dim);
-      } else if (outInDimMap.find(i) != outInDimMap.end())
-        outLoopIVs.push_back(inLoopIVs[outInDimMap[i]]);
-      else
-        outLoopIVs.push_back(zeroIndex);
-    }
+      // Perform the insertions into the body of the reduction loop.
+      // Insert instructions inside the KernelIterateOp body.
+      rewriter.setInsertionPointToStart(&iterationBlock);
 
-    Value next = create.krnl.load(input, inLoopIVs);
-    Value accumulated = create.krnl.load(alloc, outLoopIVs);
-    accumulated = emitScalarOpFor<ONNXReduceSumOp>(
-        rewriter, loc, op, memRefOutType.getElementType(), {accumulated, next});
-    create.krnl.store(accumulated, alloc, outLoopIVs);
+      // Handle the operation:
+      SmallVector<Value, 4> inLoopIVs;
+      auto args = iterationBlock.getArguments();
+      for (unsigned int i = 0; i < args.size(); ++i) {
+        inLoopIVs.push_back(args[i]);
+      }
+      emitReduction(inLoopIVs);
+    }
 
     // 3. Define an Krnl loop to compute mean (optional).
     rewriter.restoreInsertionPoint(ipMainRegion);
@@ -663,11 +725,11 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
         llvm_unreachable("unsupported element type");
 
       // Compute mean
-      ValueRange loopDef = create.krnl.defineLoops(outRank);
       SmallVector<IndexExpr, 4> lbs(outRank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(alloc, ubs);
-      create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+      iterateIEOptionalParallel(create.krnl, enableParallel,
+          std::max<int64_t>(outRank - 1, 1), lbs, ubs,
           [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
             Value loadData = createKrnl.load(alloc, loopInd);
             Value meanVal = create.math.div(loadData, divisor);
@@ -681,14 +743,14 @@ struct ONNXReduceSumOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXReductionOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
   patterns.insert<ONNXReductionOpLowering<mlir::ONNXReduceMaxOp>,
       ONNXReductionOpLowering<mlir::ONNXReduceMinOp>,
       ONNXReductionOpLowering<mlir::ONNXReduceProdOp>,
       ONNXReductionOpLowering<mlir::ONNXReduceSumV11Op>,
-      ONNXReduceSumOpLowering>(typeConverter, ctx);
+      ONNXReduceSumOpLowering>(typeConverter, ctx, enableParallel);
   patterns.insert<ONNXReductionOpLowering<mlir::ONNXReduceMeanOp>>(
-      typeConverter, ctx, /*computeMean=*/true);
+      typeConverter, ctx, enableParallel, /*computeMean=*/true);
 }
 
 } // namespace onnx_mlir
@@ -121,17 +121,61 @@ static void emitInnerLoops(KrnlBuilder &createKrnl, int64_t numberOfLoops,
       });
 }
 
+// Return the number of elements processed by the inner loops over dimensions
+// `lb` to `ub` (excluded), assuming a large number for dynamic dimensions.
+static int64_t getInnerLoopsWork(Value input, int64_t lb, int64_t ub) {
+  ArrayRef<int64_t> shape = input.getType().cast<MemRefType>().getShape();
+  int64_t work = 1;
+  for (int64_t i = lb; i < ub; ++i) {
+    if (ShapedType::isDynamic(shape[i]))
+      return gMinParallelWorkSize;
+    work *= shape[i];
+  }
+  return work;
+}
+
+// Emit the outer loops of softmax. When they run in parallel, each iteration
+// allocates its own sum and max accumulators. Otherwise, sum and max
+// accumulators are allocated once and shared by all iterations.
+static void emitOuterLoops(ConversionPatternRewriter &rewriter, Location loc,
+    KrnlBuilder &createKrnl, bool enableParallel, ArrayRef<IndexExpr> outerLbs,
+    ArrayRef<IndexExpr> outerUbs, int64_t workPerIteration,
+    MemRefType scalarMemRefType,
+    function_ref<void(KrnlBuilder &createKrnl, ValueRange outerIndices,
+        Value sumOp, Value maxOp)>
+        bodyBuilderFn) {
+  int64_t numLoops = outerLbs.size();
+  if (enableParallel && isParallelLoopNestProfitable(outerLbs, outerUbs,
+                            numLoops, workPerIteration)) {
+    iterateIEParallel(createKrnl, numLoops, outerLbs, outerUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          MemRefBuilder createMemRef(createKrnl);
+          Value localSumOp = createMemRef.alloca(scalarMemRefType);
+          Value localMaxOp = createMemRef.alloca(scalarMemRefType);
+          bodyBuilderFn(createKrnl, outerIndices, localSumOp, localMaxOp);
+        });
+    return;
+  }
+  Value sumOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
+  Value maxOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
+  ValueRange outerLoops = createKrnl.defineLoops(numLoops);
+  createKrnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
+      [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+        bodyBuilderFn(createKrnl, outerIndices, sumOp, maxOp);
+      });
+}
+
 template <typename T>
 void emitInstForSoftmax(ConversionPatternRewriter &rewriter, Location loc,
-    Value alloc, Value input, Value sumOp, Value maxOp, Value zero,
-    Value negInfinity, int64_t axis) = delete;
+    Value alloc, Value input, MemRefType scalarMemRefType, Value zero,
+    Value negInfinity, int64_t axis, bool enableParallel) = delete;
 
 // For Softmax opset < 13, `axis` is the coerced point. All dimensions
 // after `axis` will be logically coerced into a single dimension.
 template <>
 void emitInstForSoftmax<ONNXSoftmaxV11Op>(ConversionPatternRewriter &rewriter,
-    Location loc, Value alloc, Value input, Value sumOp, Value maxOp,
-    Value zero, Value negInfinity, int64_t axis) {
+    Location loc, Value alloc, Value input, MemRefType scalarMemRefType,
+    Value zero, Value negInfinity, int64_t axis, bool enableParallel) {
   int64_t rank = alloc.getType().cast<MemRefType>().getRank();
 
   MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(
@@ -147,6 +191,9 @@ void emitInstForSoftmax<ONNXSoftmaxV11Op>(ConversionPatternRewriter &rewriter,
   // zero.
   if (axis == 0) {
     // There is no need having outer loops.
+    Value sumOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
+    Value maxOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
+
     // Reset accumulators.
     create.krnl.store(zero, sumOp, ArrayRef<Value>{});
     create.krnl.store(negInfinity, maxOp, ArrayRef<Value>{});
@@ -161,13 +208,14 @@ void emitInstForSoftmax<ONNXSoftmaxV11Op>(ConversionPatternRewriter &rewriter,
         sumOp, maxOp, axis, /*coerced=*/true);
   } else {
     // Define outer loops.
-    ValueRange outerLoops = create.krnl.defineLoops(axis);
     SmallVector<IndexExpr, 4> outerLbs(axis, zeroIE);
     SmallVector<IndexExpr, 4> outerUbs;
     for (int i = 0; i < axis; ++i)
       outerUbs.emplace_back(create.krnlIE.getShapeAsDim(input, i));
-    create.krnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
-        [&](KrnlBuilder &ck, ValueRange outerIndices) {
+    emitOuterLoops(rewriter, loc, create.krnl, enableParallel, outerLbs,
+        outerUbs, getInnerLoopsWork(input, axis, rank), scalarMemRefType,
+        [&](KrnlBuilder &ck, ValueRange outerIndices, Value sumOp,
+            Value maxOp) {
           MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(ck);
           IndexExprScope ieScope(ck);
 
@@ -194,8 +242,8 @@ void emitInstForSoftmax<ONNXSoftmaxV11Op>(ConversionPatternRewriter &rewriter,
 // `axis`.
 template <>
 void emitInstForSoftmax<ONNXSoftmaxOp>(ConversionPatternRewriter &rewriter,
-    Location loc, Value alloc, Value input, Value sumOp, Value maxOp,
-    Value zero, Value negInfinity, int64_t axis) {
+    Location loc, Value alloc, Value input, MemRefType scalarMemRefType,
+    Value zero, Value negInfinity, int64_t axis, bool enableParallel) {
   int64_t rank = alloc.getType().cast<MemRefType>().getRank();
 
   MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(
@@ -204,7 +252,6 @@ void emitInstForSoftmax<ONNXSoftmaxOp>(ConversionPatternRewriter &rewriter,
   LiteralIndexExpr zeroIE(0);
 
   // Outer loops iterate over all dimensions except axis.
-  ValueRange outerLoops = create.krnl.defineLoops(rank - 1);
   SmallVector<IndexExpr, 4> outerLbs(rank - 1, zeroIE);
   SmallVector<IndexExpr, 4> outerUbs;
   for (int i = 0; i < rank; ++i)
@@ -212,8 +259,9 @@ void emitInstForSoftmax<ONNXSoftmaxOp>(ConversionPatternRewriter &rewriter,
       outerUbs.emplace_back(create.krnlIE.getShapeAsDim(input, i));
 
   // Emit outer loops.
-  create.krnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
-      [&](KrnlBuilder &ck, ValueRange outerIndices) {
+  emitOuterLoops(rewriter, loc, create.krnl, enableParallel, outerLbs,
+      outerUbs, getInnerLoopsWork(input, axis, axis + 1), scalarMemRefType,
+      [&](KrnlBuilder &ck, ValueRange outerIndices, Value sumOp, Value maxOp) {
         MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(ck);
         IndexExprScope ieScope(ck);
 
@@ -235,9 +283,14 @@ void emitInstForSoftmax<ONNXSoftmaxOp>(ConversionPatternRewriter &rewriter,
 
 template <typename SoftmaxOp>
 struct ONNXSoftmaxLowering : public ConversionPattern {
-  ONNXSoftmaxLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  bool enableParallel = false;
+
+  ONNXSoftmaxLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, SoftmaxOp::getOperationName(), 1, ctx) {}
+            typeConverter, SoftmaxOp::getOperationName(), 1, ctx) {
+    this->enableParallel = enableParallel;
+  }
   using OpAdaptor = typename SoftmaxOp::Adaptor;
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -270,18 +323,16 @@ struct ONNXSoftmaxLowering : public ConversionPattern {
             : insertAllocAndDealloc(
                   memRefType, loc, rewriter, insertDealloc, input);
 
-    // Insert allocations and deallocations for sum and max.
+    // The sum and max accumulators are allocated with the loops using them.
     MemRefType scalarMemRefType = MemRefType::get({}, elementType, {}, 0);
-    Value sumOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
-    Value maxOp = insertAllocAndDealloc(scalarMemRefType, loc, rewriter, true);
 
     MultiDialectBuilder<MathBuilder> create(rewriter, loc);
     Value zero = create.math.constant(elementType, 0);
     Value negInfinity = create.math.constant(
         elementType, -std::numeric_limits<float>::infinity());
 
-    emitInstForSoftmax<SoftmaxOp>(
-        rewriter, loc, alloc, input, sumOp, maxOp, zero, negInfinity, axis);
+    emitInstForSoftmax<SoftmaxOp>(rewriter, loc, alloc, input,
+        scalarMemRefType, zero, negInfinity, axis, enableParallel);
 
     rewriter.replaceOp(op, alloc);
     return success();
@@ -289,9 +340,10 @@ struct ONNXSoftmaxLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXSoftmaxOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
   patterns.insert<ONNXSoftmaxLowering<ONNXSoftmaxOp>,
-      ONNXSoftmaxLowering<ONNXSoftmaxV11Op>>(typeConverter, ctx);
+      ONNXSoftmaxLowering<ONNXSoftmaxV11Op>>(
+      typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -4,12 +4,15 @@
 
 //===----------------------- TopK.cpp - TopK Op ---------------------------===//
 //
-// Copyright 2021-2022 The IBM Research Authors.
+// Copyright 2021-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
 // This file lowers ONNX TopK operator to Krnl dialect.
 //
+// The indices of the K selected elements are computed by the omTensorTopK
+// runtime function, which selects them without sorting the whole axis.
+//
 //===----------------------------------------------------------------------===//
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
@@ -30,8 +33,8 @@ struct ONNXTopKOpLowering : public ConversionPattern {
     Value X = operandAdaptor.X();
 
     // Builders.
-    MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(
-        rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder>
+        create(rewriter, loc);
 
     // Convert the output type to MemRefType.
     Type convertedType = typeConverter->convertType(*op->result_type_begin());
@@ -68,25 +71,26 @@ struct ONNXTopKOpLowering : public ConversionPattern {
         MemRefType::get(resMemRefType.getShape(), i64Type), loc, resDims,
         insertDealloc);
 
-    // Compute argSort of X along axis.
-    Value argSort = emitArgSort(rewriter, loc, X, axis,
-        /*ascending=*/ascendingMode);
+    // Select the indices of the K first elements along axis, in the order of
+    // the results.
+    Value valAxis = create.math.constant(i64Type, axis);
+    Value valLargest = create.math.constant(i64Type, (int64_t)!ascendingMode);
+    SmallVector<Value, 4> callOperands = {X, valAxis, valLargest};
+    rewriter.create<KrnlCallOp>(
+        loc, "omTensorTopK", resIndexMemRef, callOperands);
 
-    // Produce the final result.
+    // Gather the values of the selected elements.
     SmallVector<IndexExpr> zeroDims(rank, LiteralIndexExpr(0));
     ValueRange loopDef = create.krnl.defineLoops(rank);
     create.krnl.iterateIE(loopDef, loopDef, zeroDims, resDims,
         [&](KrnlBuilder &createKrnl, ValueRange resLoopInd) {
-          Value resInd = createKrnl.load(argSort, resLoopInd);
+          Value resIndI64 = createKrnl.load(resIndexMemRef, resLoopInd);
+          Value resInd = rewriter.create<arith::IndexCastOp>(
+              loc, rewriter.getIndexType(), resIndI64);
           SmallVector<Value> resIndexLoopInd(resLoopInd);
           resIndexLoopInd[axis] = resInd;
-          // Store value.
           Value val = createKrnl.load(X, resIndexLoopInd);
           createKrnl.store(val, resMemRef, resLoopInd);
-          // Store index.
-          Value resIndI64 =
-              rewriter.create<arith::IndexCastOp>(loc, i64Type, resInd);
-          createKrnl.store(resIndI64, resIndexMemRef, resLoopInd);
         });
 
     rewriter.replaceOp(op, {resMemRef, resIndexMemRef});
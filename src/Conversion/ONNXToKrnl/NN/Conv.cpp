@@ -8,32 +8,167 @@
 //
 // =============================================================================
 //
-// This file lowers the ONNX Convolution Operators to Krnl dialect.
+// This file lowers the ONNX Convolution Operators to Krnl dialect, using the
+// direct, im2col, or Winograd algorithm selected by the ConvOpt pass.
 //
 //===----------------------------------------------------------------------===//
 
 //#include "src/Compiler/CompilerOptions.hpp"
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/ONNX/ONNXLayoutHelper.hpp"
+#include "src/Dialect/ONNX/ElementsAttr/ElementsAttrHelper.hpp"
 #include "src/Dialect/ONNX/ONNXOps/ShapeHelper.hpp"
+#include "src/Dialect/ONNX/OnnxElementsAttrBuilder.hpp"
+
+static constexpr int BUFFER_ALIGN = 128;
 
 using namespace mlir;
 
 namespace onnx_mlir {
 
+// Winograd F(m x m, 3 x 3) transforms from Lavin and Gray, "Fast Algorithms
+// for Convolutional Neural Networks", with alpha = m + 2. BT is alpha x alpha,
+// G is alpha x 3, and AT is m x alpha, all row major.
+struct WinogradTransforms {
+  int64_t m;
+  ArrayRef<double> BT, G, AT;
+};
+
+static const double winogradF2x2BT[] = {
+    1, 0, -1, 0, //
+    0, 1, 1, 0,  //
+    0, -1, 1, 0, //
+    0, 1, 0, -1};
+static const double winogradF2x2G[] = {
+    1, 0, 0,        //
+    0.5, 0.5, 0.5,  //
+    0.5, -0.5, 0.5, //
+    0, 0, 1};
+static const double winogradF2x2AT[] = {
+    1, 1, 1, 0, //
+    0, 1, -1, -1};
+static const WinogradTransforms winogradF2x2 = {
+    2, winogradF2x2BT, winogradF2x2G, winogradF2x2AT};
+
+static const double winogradF4x4BT[] = {
+    4, 0, -5, 0, 1, 0,  //
+    0, -4, -4, 1, 1, 0, //
+    0, 4, -4, -1, 1, 0, //
+    0, -2, -1, 2, 1, 0, //
+    0, 2, -1, -2, 1, 0, //
+    0, 4, 0, -5, 0, 1};
+static const double winogradF4x4G[] = {
+    1.0 / 4, 0, 0,                //
+    -1.0 / 6, -1.0 / 6, -1.0 / 6, //
+    -1.0 / 6, 1.0 / 6, -1.0 / 6,  //
+    1.0 / 24, 1.0 / 12, 1.0 / 6,  //
+    1.0 / 24, -1.0 / 12, 1.0 / 6, //
+    0, 0, 1};
+static const double winogradF4x4AT[] = {
+    1, 1, 1, 1, 1, 0,   //
+    0, 1, -1, 2, -2, 0, //
+    0, 1, 1, 4, 4, 0,   //
+    0, 1, -1, 8, -8, 1};
+static const WinogradTransforms winogradF4x4 = {
+    4, winogradF4x4BT, winogradF4x4G, winogradF4x4AT};
+
+// Return coeffs * values * transpose(coeffs), for a constant (rows x cols)
+// matrix of coefficients and a (cols x cols) matrix of values, both row
+// major. No code is generated for zero coefficients, nor multiplications for
+// unit ones.
+static SmallVector<Value, 36> emitWinogradTransform(MathBuilder &createMath,
+    Type elementType, ArrayRef<double> coeffs, int64_t rows, int64_t cols,
+    ArrayRef<Value> values) {
+  // Dot product of row `row` of coeffs with values[offset + k * stride].
+  auto emitDot = [&](int64_t row, ArrayRef<Value> vals, int64_t offset,
+                     int64_t stride) -> Value {
+    Value sum;
+    for (int64_t k = 0; k < cols; ++k) {
+      double coeff = coeffs[row * cols + k];
+      Value val = vals[offset + k * stride];
+      if (coeff == 0.0)
+        continue;
+      if (sum && coeff == 1.0)
+        sum = createMath.add(sum, val);
+      else if (sum && coeff == -1.0)
+        sum = createMath.sub(sum, val);
+      else {
+        Value term = val;
+        if (coeff != 1.0)
+          term = createMath.mul(createMath.constant(elementType, coeff), val);
+        sum = sum ? createMath.add(sum, term) : term;
+      }
+    }
+    return sum ? sum : createMath.constant(elementType, 0);
+  };
+  // tmp = coeffs * values is a (rows x cols) matrix.
+  SmallVector<Value, 36> tmp;
+  for (int64_t i = 0; i < rows; ++i)
+    for (int64_t j = 0; j < cols; ++j)
+      tmp.emplace_back(emitDot(i, values, j, cols));
+  // res = tmp * transpose(coeffs) is a (rows x rows) matrix.
+  SmallVector<Value, 36> res;
+  for (int64_t i = 0; i < rows; ++i)
+    for (int64_t j = 0; j < rows; ++j)
+      res.emplace_back(emitDot(j, tmp, i * cols, 1));
+  return res;
+}
+
+// Compute the Winograd transform U[xi, co, ci] = (G * W[co, ci] * GT)[xi] of a
+// constant CO x CI x 3 x 3 filter at compile time, and emit it as a constant.
+static Value emitTransformedConstantFilter(ConversionPatternRewriter &rewriter,
+    Location loc, DenseElementsAttr filterElements, ArrayRef<double> G,
+    int64_t alpha, int64_t CO, int64_t CI) {
+  ArrayBuffer<WideNum> filter = getElementsWideNums(filterElements);
+  Type elementType = filterElements.getType().getElementType();
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  ElementsAttr transformed = elementsBuilder.fromWideNums(
+      RankedTensorType::get({alpha * alpha, CO, CI}, elementType),
+      [&](MutableArrayRef<WideNum> dst) {
+        for (int64_t co = 0; co < CO; ++co)
+          for (int64_t ci = 0; ci < CI; ++ci) {
+            const WideNum *g = filter.get().data() + (co * CI + ci) * 9;
+            // tmp = G * g is alpha x 3, G * g * GT is alpha x alpha.
+            SmallVector<double, 18> tmp(alpha * 3, 0.0);
+            for (int64_t i = 0; i < alpha; ++i)
+              for (int64_t j = 0; j < 3; ++j)
+                for (int64_t k = 0; k < 3; ++k)
+                  tmp[i * 3 + j] += G[i * 3 + k] * g[k * 3 + j].dbl;
+            for (int64_t i = 0; i < alpha; ++i)
+              for (int64_t j = 0; j < alpha; ++j) {
+                double sum = 0.0;
+                for (int64_t k = 0; k < 3; ++k)
+                  sum += tmp[i * 3 + k] * G[j * 3 + k];
+                dst[((i * alpha + j) * CO + co) * CI + ci] = WideNum(sum);
+              }
+          }
+      });
+  // Avoid DisposableElementsAttr during conversion.
+  DenseElementsAttr transformedElements =
+      elementsBuilder.toDenseElementsAttr(transformed);
+  MultiDialectBuilder<KrnlBuilder> create(rewriter, loc);
+  return create.krnl.constant(
+      MemRefType::get({alpha * alpha, CO, CI}, elementType), "winograd_",
+      transformedElements, /*offset=*/llvm::None,
+      rewriter.getI64IntegerAttr(BUFFER_ALIGN));
+}
+
 struct ONNXConvOpLowering : public ConversionPattern {
-  ONNXConvOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
+  ONNXConvOpLowering(TypeConverter &typeConverter, MLIRContext *ctx,
+      bool enableFusion, bool enableParallel)
       : ConversionPattern(
             typeConverter, mlir::ONNXConvOp::getOperationName(), 1, ctx),
-        enableParallel(enableParallel) {}
+        enableFusion(enableFusion), enableParallel(enableParallel) {}
+  bool enableFusion;
   bool enableParallel;
 
   void convUnoptimized(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
       ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
-      MemRefType &memRefType, Value alloc) const {
+      MemRefType &memRefType, Value alloc,
+      const ElementwiseFusionHelper &fusion) const {
     Location loc = convOp.getLoc();
-    MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, SCFBuilder,
-        MathBuilder, MemRefBuilder>
+    MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder,
+        MemRefBuilder>
         create(rewriter, loc);
     // Spatial data starts from the second dimension.
     int spatialStartIndex = 2;
@@ -68,29 +203,18 @@ struct ONNXConvOpLowering : public ConversionPattern {
 
     // Determine the bounds for the loops over batch & channel out.
     IndexExpr iZero = LiteralIndexExpr(0);
-    IndexExpr iOne = LiteralIndexExpr(1);
 
-    SmallVector<Value, 3> lbsStorage, ubsStorage, stepsStorage;
     SmallVector<IndexExpr, 3> outerLbs = {iZero, iZero, iZero};
     SmallVector<IndexExpr, 3> outerUbs = {N, G, COPerGroup};
-    SmallVector<IndexExpr, 3> outerSteps = {iOne, iOne, iOne};
-    IndexExpr::getValues(outerLbs, lbsStorage);
-    IndexExpr::getValues(outerUbs, ubsStorage);
-    IndexExpr::getValues(outerSteps, stepsStorage);
-    ValueRange parLbs(lbsStorage);
-    ValueRange steps(stepsStorage);
-    ValueRange parUbs(ubsStorage);
     // Iterate over the outer loops
     // for n = 0 .. N:
     //   for g = 0 .. G:
     //     for coPerGroup = 0 .. COPerGroup:
     //       co = g * COPerGroup + coPerGroup;
 
-    // Create a local reduction value.
+    // Type of the local reduction value.
     MemRefType tmpType = MemRefType::get({}, memRefType.getElementType());
-    // Single scalar, no need for default alignment.
-    Value reductionVal = create.mem.alloca(tmpType);
-    auto bodyFunction = [&](ValueRange outerIndices) {
+    auto bodyFunction = [&](ValueRange outerIndices, Value reductionVal) {
       // Compute the Channel In Indices.
       IndexExprScope outerScope(create.krnl);
       // Compute the channel out index "co".
@@ -199,7 +323,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
                 }); // Reduction loops.
                     // Finish the reduction and store in result array.
             Value result = create.krnl.load(reductionVal);
-            // Store the result. Optionally add bias.
+            // Store the result. Optionally add bias, then apply the fused
+            // element-wise ops.
             SymbolIndexExpr coInOutputSpacial(co);
             if (hasBias) {
               Value bias = create.krnl.loadIE(biasOperand, {coInOutputSpacial});
@@ -210,22 +335,453 @@ struct ONNXConvOpLowering : public ConversionPattern {
             resAccessFunc.emplace_back(coInOutputSpacial);
             for (Value o : outputSpatialIndices)
               resAccessFunc.emplace_back(DimIndexExpr(o));
+            if (fusion.hasFusedOps()) {
+              SmallVector<Value, 4> resIndices;
+              IndexExpr::getValues(resAccessFunc, resIndices);
+              result = fusion.emitFusedOps(create.krnl, resIndices,
+                  memRefType.getElementType(), result);
+            }
             create.krnl.storeIE(result, alloc, resAccessFunc);
           }); // Output spacial loops.
     };
 
-    if (enableParallel) {
-      create.scf.parallelLoop(parLbs, parUbs, steps,
-          [&](SCFBuilder &create, ValueRange outerIndices) {
-            bodyFunction(outerIndices);
+    // Work per outer iteration: output pixels times filter elements per group.
+    // Dynamic sizes are assumed large enough.
+    int64_t workPerIteration = 1;
+    bool isDynamicWork = false;
+    for (int i = spatialStartIndex; i < outputRank; ++i) {
+      IndexExpr dim = shapeHelper.getOutputDims()[i];
+      if (dim.isLiteral())
+        workPerIteration *= dim.getLiteral();
+      else
+        isDynamicWork = true;
+    }
+    for (int64_t dim :
+        filterOperand.getType().cast<MemRefType>().getShape().drop_front()) {
+      if (ShapedType::isDynamic(dim))
+        isDynamicWork = true;
+      else
+        workPerIteration *= dim;
+    }
+    if (isDynamicWork)
+      workPerIteration = gMinParallelWorkSize;
+    if (enableParallel && isParallelLoopNestProfitable(
+                              outerLbs, outerUbs, 3, workPerIteration)) {
+      // Each parallel iteration gets its own reduction value.
+      iterateIEParallel(create.krnl, 3, outerLbs, outerUbs,
+          [&](KrnlBuilder &create, ValueRange outerIndices) {
+            MemRefBuilder createMemRef(create);
+            Value reductionVal = createMemRef.alloca(tmpType);
+            bodyFunction(outerIndices, reductionVal);
           });
     } else {
+      // Create a local reduction value.
+      // Single scalar, no need for default alignment.
+      Value reductionVal = create.mem.alloca(tmpType);
       ValueRange outerLoops = create.krnl.defineLoops(3);
       create.krnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
           [&](KrnlBuilder &create, ValueRange outerIndices) {
-            bodyFunction(outerIndices);
+            bodyFunction(outerIndices, reductionVal);
+          });
+    }
+  }
+
+  // Emit C += A * B with the krnl.matmul microkernel, where A is I x K, B is
+  // K x J, and C is I x J. The a/b/cStart indices locate the matrices in their
+  // memrefs, whose leading dimensions index batches of matrices.
+  void emitTiledMatmul(KrnlBuilder &createKrnl, Value A, ValueRange aStart,
+      Value B, ValueRange bStart, Value C, ValueRange cStart, int64_t I,
+      int64_t J, int64_t K) const {
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+    // Register tiles, simdized along j, as for MatMul.
+    int64_t iRegTile = std::min<int64_t>(4, I);
+    int64_t jRegTile = 8;
+    int64_t kRegTile = std::min<int64_t>(8, K);
+    bool simdize = J >= jRegTile;
+    Value zero = create.math.constantIndex(0);
+    Value iUB = create.math.constantIndex(I);
+    Value jUB = create.math.constantIndex(J);
+    Value kUB = create.math.constantIndex(K);
+    ValueRange origLoop = create.krnl.defineLoops(3);
+    Value ii(origLoop[0]), jj(origLoop[1]), kk(origLoop[2]);
+    ValueRange iRegBlock = create.krnl.block(ii, iRegTile);
+    Value ii1(iRegBlock[0]), ii2(iRegBlock[1]);
+    ValueRange jRegBlock = create.krnl.block(jj, jRegTile);
+    Value jj1(jRegBlock[0]), jj2(jRegBlock[1]);
+    ValueRange kRegBlock = create.krnl.block(kk, kRegTile);
+    Value kk1(kRegBlock[0]), kk2(kRegBlock[1]);
+    create.krnl.permute({ii1, ii2, jj1, jj2, kk1, kk2}, {0, 3, 1, 4, 2, 5});
+    create.krnl.iterate({ii, jj, kk}, {ii1, jj1, kk1}, {zero, zero, zero},
+        {iUB, jUB, kUB}, [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          Value i1(indices[0]), j1(indices[1]), k1(indices[2]);
+          createKrnl.matmul(A, aStart, B, bStart, C, cStart, {ii2, jj2, kk2},
+              {i1, j1, k1}, {iUB, jUB, kUB}, {iRegTile, jRegTile, kRegTile},
+              {}, {}, {}, simdize, /*unroll*/ true, /*overcompute*/ false);
+        });
+  }
+
+  // Im2col: for each image and group, gather the input patches into a
+  // [CIPerGroup * KH * KW, HO * WO] matrix (for 2D convolutions) and multiply
+  // it by the [COPerGroup, CIPerGroup * KH * KW] matrix of filters. The bias
+  // and fused element-wise ops are applied in a final pass over the output.
+  void convIm2Col(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType, Value alloc,
+      const ElementwiseFusionHelper &fusion) const {
+    Location loc = convOp.getLoc();
+    MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
+        rewriter, loc);
+    int spatialStartIndex = 2;
+    Value inputOperand = operandAdaptor.X();
+    Value filterOperand = operandAdaptor.W();
+    Value biasOperand = operandAdaptor.B();
+    bool hasBias = !biasOperand.getType().isa<NoneType>();
+    Type elementType = memRefType.getElementType();
+    ArrayRef<int64_t> xShape =
+        inputOperand.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> wShape =
+        filterOperand.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> yShape = memRefType.getShape();
+    int64_t outputRank = yShape.size();
+    int64_t spacialRank = outputRank - spatialStartIndex;
+    int64_t N = yShape[0];
+    int64_t G = convOp.group();
+    int64_t COPerGroup = yShape[1] / G;
+    int64_t CIPerGroup = wShape[1];
+    int64_t kernelSize = 1, outputSize = 1;
+    for (int64_t i = spatialStartIndex; i < outputRank; ++i) {
+      kernelSize *= wShape[i];
+      outputSize *= yShape[i];
+    }
+    int64_t reductionSize = CIPerGroup * kernelSize;
+    Value fZero = create.math.constant(elementType, 0);
+    IndexExpr iZero = LiteralIndexExpr(0);
+
+    // Patch buffer [CIPerGroup, K1, ..., Kr, O1, ..., Or]. Its elements
+    // reading padding are the same for all images and groups, and stay zero.
+    SmallVector<int64_t, 8> colShape = {CIPerGroup};
+    for (int64_t i = spatialStartIndex; i < outputRank; ++i)
+      colShape.emplace_back(wShape[i]);
+    for (int64_t i = spatialStartIndex; i < outputRank; ++i)
+      colShape.emplace_back(yShape[i]);
+    SmallVector<IndexExpr, 1> empty;
+    Value col = insertAllocAndDeallocSimple(rewriter, convOp,
+        MemRefType::get(colShape, elementType), loc, empty, true,
+        BUFFER_ALIGN);
+    create.krnl.memset(col, fZero);
+    create.krnl.memset(alloc, fZero);
+
+    // Matrix views of the patches, filters [G, COPerGroup, CIPerGroup * K],
+    // and output [N, G, COPerGroup, O].
+    SmallVector<IndexExpr, 2> colDims = {
+        LiteralIndexExpr(reductionSize), LiteralIndexExpr(outputSize)};
+    Value colMatrix = create.mem.reinterpretCast(col, colDims);
+    SmallVector<IndexExpr, 3> wDims = {LiteralIndexExpr(G),
+        LiteralIndexExpr(COPerGroup), LiteralIndexExpr(reductionSize)};
+    Value wMatrices = create.mem.reinterpretCast(filterOperand, wDims);
+    SmallVector<IndexExpr, 4> yDims = {LiteralIndexExpr(N),
+        LiteralIndexExpr(G), LiteralIndexExpr(COPerGroup),
+        LiteralIndexExpr(outputSize)};
+    Value yMatrices = create.mem.reinterpretCast(alloc, yDims);
+
+    // for n = 0 .. N:
+    //   for g = 0 .. G:
+    //     gather patches of image n and group g, then multiply.
+    ValueRange outerLoops = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(outerLoops, outerLoops, {iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(G)},
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          Value n(outerIndices[0]), g(outerIndices[1]);
+          // Loops over the channels in and the kernel positions.
+          SmallVector<IndexExpr, 4> kernelLbs(spacialRank + 1, iZero);
+          SmallVector<IndexExpr, 4> kernelUbs = {LiteralIndexExpr(CIPerGroup)};
+          for (int64_t i = spatialStartIndex; i < outputRank; ++i)
+            kernelUbs.emplace_back(LiteralIndexExpr(wShape[i]));
+          iterateIEOptionalParallel(createKrnl, enableParallel, 1,
+              kernelLbs, kernelUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange kernelIndices) {
+                IndexExprScope kernelScope(createKrnl);
+                KrnlBuilder create(createKrnl);
+                // Output positions o reading inside the image at this kernel
+                // position k: 0 <= o * s + k * d - p < I.
+                SmallVector<IndexExpr, 4> outLbs, outUbs, pMinKD;
+                for (int64_t i = 0; i < spacialRank; ++i) {
+                  DimIndexExpr k(kernelIndices[1 + i]);
+                  SymbolIndexExpr p(shapeHelper.pads[i]);
+                  LiteralIndexExpr s(shapeHelper.strides[i]);
+                  LiteralIndexExpr d(shapeHelper.dilations[i]);
+                  LiteralIndexExpr I(xShape[spatialStartIndex + i]);
+                  LiteralIndexExpr O(yShape[spatialStartIndex + i]);
+                  IndexExpr pos = p - (k * d);
+                  outLbs.emplace_back(IndexExpr::max(pos.ceilDiv(s), 0));
+                  outUbs.emplace_back(IndexExpr::min((I + pos).ceilDiv(s), O));
+                  pMinKD.emplace_back(pos);
+                }
+                ValueRange outLoops = create.defineLoops(spacialRank);
+                create.iterateIE(outLoops, outLoops, outLbs, outUbs,
+                    [&](KrnlBuilder &createKrnl, ValueRange outIndices) {
+                      IndexExprScope outScope(createKrnl);
+                      // Input [n, g * CIPerGroup + ci, o * s + k * d - p].
+                      DimIndexExpr ciPerG(kernelIndices[0]);
+                      SmallVector<IndexExpr, 4> inputAccessFct = {
+                          DimIndexExpr(n),
+                          DimIndexExpr(g) * CIPerGroup + ciPerG};
+                      // Patch [ci, k, o].
+                      SmallVector<IndexExpr, 8> colAccessFct = {ciPerG};
+                      for (int64_t i = 0; i < spacialRank; ++i) {
+                        DimIndexExpr o(outIndices[i]);
+                        LiteralIndexExpr s(shapeHelper.strides[i]);
+                        inputAccessFct.emplace_back(
+                            o * s - SymbolIndexExpr(pMinKD[i]));
+                        colAccessFct.emplace_back(
+                            DimIndexExpr(kernelIndices[1 + i]));
+                      }
+                      for (Value o : outIndices)
+                        colAccessFct.emplace_back(DimIndexExpr(o));
+                      Value image =
+                          createKrnl.loadIE(inputOperand, inputAccessFct);
+                      createKrnl.storeIE(image, col, colAccessFct);
+                    });
+              });
+          // Output[n, g] += Filters[g] * Patches.
+          MathBuilder createMath(createKrnl);
+          Value zero = createMath.constantIndex(0);
+          emitTiledMatmul(createKrnl, wMatrices, {g, zero, zero}, colMatrix,
+              {zero, zero}, yMatrices, {n, g, zero, zero}, COPerGroup,
+              outputSize, reductionSize);
+        });
+
+    if (!hasBias && !fusion.hasFusedOps())
+      return;
+    // Add the bias and apply the fused element-wise ops.
+    SmallVector<IndexExpr, 4> lbs(outputRank, iZero);
+    SmallVector<IndexExpr, 4> ubs(shapeHelper.getOutputDims());
+    iterateIEOptionalParallel(create.krnl, enableParallel, 2, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          MathBuilder createMath(createKrnl);
+          Value res = createKrnl.load(alloc, indices);
+          if (hasBias)
+            res = createMath.add(res, createKrnl.load(biasOperand, indices[1]));
+          res = fusion.emitFusedOps(createKrnl, indices, elementType, res);
+          createKrnl.store(res, alloc, indices);
+        });
+  }
+
+  // Winograd F(m x m, 3 x 3) for 2D convolutions without groups, with 3x3
+  // kernels and unit strides and dilations. The output is computed by tiles
+  // of m x m from input tiles of alpha x alpha, alpha = m + 2:
+  //   U[xi, co, ci] = (G * W[co, ci] * GT)[xi]
+  //   V[xi, ci, p] = (BT * input tile p of channel ci * B)[xi]
+  //   M[xi] = U[xi] * V[xi], for each of the alpha^2 positions xi
+  //   output tile p of channel co = AT * M[:, co, p] * A
+  void convWinograd(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType, Value alloc,
+      const ElementwiseFusionHelper &fusion,
+      const WinogradTransforms &transforms) const {
+    Location loc = convOp.getLoc();
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    Value inputOperand = operandAdaptor.X();
+    Value filterOperand = operandAdaptor.W();
+    Value biasOperand = operandAdaptor.B();
+    bool hasBias = !biasOperand.getType().isa<NoneType>();
+    Type elementType = memRefType.getElementType();
+    ArrayRef<int64_t> xShape =
+        inputOperand.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> yShape = memRefType.getShape();
+    int64_t N = yShape[0], CO = yShape[1], HO = yShape[2], WO = yShape[3];
+    int64_t CI = xShape[1], HI = xShape[2], WI = xShape[3];
+    int64_t m = transforms.m;
+    int64_t alpha = m + 2;
+    // Tiles and their total number P.
+    int64_t TH = (HO + m - 1) / m, TW = (WO + m - 1) / m;
+    int64_t P = N * TH * TW;
+    int64_t padTop = shapeHelper.pads[0].getLiteral();
+    int64_t padLeft = shapeHelper.pads[1].getLiteral();
+    Value fZero = create.math.constant(elementType, 0);
+    IndexExpr iZero = LiteralIndexExpr(0);
+    SmallVector<IndexExpr, 1> empty;
+    auto allocBuffer = [&](ArrayRef<int64_t> shape) {
+      return insertAllocAndDeallocSimple(rewriter, convOp,
+          MemRefType::get(shape, elementType), loc, empty, true, BUFFER_ALIGN);
+    };
+
+    // Zero-padded input covering all the tiles.
+    int64_t HP = TH * m + 2, WP = TW * m + 2;
+    assert(HI + padTop <= HP && WI + padLeft <= WP && "unexpected pads");
+    Value paddedInput = allocBuffer({N, CI, HP, WP});
+    create.krnl.memset(paddedInput, fZero);
+    iterateIEOptionalParallel(create.krnl, enableParallel, 2,
+        {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(CI), LiteralIndexExpr(HI),
+            LiteralIndexExpr(WI)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          Value image = createKrnl.load(inputOperand, indices);
+          createKrnl.storeIE(image, paddedInput,
+              {DimIndexExpr(indices[0]), DimIndexExpr(indices[1]),
+                  DimIndexExpr(indices[2]) + padTop,
+                  DimIndexExpr(indices[3]) + padLeft});
+        });
+
+    // Filter transform, computed at compile time for constant filters.
+    Value U;
+    if (DenseElementsAttr filterElements =
+            getDenseElementAttrFromConstValue(filterOperand)) {
+      U = emitTransformedConstantFilter(rewriter, loc, filterElements,
+          transforms.G, alpha, CO, CI);
+    } else {
+      U = allocBuffer({alpha * alpha, CO, CI});
+      iterateIEOptionalParallel(create.krnl, enableParallel, 2, {iZero, iZero},
+          {LiteralIndexExpr(CO), LiteralIndexExpr(CI)},
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+            Value co(indices[0]), ci(indices[1]);
+            SmallVector<Value, 9> filter;
+            for (int64_t kh = 0; kh < 3; ++kh)
+              for (int64_t kw = 0; kw < 3; ++kw)
+                filter.emplace_back(create.krnl.load(filterOperand,
+                    {co, ci, create.math.constantIndex(kh),
+                        create.math.constantIndex(kw)}));
+            SmallVector<Value, 36> transformed = emitWinogradTransform(
+                create.math, elementType, transforms.G, alpha, 3, filter);
+            for (int64_t xi = 0; xi < alpha * alpha; ++xi)
+              create.krnl.store(transformed[xi], U,
+                  {create.math.constantIndex(xi), co, ci});
           });
     }
+
+    // Input transform.
+    Value V = allocBuffer({alpha * alpha, CI, P});
+    iterateIEOptionalParallel(create.krnl, enableParallel, 2,
+        {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(CI), LiteralIndexExpr(TH),
+            LiteralIndexExpr(TW)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          DimIndexExpr n(indices[0]), ci(indices[1]), th(indices[2]),
+              tw(indices[3]);
+          IndexExpr p = (n * TH + th) * TW + tw;
+          SmallVector<Value, 36> tile;
+          for (int64_t i = 0; i < alpha; ++i)
+            for (int64_t j = 0; j < alpha; ++j)
+              tile.emplace_back(create.krnl.loadIE(
+                  paddedInput, {n, ci, th * m + i, tw * m + j}));
+          SmallVector<Value, 36> transformed = emitWinogradTransform(
+              create.math, elementType, transforms.BT, alpha, alpha, tile);
+          for (int64_t xi = 0; xi < alpha * alpha; ++xi)
+            create.krnl.storeIE(
+                transformed[xi], V, {LiteralIndexExpr(xi), ci, p});
+        });
+
+    // Batched matrix multiplications.
+    Value M = allocBuffer({alpha * alpha, CO, P});
+    create.krnl.memset(M, fZero);
+    ValueRange batchLoop = create.krnl.defineLoops(1);
+    create.krnl.iterateIE(batchLoop, batchLoop, {iZero},
+        {LiteralIndexExpr(alpha * alpha)},
+        [&](KrnlBuilder &createKrnl, ValueRange batchIndex) {
+          MathBuilder createMath(createKrnl);
+          Value xi(batchIndex[0]);
+          Value zero = createMath.constantIndex(0);
+          emitTiledMatmul(createKrnl, U, {xi, zero, zero}, V, {xi, zero, zero},
+              M, {xi, zero, zero}, CO, P, CI);
+        });
+
+    // Output transform, then bias and fused element-wise ops. Elements of the
+    // last tiles beyond the output are not stored.
+    iterateIEOptionalParallel(create.krnl, enableParallel, 2,
+        {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(CO), LiteralIndexExpr(TH),
+            LiteralIndexExpr(TW)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
+              createKrnl);
+          DimIndexExpr n(indices[0]), co(indices[1]), th(indices[2]),
+              tw(indices[3]);
+          IndexExpr p = (n * TH + th) * TW + tw;
+          SmallVector<Value, 36> tile;
+          for (int64_t xi = 0; xi < alpha * alpha; ++xi)
+            tile.emplace_back(
+                create.krnl.loadIE(M, {LiteralIndexExpr(xi), co, p}));
+          SmallVector<Value, 36> transformed = emitWinogradTransform(
+              create.math, elementType, transforms.AT, m, alpha, tile);
+          Value bias;
+          if (hasBias)
+            bias = create.krnl.loadIE(biasOperand, {co});
+          for (int64_t i = 0; i < m; ++i) {
+            for (int64_t j = 0; j < m; ++j) {
+              Value res = transformed[i * m + j];
+              if (hasBias)
+                res = create.math.add(res, bias);
+              Value ho = (th * m + i).getValue();
+              Value wo = (tw * m + j).getValue();
+              SmallVector<Value, 4> outputIndices = {
+                  n.getValue(), co.getValue(), ho, wo};
+              auto storeResult = [&](KrnlBuilder &createKrnl) {
+                Value fusedRes = fusion.emitFusedOps(
+                    createKrnl, outputIndices, elementType, res);
+                createKrnl.store(fusedRes, alloc, outputIndices);
+              };
+              // Only the last tiles may be partial.
+              Value inBounds;
+              if (HO % m != 0 && i >= HO % m)
+                inBounds =
+                    create.math.slt(ho, create.math.constantIndex(HO));
+              if (WO % m != 0 && j >= WO % m) {
+                Value wInBounds =
+                    create.math.slt(wo, create.math.constantIndex(WO));
+                inBounds = inBounds ? create.math.andi(inBounds, wInBounds)
+                                    : wInBounds;
+              }
+              if (!inBounds) {
+                storeResult(create.krnl);
+                continue;
+              }
+              create.scf.ifThenElse(inBounds, [&](SCFBuilder &createSCF) {
+                KrnlBuilder createKrnl(createSCF);
+                storeResult(createKrnl);
+              });
+            }
+          }
+        });
+  }
+
+  // Return true if the algorithm selected by the ConvOpt pass can be used:
+  // im2col and Winograd require static shapes and a float element type, and
+  // Winograd further requires 2D convolutions with 3x3 kernels, unit strides
+  // and dilations, and no groups.
+  bool canUseConvAlgorithm(StringRef algorithm, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType) const {
+    if (algorithm == CONV_ALGORITHM_DIRECT)
+      return true;
+    auto xType = operandAdaptor.X().getType().cast<MemRefType>();
+    auto wType = operandAdaptor.W().getType().cast<MemRefType>();
+    if (!xType.hasStaticShape() || !wType.hasStaticShape() ||
+        !memRefType.hasStaticShape() ||
+        !memRefType.getElementType().isa<FloatType>())
+      return false;
+    // Matrix views of the operands and result need the identity layout.
+    if (!xType.getLayout().isIdentity() || !wType.getLayout().isIdentity() ||
+        !memRefType.getLayout().isIdentity())
+      return false;
+    if (!IndexExpr::isLiteral(shapeHelper.pads))
+      return false;
+    if (algorithm == CONV_ALGORITHM_IM2COL)
+      return true;
+    if (algorithm != CONV_ALGORITHM_WINOGRAD_2X2 &&
+        algorithm != CONV_ALGORITHM_WINOGRAD_4X4)
+      return false;
+    if (memRefType.getRank() != 4 || convOp.group() != 1 ||
+        wType.getShape()[2] != 3 || wType.getShape()[3] != 3)
+      return false;
+    for (int i = 0; i < 2; ++i)
+      if (shapeHelper.strides[i] != 1 || shapeHelper.dilations[i] != 1)
+        return false;
+    return true;
   }
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
@@ -245,21 +801,45 @@ struct ONNXConvOpLowering : public ConversionPattern {
            "Failed to convert type to MemRefType");
     MemRefType memRefType = convertedType.cast<MemRefType>();
 
+    // Element-wise ops following the Conv are computed when storing its result.
+    ElementwiseFusionHelper fusion(rewriter, op, enableFusion);
+
     // Insert an allocation and deallocation for the result of this operation.
-    Value alloc = insertAllocAndDeallocSimple(
-        rewriter, op, memRefType, loc, shapeHelper.getOutputDims());
+    Value alloc = insertAllocAndDeallocSimple(rewriter, fusion.getLastOp(),
+        memRefType, loc, shapeHelper.getOutputDims());
+
+    // Algorithm selected by the cost model of the ConvOpt pass, if any.
+    StringRef algorithm = CONV_ALGORITHM_DIRECT;
+    if (auto algorithmAttr =
+            op->getAttrOfType<StringAttr>(CONV_ALGORITHM_ATTR))
+      algorithm = algorithmAttr.getValue();
+    if (!canUseConvAlgorithm(
+            algorithm, convOp, operandAdaptor, shapeHelper, memRefType))
+      algorithm = CONV_ALGORITHM_DIRECT;
 
-    convUnoptimized(
-        rewriter, convOp, operandAdaptor, shapeHelper, memRefType, alloc);
+    if (algorithm == CONV_ALGORITHM_IM2COL)
+      convIm2Col(rewriter, convOp, operandAdaptor, shapeHelper, memRefType,
+          alloc, fusion);
+    else if (algorithm == CONV_ALGORITHM_WINOGRAD_2X2)
+      convWinograd(rewriter, convOp, operandAdaptor, shapeHelper, memRefType,
+          alloc, fusion, winogradF2x2);
+    else if (algorithm == CONV_ALGORITHM_WINOGRAD_4X4)
+      convWinograd(rewriter, convOp, operandAdaptor, shapeHelper, memRefType,
+          alloc, fusion, winogradF4x4);
+    else
+      convUnoptimized(rewriter, convOp, operandAdaptor, shapeHelper,
+          memRefType, alloc, fusion);
 
-    rewriter.replaceOp(op, alloc);
+    fusion.replaceOrEraseONNXOps(alloc);
     return success();
   }
 };
 
 void populateLoweringONNXConvOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
-  patterns.insert<ONNXConvOpLowering>(typeConverter, ctx, enableParallel);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableFusion,
+    bool enableParallel) {
+  patterns.insert<ONNXConvOpLowering>(
+      typeConverter, ctx, enableFusion, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -21,10 +21,12 @@ namespace onnx_mlir {
 struct ONNXBatchNormalizationInferenceModeOpLowering
     : public ConversionPattern {
   ONNXBatchNormalizationInferenceModeOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx)
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(typeConverter,
             mlir::ONNXBatchNormalizationInferenceModeOp::getOperationName(), 1,
-            ctx) {}
+            ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -33,7 +35,8 @@ struct ONNXBatchNormalizationInferenceModeOpLowering
     ONNXBatchNormalizationInferenceModeOpAdaptor operandAdaptor(operands);
     Location loc = op->getLoc();
 
-    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder>
+        create(rewriter, loc);
 
     // Convert the output type to MemRefType.
     Type convertedType = typeConverter->convertType(*op->result_type_begin());
@@ -69,6 +72,40 @@ struct ONNXBatchNormalizationInferenceModeOpLowering
     // rank
     int64_t rank = memRefType.getRank();
 
+    // When parallel, iterate over all dimensions at once and reload the
+    // per-channel values in the body. All loops but the innermost one may run
+    // in parallel.
+    if (enableParallel) {
+      IndexExprScope parallelScope(&rewriter, loc);
+      SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
+      SmallVector<IndexExpr, 4> ubs;
+      create.krnlIE.getShapeAsDims(operand, ubs);
+      int64_t numParallelLoops = std::max<int64_t>(rank - 1, 1);
+      if (isParallelLoopNestProfitable(lbs, ubs, numParallelLoops)) {
+        iterateIEParallel(create.krnl, numParallelLoops, lbs, ubs,
+            [&](KrnlBuilder &createKrnl, ValueRange loopIVs) {
+              MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+              Value c = (rank > 1) ? loopIVs[1] : create.math.constantIndex(0);
+              Value scaleVal = create.krnl.load(scale, {c});
+              Value biasVal = create.krnl.load(bias, {c});
+              Value meanVal = create.krnl.load(mean, {c});
+              Value varianceVal = create.krnl.load(variance, {c});
+              Value xVal = create.krnl.load(operand, loopIVs);
+              // normalize
+              Value dividend = create.math.sub(xVal, meanVal);
+              Value adjustedVarianceVal = create.math.add(varianceVal, epsilon);
+              Value divisor = create.math.sqrt(adjustedVarianceVal);
+              Value normVal = create.math.div(dividend, divisor);
+              // scale and shift
+              Value scaleNormVal = create.math.mul(scaleVal, normVal);
+              Value shiftScaleNormVal = create.math.add(scaleNormVal, biasVal);
+              create.krnl.store(shiftScaleNormVal, alloc, loopIVs);
+            });
+        rewriter.replaceOp(op, alloc);
+        return success();
+      }
+    }
+
     std::vector<Value> originalLoops;
     defineLoops(rewriter, loc, originalLoops, rank);
 
@@ -144,9 +181,11 @@ struct ONNXBatchNormalizationInferenceModeOpLowering
 
 struct ONNXInstanceNormalizationOpLowering : public ConversionPattern {
   ONNXInstanceNormalizationOpLowering(
-      TypeConverter &typeConverter, MLIRContext *ctx)
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(typeConverter,
-            mlir::ONNXInstanceNormalizationOp::getOperationName(), 1, ctx) {}
+            mlir::ONNXInstanceNormalizationOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -189,7 +228,6 @@ struct ONNXInstanceNormalizationOpLowering : public ConversionPattern {
     create.krnlIE.getShapeAsSymbols(inputMemRef, inputBounds);
     MemRefType tmpType = MemRefType::get({}, elementType);
     Value fZero = create.math.constant(elementType, 0);
-    Value tmpMemRef = create.mem.alloca(tmpType);
 
     // Compute the number of values in a single channel: product of spatial
     // dimensions, converted to float.
@@ -201,93 +239,116 @@ struct ONNXInstanceNormalizationOpLowering : public ConversionPattern {
 
     // Iterate over the batch and channels.
     LiteralIndexExpr iZero(0);
-    ValueRange n_c_loopDef = create.krnl.defineLoops(2);
-    create.krnl.iterateIE(n_c_loopDef, n_c_loopDef, {iZero, iZero},
-        {inputBounds[0], inputBounds[1]},
-        [&](KrnlBuilder &ck, ValueRange n_c_loopInd) {
-          MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
-              ck);
-          IndexExprScope channelScope(ck);
-          DimIndexExpr n(n_c_loopInd[0]), c(n_c_loopInd[1]);
-
-          // Set bounds for iterating over values in channel.
-          ValueRange spatial_loopDef = create.krnl.defineLoops(rank - 2);
-          SmallVector<IndexExpr, 4> lbs(rank - 2, iZero);
-          SmallVector<IndexExpr, 4> ubs;
-          for (int d = 2; d < rank; ++d)
-            ubs.emplace_back(SymbolIndexExpr(inputBounds[d]));
-
-          // First compute the mean: store zero in reduction value, then sum up
-          // all of the values in the channel, and divide by the number of
-          // values.
-          create.krnl.store(fZero, tmpMemRef, {});
-          // Iterate over kernel and add values.
-          ValueRange spatial2_loopDef = create.krnl.defineLoops(rank - 2);
-          create.krnl.iterateIE(spatial2_loopDef, spatial2_loopDef, lbs, ubs,
-              [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-                SmallVector<Value, 6> inputAccessFct = {
-                    n.getValue(), c.getValue()};
-                for (int d = 0; d < rank - 2; ++d)
-                  inputAccessFct.emplace_back(spatial_loopInd[d]);
-                // tmp += input[n,c, spatial dims]
-                Value oldSum = create.krnl.load(tmpMemRef, {});
-                Value val = create.krnl.load(inputMemRef, inputAccessFct);
-                Value newSum = create.math.add(oldSum, val);
-                create.krnl.store(newSum, tmpMemRef);
-              });
-          Value sum = create.krnl.load(tmpMemRef);
-          Value mean = create.math.div(sum, meanDenom);
-          // Second, compute the standard dev: sum of (val - mean)2 / (num-1).
-          create.krnl.store(fZero, tmpMemRef, {});
-          // Iterate over kernel and add values.
-          create.krnl.iterateIE(spatial_loopDef, spatial_loopDef, lbs, ubs,
-              [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-                SmallVector<Value, 6> inputAccessFct = {
-                    n.getValue(), c.getValue()};
-                for (int d = 0; d < rank - 2; ++d)
-                  inputAccessFct.emplace_back(spatial_loopInd[d]);
-                // tmp += input[n,c, spatial dims]
-                Value oldSum = create.krnl.load(tmpMemRef, {});
-                Value val = create.krnl.load(inputMemRef, inputAccessFct);
-                val = create.math.sub(val, mean);
-                val = create.math.mul(val, val);
-                Value newSum = create.math.add(oldSum, val);
-                create.krnl.store(newSum, tmpMemRef);
-              });
-          sum = create.krnl.load(tmpMemRef);
-          // Variance is numerically off when divided by (num -1), but
-          // passes the tests when divided by num, so keep that.
-          Value variance = create.math.div(sum, meanDenom);
-
-          // Calculate ahead the scale[c] / sqrt(var + epsilon)
-          Value denom = create.math.add(variance, epsilon);
-          denom = create.math.sqrt(denom);
-          Value nom = create.krnl.load(scaleMemRef, {c.getValue()});
-          Value factor = create.math.div(nom, denom);
-          Value term = create.krnl.load(biasMemRef, {c.getValue()});
-
-          // Iterate over all channel values and compute y = factor * (x - mean)
-          // + term.
-          ValueRange spatial3_loopDef = create.krnl.defineLoops(rank - 2);
-          create.krnl.iterateIE(spatial3_loopDef, spatial3_loopDef, lbs, ubs,
-              [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-                SmallVector<Value, 6> accessFct = {n.getValue(), c.getValue()};
-                for (int d = 0; d < rank - 2; ++d)
-                  accessFct.emplace_back(spatial_loopInd[d]);
-                // tmp += input[n,c, spatial dims]
-                Value x = create.krnl.load(inputMemRef, accessFct);
-                Value val = create.math.sub(x, mean);
-                val = create.math.mul(factor, val);
-                val = create.math.add(val, term);
-                create.krnl.store(val, resMemRef, accessFct);
-              });
-        }); // For all batches, channels.
+    auto bodyFunction = [&](KrnlBuilder &ck, ValueRange n_c_loopInd,
+                            Value tmpMemRef) {
+      MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
+          ck);
+      IndexExprScope channelScope(ck);
+      DimIndexExpr n(n_c_loopInd[0]), c(n_c_loopInd[1]);
+
+      // Set bounds for iterating over values in channel.
+      ValueRange spatial_loopDef = create.krnl.defineLoops(rank - 2);
+      SmallVector<IndexExpr, 4> lbs(rank - 2, iZero);
+      SmallVector<IndexExpr, 4> ubs;
+      for (int d = 2; d < rank; ++d)
+        ubs.emplace_back(SymbolIndexExpr(inputBounds[d]));
+
+      // First compute the mean: store zero in reduction value, then sum up
+      // all of the values in the channel, and divide by the number of
+      // values.
+      create.krnl.store(fZero, tmpMemRef, {});
+      // Iterate over kernel and add values.
+      ValueRange spatial2_loopDef = create.krnl.defineLoops(rank - 2);
+      create.krnl.iterateIE(spatial2_loopDef, spatial2_loopDef, lbs, ubs,
+          [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                createKrnl);
+            SmallVector<Value, 6> inputAccessFct = {
+                n.getValue(), c.getValue()};
+            for (int d = 0; d < rank - 2; ++d)
+              inputAccessFct.emplace_back(spatial_loopInd[d]);
+            // tmp += input[n,c, spatial dims]
+            Value oldSum = create.krnl.load(tmpMemRef, {});
+            Value val = create.krnl.load(inputMemRef, inputAccessFct);
+            Value newSum = create.math.add(oldSum, val);
+            create.krnl.store(newSum, tmpMemRef);
+          });
+      Value sum = create.krnl.load(tmpMemRef);
+      Value mean = create.math.div(sum, meanDenom);
+      // Second, compute the standard dev: sum of (val - mean)2 / (num-1).
+      create.krnl.store(fZero, tmpMemRef, {});
+      // Iterate over kernel and add values.
+      create.krnl.iterateIE(spatial_loopDef, spatial_loopDef, lbs, ubs,
+          [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                createKrnl);
+            SmallVector<Value, 6> inputAccessFct = {
+                n.getValue(), c.getValue()};
+            for (int d = 0; d < rank - 2; ++d)
+              inputAccessFct.emplace_back(spatial_loopInd[d]);
+            // tmp += input[n,c, spatial dims]
+            Value oldSum = create.krnl.load(tmpMemRef, {});
+            Value val = create.krnl.load(inputMemRef, inputAccessFct);
+            val = create.math.sub(val, mean);
+            val = create.math.mul(val, val);
+            Value newSum = create.math.add(oldSum, val);
+            create.krnl.store(newSum, tmpMemRef);
+          });
+      sum = create.krnl.load(tmpMemRef);
+      // Variance is numerically off when divided by (num -1), but
+      // passes the tests when divided by num, so keep that.
+      Value variance = create.math.div(sum, meanDenom);
+
+      // Calculate ahead the scale[c] / sqrt(var + epsilon)
+      Value denom = create.math.add(variance, epsilon);
+      denom = create.math.sqrt(denom);
+      Value nom = create.krnl.load(scaleMemRef, {c.getValue()});
+      Value factor = create.math.div(nom, denom);
+      Value term = create.krnl.load(biasMemRef, {c.getValue()});
+
+      // Iterate over all channel values and compute y = factor * (x - mean)
+      // + term.
+      ValueRange spatial3_loopDef = create.krnl.defineLoops(rank - 2);
+      create.krnl.iterateIE(spatial3_loopDef, spatial3_loopDef, lbs, ubs,
+          [&](KrnlBuilder &createKrnl, ValueRange spatial_loopInd) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                createKrnl);
+            SmallVector<Value, 6> accessFct = {n.getValue(), c.getValue()};
+            for (int d = 0; d < rank - 2; ++d)
+              accessFct.emplace_back(spatial_loopInd[d]);
+            // tmp += input[n,c, spatial dims]
+            Value x = create.krnl.load(inputMemRef, accessFct);
+            Value val = create.math.sub(x, mean);
+            val = create.math.mul(factor, val);
+            val = create.math.add(val, term);
+            create.krnl.store(val, resMemRef, accessFct);
+          });
+    };
+
+    // Each parallel iteration uses its own reduction value.
+    SmallVector<IndexExpr, 2> n_c_lbs = {iZero, iZero};
+    SmallVector<IndexExpr, 2> n_c_ubs = {inputBounds[0], inputBounds[1]};
+    int64_t channelWork = 1;
+    for (int d = 2; d < rank; ++d)
+      channelWork *=
+          inputBounds[d].isLiteral() ? inputBounds[d].getLiteral() : 1;
+    if (enableParallel &&
+        isParallelLoopNestProfitable(n_c_lbs, n_c_ubs, 2, channelWork)) {
+      iterateIEParallel(create.krnl, 2, n_c_lbs, n_c_ubs,
+          [&](KrnlBuilder &ck, ValueRange n_c_loopInd) {
+            MemRefBuilder createMemRef(ck);
+            Value tmpMemRef = createMemRef.alloca(tmpType);
+            bodyFunction(ck, n_c_loopInd, tmpMemRef);
+          });
+    } else {
+      Value tmpMemRef = create.mem.alloca(tmpType);
+      ValueRange n_c_loopDef = create.krnl.defineLoops(2);
+      create.krnl.iterateIE(n_c_loopDef, n_c_loopDef, {iZero, iZero},
+          {inputBounds[0], inputBounds[1]},
+          [&](KrnlBuilder &ck, ValueRange n_c_loopInd) {
+            bodyFunction(ck, n_c_loopInd, tmpMemRef);
+          }); // For all batches, channels.
+    }
 
     rewriter.replaceOp(op, resMemRef);
     return success();
@@ -295,10 +356,11 @@ struct ONNXInstanceNormalizationOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXNormalizationOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
   patterns.insert<ONNXBatchNormalizationInferenceModeOpLowering>(
-      typeConverter, ctx);
-  patterns.insert<ONNXInstanceNormalizationOpLowering>(typeConverter, ctx);
+      typeConverter, ctx, enableParallel);
+  patterns.insert<ONNXInstanceNormalizationOpLowering>(
+      typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
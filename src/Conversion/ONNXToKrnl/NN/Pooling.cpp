@@ -197,8 +197,11 @@ void postProcessPoolingWindow<ONNXAveragePoolOp>(
 //
 template <typename PoolOp, typename PoolOpAdaptor, typename PoolOpShapeHelper>
 struct ONNXPoolOpLowering : public ConversionPattern {
-  ONNXPoolOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
-      : ConversionPattern(typeConverter, PoolOp::getOperationName(), 1, ctx) {}
+  ONNXPoolOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
+      : ConversionPattern(typeConverter, PoolOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -323,176 +326,203 @@ struct ONNXPoolOpLowering : public ConversionPattern {
 
     // Identity value of the operation.
     auto identity = getIdentityValue<PoolOp>(rewriter, loc, outputElementType);
-    // Create a local reduction value for output[n][c][ho][wo].
-    // Single scalar, no need for default alignment.
-    Value reductionVal =
-        create.mem.alloca(MemRefType::get({}, memRefType.getElementType()));
+    // Type of the local reduction value for output[n][c][ho][wo].
+    MemRefType reductionType = MemRefType::get({}, memRefType.getElementType());
 
     // 1. Define output loops to compute one output pixel.
     // for n in range(N):
     //   for c in range(C):
     //     for ho in range(HO):
     //       for wo in range(WO):
-    ValueRange calcLoopDef = create.krnl.defineLoops(outputShape.size());
     SmallVector<IndexExpr, 4> lbs(outputShape.size(), LiteralIndexExpr(0));
     SmallVector<IndexExpr, 4> ubs;
-    create.krnlIE.getShapeAsDims(alloc, ubs);
-    create.krnl.iterateIE(calcLoopDef, calcLoopDef, lbs, ubs,
-        [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-          MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl,
-              MemRefBuilder, MathBuilder>
-              create(createKrnl);
-
-          // 2. Emit the body of the output loop nest, which applies a pooling
-          // window to a region in the input, producing one output pixel.
-          SmallVector<IndexExpr, 4> outputIndices;
-          for (unsigned int i = 0; i < outputShape.size(); ++i)
-            outputIndices.emplace_back(DimIndexExpr(loopInd[i]));
-
-          // 2.1 Emit: output[n][c][ho][wo] = identity
-          create.krnl.store(identity, reductionVal);
-
-          // 2.2 Emit affine maps which express the lower and upper bounds for
-          // the pooling window's dimensions. The pooling window can be
-          // smaller than the kernel when slicing it over the border edges.
-          // Thus, we will compute the start and end indices for each
-          // dimension as follows.
-          //   firstValidH = ceil(float(ptH / dH)) * dH - ptH
-          //   startH = max(firstValidH, ho * sH - ptH)
-          //   endH = min(H, ho * sH + (kH - 1) * dH  + 1 - pbH)
-          //   hDim = round(float(endH - startH) / float(dH))
-
-          // Prepare induction variables.
-          SmallVector<SmallVector<IndexExpr, 4>, 4> IVExprs;
-          for (int i = 0; i < kernelShapeSize; ++i) {
-            int j = i + kernelOffset;
-            SmallVector<IndexExpr, 4> ic;
-            // d0, output
-            ic.emplace_back(outputIndices[j]);
-            // s0, input dim
-            ic.emplace_back(create.krnlIE.getShapeAsDim(inputOperand, j));
-            // s1, kernel dim
-            ic.emplace_back(SymbolIndexExpr(shapeHelper.kernelShape[i]));
-            // s2, pad dim
-            ic.emplace_back(SymbolIndexExpr(shapeHelper.pads[i]));
-            // s3, stride dim
-            ic.emplace_back(LiteralIndexExpr(shapeHelper.strides[i]));
-            // s4, dilation dim
-            ic.emplace_back(LiteralIndexExpr(shapeHelper.dilations[i]));
-            IVExprs.emplace_back(ic);
-          }
-
-          // Compute the start and end position of the conv window.
-          //   firstValidH = ceil(float(ptH / dH)) * dH - ptH
-          //   startH = max(firstValidH, ho * sH - ptH)
-          //   endH = min(H, ho * sH + (kH - 1) * dH  + 1 - pbH)
-          SmallVector<IndexExpr, 4> windowStartExprs, windowEndExprs;
-          for (int i = 0; i < kernelShapeSize; ++i) {
-            std::vector<IndexExpr> exprs =
-                getIndexExprsForConvWindow(IVExprs[i], ceilMode, isDilated);
-            windowStartExprs.emplace_back(exprs[0]);
-            windowEndExprs.emplace_back(exprs[1]);
+    auto bodyFunction = [&](KrnlBuilder &createKrnl, ValueRange loopInd,
+                            Value reductionVal) {
+      MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl,
+          MemRefBuilder, MathBuilder>
+          create(createKrnl);
+
+      // 2. Emit the body of the output loop nest, which applies a pooling
+      // window to a region in the input, producing one output pixel.
+      SmallVector<IndexExpr, 4> outputIndices;
+      for (unsigned int i = 0; i < outputShape.size(); ++i)
+        outputIndices.emplace_back(DimIndexExpr(loopInd[i]));
+
+      // 2.1 Emit: output[n][c][ho][wo] = identity
+      create.krnl.store(identity, reductionVal);
+
+      // 2.2 Emit affine maps which express the lower and upper bounds for
+      // the pooling window's dimensions. The pooling window can be
+      // smaller than the kernel when slicing it over the border edges.
+      // Thus, we will compute the start and end indices for each
+      // dimension as follows.
+      //   firstValidH = ceil(float(ptH / dH)) * dH - ptH
+      //   startH = max(firstValidH, ho * sH - ptH)
+      //   endH = min(H, ho * sH + (kH - 1) * dH  + 1 - pbH)
+      //   hDim = round(float(endH - startH) / float(dH))
+
+      // Prepare induction variables.
+      SmallVector<SmallVector<IndexExpr, 4>, 4> IVExprs;
+      for (int i = 0; i < kernelShapeSize; ++i) {
+        int j = i + kernelOffset;
+        SmallVector<IndexExpr, 4> ic;
+        // d0, output
+        ic.emplace_back(outputIndices[j]);
+        // s0, input dim
+        ic.emplace_back(create.krnlIE.getShapeAsDim(inputOperand, j));
+        // s1, kernel dim
+        ic.emplace_back(SymbolIndexExpr(shapeHelper.kernelShape[i]));
+        // s2, pad dim
+        ic.emplace_back(SymbolIndexExpr(shapeHelper.pads[i]));
+        // s3, stride dim
+        ic.emplace_back(LiteralIndexExpr(shapeHelper.strides[i]));
+        // s4, dilation dim
+        ic.emplace_back(LiteralIndexExpr(shapeHelper.dilations[i]));
+        IVExprs.emplace_back(ic);
+      }
+
+      // Compute the start and end position of the conv window.
+      //   firstValidH = ceil(float(ptH / dH)) * dH - ptH
+      //   startH = max(firstValidH, ho * sH - ptH)
+      //   endH = min(H, ho * sH + (kH - 1) * dH  + 1 - pbH)
+      SmallVector<IndexExpr, 4> windowStartExprs, windowEndExprs;
+      for (int i = 0; i < kernelShapeSize; ++i) {
+        std::vector<IndexExpr> exprs =
+            getIndexExprsForConvWindow(IVExprs[i], ceilMode, isDilated);
+        windowStartExprs.emplace_back(exprs[0]);
+        windowEndExprs.emplace_back(exprs[1]);
+      }
+
+      // Compute the size of the full conv window.
+      //   hDim = round(float(endH - startH) / float(dH))
+      //   wDim = round(float(endW - startW) / float(dW))
+      SmallVector<Value, 4> fullWindowSize;
+      for (int i = 0; i < kernelShapeSize; ++i) {
+        Value dim = create.math.sub(
+            windowEndExprs[i].getValue(), windowStartExprs[i].getValue());
+        if (isDilated) {
+          Value one = create.math.constantIndex(1);
+          Value numerator = create.math.add(dim, one);
+          Value denominator = IVExprs[i][5].getValue(); // dilations[i]
+          dim = create.math.div(numerator, denominator);
+          if (ceilMode) {
+            auto remainder = rewriter.create<arith::RemSIOp>(
+                loc, numerator, denominator);
+            Value zero = create.math.constantIndex(0);
+            Value isZero = create.math.eq(remainder, zero);
+            Value dimPlusOne = create.math.add(dim, one);
+            dim = create.math.select(isZero, dim, dimPlusOne);
           }
-
-          // Compute the size of the full conv window.
-          //   hDim = round(float(endH - startH) / float(dH))
-          //   wDim = round(float(endW - startW) / float(dW))
-          SmallVector<Value, 4> fullWindowSize;
-          for (int i = 0; i < kernelShapeSize; ++i) {
-            Value dim = create.math.sub(
-                windowEndExprs[i].getValue(), windowStartExprs[i].getValue());
+        }
+        fullWindowSize.emplace_back(dim);
+      }
+
+      // 2.3 Define pooling loops.
+      //  for hp in range(hDim):
+      //    for wp in range(wDim):
+      //      hi = hp * dH + startH
+      //      wi = wp * dW + startW
+      //      output[n][c][ho][wo] =
+      //        emitScalarOpFor(output[n][c][ho][wo], input[n, c, hi,
+      //        wi]);
+
+      // Old style krnl loop generation, do not reuse this pattern.
+      std::vector<Value> poolingLoops;
+      defineLoops(rewriter, loc, poolingLoops, kernelShapeSize);
+      krnl::KrnlIterateOperandPack pack(rewriter, poolingLoops);
+
+      // Push bounds.
+      AffineMap windowSizeMap =
+          getWindowAffineMap(rewriter, ceilMode, isDilated);
+      for (int i = 0; i < kernelShapeSize; ++i) {
+        // Affine map's operands.
+        SmallVector<Value, 4> operands;
+        for (IndexExpr expr : IVExprs[i])
+          operands.emplace_back(expr.getValue());
+        pack.pushConstantBound(0);
+        pack.pushAffineMapBound(windowSizeMap, operands);
+      }
+      KrnlIterateOp iterateOp = create.krnl.iterate(pack);
+      auto ipOuterLoopRegion = rewriter.saveInsertionPoint();
+      Block &iterationBlock = iterateOp.bodyRegion().front();
+      rewriter.setInsertionPointToStart(&iterationBlock);
+      SmallVector<Value, 4> poolingLoopInd(
+          iterationBlock.getArguments().begin(),
+          iterationBlock.getArguments().end());
+
+      {
+        // 2.4 Emit the body of the pooling loop nest.
+        // Prepare indices to access a pixel in the input.
+        SmallVector<IndexExpr, 4> inputIndices;
+        { // Construct inputIndices
+          for (int i = 0; i < kernelOffset; ++i)
+            inputIndices.emplace_back(outputIndices[i]);
+          for (int i = kernelOffset; i < (int)inputShape.size(); ++i) {
+            int j = i - kernelOffset;
+            DimIndexExpr hp(poolingLoopInd[j]);
+            IndexExpr startH = windowStartExprs[j];
             if (isDilated) {
-              Value one = create.math.constantIndex(1);
-              Value numerator = create.math.add(dim, one);
-              Value denominator = IVExprs[i][5].getValue(); // dilations[i]
-              dim = create.math.div(numerator, denominator);
-              if (ceilMode) {
-                auto remainder = rewriter.create<arith::RemSIOp>(
-                    loc, numerator, denominator);
-                Value zero = create.math.constantIndex(0);
-                Value isZero = create.math.eq(remainder, zero);
-                Value dimPlusOne = create.math.add(dim, one);
-                dim = create.math.select(isZero, dim, dimPlusOne);
-              }
+              // hi = hp * dH + startH
+              IndexExpr dH = IVExprs[j][5];
+              inputIndices.emplace_back(hp * dH + startH);
+            } else {
+              // hi = hp + startH
+              inputIndices.emplace_back(hp + startH);
             }
-            fullWindowSize.emplace_back(dim);
           }
+        }
+
+        // Apply pooling operation.
+        //      output[n][c][ho][wo] =
+        //        emitScalarOpFor(output[n][c][ho][wo], input[n, c, hi,
+        //        wi]);
+        Value loadInput = create.krnl.loadIE(inputOperand, inputIndices);
+        Value loadPartialOutput = create.krnl.load(reductionVal);
+        Value output = emitScalarOpFor<PoolOp>(rewriter, loc, op,
+            outputElementType, {loadPartialOutput, loadInput});
+        create.krnl.store(output, reductionVal);
+      }
+      rewriter.restoreInsertionPoint(ipOuterLoopRegion);
+      Value output = createKrnl.load(reductionVal);
+      create.krnl.storeIE(output, alloc, outputIndices);
+
+      // 2.5 Post-processing for the pooling window, e.g. taking average.
+      SmallVector<Value, 4> outputIndicesInValue;
+      for (IndexExpr expr : outputIndices)
+        outputIndicesInValue.emplace_back(expr.getValue());
+      postProcessPoolingWindow<PoolOp>(rewriter, loc, poolOp, alloc,
+          outputIndicesInValue, shapeHelper.kernelShape, fullWindowSize);
+    };
+
+    // Run the loops over the leading non-spatial dimensions (e.g. batch and
+    // channel) in parallel. Each parallel iteration uses its own reduction
+    // value.
+    int64_t kernelWork = 1;
+    for (IndexExpr k : shapeHelper.kernelShape)
+      kernelWork *= k.isLiteral() ? k.getLiteral() : 1;
+    if (enableParallel && kernelOffset > 0) {
+      create.krnlIE.getShapeAsDims(alloc, ubs);
+      if (isParallelLoopNestProfitable(lbs, ubs, kernelOffset, kernelWork)) {
+        iterateIEParallel(create.krnl, kernelOffset, lbs, ubs,
+            [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+              MemRefBuilder createMemRef(createKrnl);
+              Value reductionVal = createMemRef.alloca(reductionType);
+              bodyFunction(createKrnl, loopInd, reductionVal);
+            });
+        rewriter.replaceOp(op, alloc);
+        return success();
+      }
+      ubs.clear();
+    }
 
-          // 2.3 Define pooling loops.
-          //  for hp in range(hDim):
-          //    for wp in range(wDim):
-          //      hi = hp * dH + startH
-          //      wi = wp * dW + startW
-          //      output[n][c][ho][wo] =
-          //        emitScalarOpFor(output[n][c][ho][wo], input[n, c, hi,
-          //        wi]);
-
-          // Old style krnl loop generation, do not reuse this pattern.
-          std::vector<Value> poolingLoops;
-          defineLoops(rewriter, loc, poolingLoops, kernelShapeSize);
-          krnl::KrnlIterateOperandPack pack(rewriter, poolingLoops);
-
-          // Push bounds.
-          AffineMap windowSizeMap =
-              getWindowAffineMap(rewriter, ceilMode, isDilated);
-          for (int i = 0; i < kernelShapeSize; ++i) {
-            // Affine map's operands.
-            SmallVector<Value, 4> operands;
-            for (IndexExpr expr : IVExprs[i])
-              operands.emplace_back(expr.getValue());
-            pack.pushConstantBound(0);
-            pack.pushAffineMapBound(windowSizeMap, operands);
-          }
-          KrnlIterateOp iterateOp = create.krnl.iterate(pack);
-          auto ipOuterLoopRegion = rewriter.saveInsertionPoint();
-          Block &iterationBlock = iterateOp.bodyRegion().front();
-          rewriter.setInsertionPointToStart(&iterationBlock);
-          SmallVector<Value, 4> poolingLoopInd(
-              iterationBlock.getArguments().begin(),
-              iterationBlock.getArguments().end());
-
-          {
-            // 2.4 Emit the body of the pooling loop nest.
-            // Prepare indices to access a pixel in the input.
-            SmallVector<IndexExpr, 4> inputIndices;
-            { // Construct inputIndices
-              for (int i = 0; i < kernelOffset; ++i)
-                inputIndices.emplace_back(outputIndices[i]);
-              for (int i = kernelOffset; i < (int)inputShape.size(); ++i) {
-                int j = i - kernelOffset;
-                DimIndexExpr hp(poolingLoopInd[j]);
-                IndexExpr startH = windowStartExprs[j];
-                if (isDilated) {
-                  // hi = hp * dH + startH
-                  IndexExpr dH = IVExprs[j][5];
-                  inputIndices.emplace_back(hp * dH + startH);
-                } else {
-                  // hi = hp + startH
-                  inputIndices.emplace_back(hp + startH);
-                }
-              }
-            }
-
-            // Apply pooling operation.
-            //      output[n][c][ho][wo] =
-            //        emitScalarOpFor(output[n][c][ho][wo], input[n, c, hi,
-            //        wi]);
-            Value loadInput = create.krnl.loadIE(inputOperand, inputIndices);
-            Value loadPartialOutput = create.krnl.load(reductionVal);
-            Value output = emitScalarOpFor<PoolOp>(rewriter, loc, op,
-                outputElementType, {loadPartialOutput, loadInput});
-            create.krnl.store(output, reductionVal);
-          }
-          rewriter.restoreInsertionPoint(ipOuterLoopRegion);
-          Value output = createKrnl.load(reductionVal);
-          create.krnl.storeIE(output, alloc, outputIndices);
-
-          // 2.5 Post-processing for the pooling window, e.g. taking average.
-          SmallVector<Value, 4> outputIndicesInValue;
-          for (IndexExpr expr : outputIndices)
-            outputIndicesInValue.emplace_back(expr.getValue());
-          postProcessPoolingWindow<PoolOp>(rewriter, loc, poolOp, alloc,
-              outputIndicesInValue, shapeHelper.kernelShape, fullWindowSize);
+    // Create a local reduction value for output[n][c][ho][wo].
+    // Single scalar, no need for default alignment.
+    Value reductionVal = create.mem.alloca(reductionType);
+    ValueRange calcLoopDef = create.krnl.defineLoops(outputShape.size());
+    create.krnlIE.getShapeAsDims(alloc, ubs);
+    create.krnl.iterateIE(calcLoopDef, calcLoopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
+          bodyFunction(createKrnl, loopInd, reductionVal);
         });
 
     rewriter.replaceOp(op, alloc);
@@ -502,13 +532,13 @@ struct ONNXPoolOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXPoolingOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
   patterns.insert<ONNXPoolOpLowering<ONNXMaxPoolSingleOutOp,
       ONNXMaxPoolSingleOutOpAdaptor, ONNXMaxPoolSingleOutOpShapeHelper>>(
-      typeConverter, ctx);
+      typeConverter, ctx, enableParallel);
   patterns.insert<ONNXPoolOpLowering<ONNXAveragePoolOp,
       ONNXAveragePoolOpAdaptor, ONNXAveragePoolOpShapeHelper>>(
-      typeConverter, ctx);
+      typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
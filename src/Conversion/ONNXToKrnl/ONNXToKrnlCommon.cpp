@@ -21,6 +21,10 @@
 #include "src/Dialect/ONNX/OnnxElementsAttrBuilder.hpp"
 
 bool ONNXToKrnl_gEmitDealloc = false;
+bool ONNXToKrnl_gEnableInPlace = false;
+int64_t ONNXToKrnl_gL1CacheSize = 32 * 1024;
+int64_t ONNXToKrnl_gL2CacheSize = 1024 * 1024;
+int64_t ONNXToKrnl_gL3CacheSize = 8 * 1024 * 1024;
 
 using namespace mlir;
 
@@ -327,7 +331,6 @@ Value getDimOrConstant(ConversionPatternRewriter &rewriter, Location loc,
              : create.math.constant(type, shape[axis]);
 }
 
-namespace {
 // Returns the DenseElementsAttr of input if it's a krnl.global constant or
 // onnx.Constant, or if it's one step removed from a krnl/onnx constant by a
 // builtin.unrealized_conversion_cast. Otherwise returns a nullptr attribute.
@@ -347,7 +350,6 @@ DenseElementsAttr getDenseElementAttrFromConstValue(mlir::Value value) {
   }
   return nullptr;
 }
-} // namespace
 
 /// Emit an ONNXSqueezeV11Op. If the input is constant, do const propagation,
 /// and return a constant.
@@ -474,89 +476,6 @@ Value emitMemRefReinterpretCastOp(ConversionPatternRewriter &rewriter,
   return newView;
 }
 
-/// Emit krnl iterate to compute argsort of a given MemRef along a given axis.
-/// Output MemRef has the same shape as the input MemRef but is of IndexType.
-/// By default, sort values in the descending order.
-Value emitArgSort(ConversionPatternRewriter &rewriter, Location loc,
-    Value input, int64_t axis, bool ascending) {
-  MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder> create(
-      rewriter, loc);
-  IndexExprScope scope(create.krnl);
-
-  MemRefType inputMemRefType = input.getType().cast<MemRefType>();
-  Type indexType = rewriter.getIndexType();
-  int64_t rank = inputMemRefType.getRank();
-  assert(axis >= 0 && axis < rank && "axis is out of bound");
-  LiteralIndexExpr zeroIE(0), oneIE(1);
-
-  SmallVector<IndexExpr, 4> lbs(rank, zeroIE);
-  SmallVector<IndexExpr, 4> ubs;
-  create.krnlIE.getShapeAsDims(input, ubs);
-
-  // Create and initialize the result.
-  Value order = insertAllocAndDeallocSimple(rewriter, nullptr,
-      MemRefType::get(inputMemRefType.getShape(), indexType), loc, ubs,
-      /*insertDealloc=*/true);
-  ValueRange initLoopDef = create.krnl.defineLoops(rank);
-  create.krnl.iterateIE(initLoopDef, initLoopDef, lbs, ubs,
-      [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-        // order[axis_0, axis_1, ..., axis_k-1, k, axis_k+1, ....] = k
-        createKrnl.store(loopInd[axis], order, loopInd);
-      });
-
-  // Do sorting in the specifed order of input and return their indices.
-  if ((rank <= 6) && (axis == (rank - 1))) {
-    // Emit krnl.Call to call omTensorSort API
-    Type intType = rewriter.getIntegerType(64);
-    Value valAxis = create.math.constant(intType, axis);
-    Value valAscending = create.math.constant(intType, (int64_t)ascending);
-    SmallVector<Value, 4> operands = {input, valAxis, valAscending};
-    rewriter.create<KrnlCallOp>(loc, "omTensorSort", order, operands);
-    return order;
-  }
-  // Do sorting in the descending order of input and return their indices.
-  // Using bubble sort.
-  SmallVector<IndexExpr, 4> outerUbs(ubs);
-  outerUbs[axis] = ubs[axis] - oneIE;
-  ValueRange loopDef = create.krnl.defineLoops(rank);
-  create.krnl.iterateIE(loopDef, loopDef, lbs, outerUbs,
-      [&](KrnlBuilder &createKrnl, ValueRange iLoopInd) {
-        IndexExpr i1 = DimIndexExpr(iLoopInd[axis]) + oneIE;
-        ValueRange swapLoopDef = createKrnl.defineLoops(1);
-        createKrnl.iterateIE(swapLoopDef, swapLoopDef, {i1}, {ubs[axis]},
-            [&](KrnlBuilder &ck, ValueRange swapLoopInd) {
-              MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
-                  ck);
-              SmallVector<Value> kLoopInd(iLoopInd);
-              kLoopInd[axis] = swapLoopInd[0];
-              // Load current indices.
-              Value iOrd = create.krnl.load(order, iLoopInd);
-              Value kOrd = create.krnl.load(order, kLoopInd);
-              // Load x.
-              SmallVector<Value> xLoopInd(iLoopInd);
-              xLoopInd[axis] = iOrd;
-              Value x = create.krnl.load(input, xLoopInd);
-              // Load y.
-              SmallVector<Value> yLoopInd(iLoopInd);
-              yLoopInd[axis] = kOrd;
-              Value y = create.krnl.load(input, yLoopInd);
-              // Compare values and swap indices.
-              Value cond;
-              if (ascending)
-                cond = create.math.sgt(x, y);
-              else
-                cond = create.math.slt(x, y);
-              create.scf.ifThenElse(cond, [&](SCFBuilder &createSCF) {
-                KrnlBuilder createKrnl(createSCF);
-                createKrnl.store(kOrd, order, iLoopInd);
-                createKrnl.store(iOrd, order, kLoopInd);
-              });
-            });
-      });
-
-  return order;
-}
-
 /// This function returns a scalar of type 'dtype' from an optional value.
 /// Optional value must be: NoneType, memref<1xdtype> or memref<dtype>.
 /// Default value is used in case of NoneType.
@@ -573,6 +492,70 @@ Value getOptionalScalarValue(ConversionPatternRewriter &rewriter, Location loc,
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Support functions for parallelization.
+//===----------------------------------------------------------------------===//
+
+bool isParallelLoopNestProfitable(ArrayRef<IndexExpr> lbs,
+    ArrayRef<IndexExpr> ubs, int64_t numParallelLoops,
+    int64_t workPerIteration) {
+  assert(lbs.size() == ubs.size() && "expected as many lbs as ubs");
+  int64_t rank = lbs.size();
+  if (numParallelLoops <= 0 || numParallelLoops > rank)
+    return false;
+  // Compute the trip count of the parallel loops and the total work of the
+  // loop nest, for the loops whose bounds are known at compile time.
+  int64_t parallelTripCount = 1, totalWork = workPerIteration;
+  bool isParallelTripCountKnown = true, isTotalWorkKnown = true;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (!lbs[i].isLiteral() || !ubs[i].isLiteral()) {
+      if (i < numParallelLoops)
+        isParallelTripCountKnown = false;
+      isTotalWorkKnown = false;
+      continue;
+    }
+    int64_t tripCount =
+        std::max<int64_t>(ubs[i].getLiteral() - lbs[i].getLiteral(), 0);
+    if (i < numParallelLoops)
+      parallelTripCount *= tripCount;
+    totalWork *= tripCount;
+  }
+  // Not enough iterations to share among threads.
+  if (isParallelTripCountKnown && parallelTripCount < 2)
+    return false;
+  // Not enough work to amortize the cost of the threads.
+  if (isTotalWorkKnown && totalWork < gMinParallelWorkSize)
+    return false;
+  return true;
+}
+
+void iterateIEParallel(KrnlBuilder &createKrnl, int64_t numParallelLoops,
+    ArrayRef<IndexExpr> lbs, ArrayRef<IndexExpr> ubs,
+    function_ref<void(KrnlBuilder &createKrnl, ValueRange indices)>
+        bodyBuilderFn) {
+  assert(numParallelLoops > 0 && numParallelLoops <= (int64_t)lbs.size() &&
+         "expected at least one and at most rank parallel loops");
+  // Outermost loops are parallel, remaining loops are iterated sequentially
+  // by each thread.
+  ValueRange loopDef = createKrnl.defineLoops(lbs.size());
+  createKrnl.parallel(loopDef.take_front(numParallelLoops));
+  createKrnl.iterateIE(loopDef, loopDef, lbs, ubs, bodyBuilderFn);
+}
+
+void iterateIEOptionalParallel(KrnlBuilder &createKrnl, bool enableParallel,
+    int64_t numParallelLoops, ArrayRef<IndexExpr> lbs, ArrayRef<IndexExpr> ubs,
+    function_ref<void(KrnlBuilder &createKrnl, ValueRange indices)>
+        bodyBuilderFn,
+    int64_t workPerIteration) {
+  if (enableParallel && isParallelLoopNestProfitable(
+                            lbs, ubs, numParallelLoops, workPerIteration)) {
+    iterateIEParallel(createKrnl, numParallelLoops, lbs, ubs, bodyBuilderFn);
+    return;
+  }
+  ValueRange loopDef = createKrnl.defineLoops(lbs.size());
+  createKrnl.iterateIE(loopDef, loopDef, lbs, ubs, bodyBuilderFn);
+}
+
 //===----------------------------------------------------------------------===//
 // Support functions for help with custom layout.
 //===----------------------------------------------------------------------===//
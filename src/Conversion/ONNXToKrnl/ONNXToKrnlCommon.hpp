@@ -46,6 +46,18 @@
 // allocated memrefs or not during the conversion of ONNX to Krnl.
 extern bool ONNXToKrnl_gEmitDealloc;
 
+// A global variable to indicate whether element-wise ops may compute their
+// result in place, in the buffer of an operand that has no other use, during
+// the conversion of ONNX to Krnl.
+extern bool ONNXToKrnl_gEnableInPlace;
+
+// Global variables with the sizes in bytes of the L1, L2, and L3 data caches
+// of the target, used to block loop nests during the conversion of ONNX to
+// Krnl.
+extern int64_t ONNXToKrnl_gL1CacheSize;
+extern int64_t ONNXToKrnl_gL2CacheSize;
+extern int64_t ONNXToKrnl_gL3CacheSize;
+
 //===----------------------------------------------------------------------===//
 // Extends OnnxBuilder with member functions that might generate Krnl dialect
 // operations.
@@ -163,6 +175,11 @@ std::vector<mlir::Value> foldOrEmitONNXSplitOp(
     mlir::ConversionPatternRewriter &rewriter, mlir::Location loc,
     llvm::ArrayRef<mlir::Type> resultTypes, mlir::Value input, int64_t axis);
 
+/// Return the DenseElementsAttr of value if it is defined by a krnl.global or
+/// onnx.Constant op, possibly through an unrealized conversion cast, or a
+/// nullptr attribute otherwise.
+mlir::DenseElementsAttr getDenseElementAttrFromConstValue(mlir::Value value);
+
 /// Emit an ONNXTransposeOp. If the input is constant, do const propagation, and
 /// return a constant.
 mlir::Value foldOrEmitONNXTransposeOp(mlir::ConversionPatternRewriter &rewriter,
@@ -176,12 +193,6 @@ mlir::Value emitMemRefReinterpretCastOp(
     mlir::Value data, llvm::SmallVectorImpl<IndexExpr> &outputDims,
     mlir::Type outputType);
 
-/// Emit krnl iterate to compute argsort of a given MemRef along a given axis.
-/// Output MemRef has the same shape as the input MemRef but is of IndexType.
-mlir::Value emitArgSort(mlir::ConversionPatternRewriter &rewriter,
-    mlir::Location loc, mlir::Value input, int64_t axis,
-    bool ascending = false);
-
 //===----------------------------------------------------------------------===//
 // This is to get a scalar operation of a given type for a specific operation.
 //===----------------------------------------------------------------------===//
@@ -209,15 +220,19 @@ mlir::Value getIdentityValue(mlir::ConversionPatternRewriter &rewriter,
 // This is used in the innermost loop of a KrnlIterateOp to insert computation
 // composed of one or many scalar ops.
 // Use template specialization for each of different ONNX operations.
+// The element type may also be a vector type, in which case the operands are
+// vectors and the generated ops operate on vectors (see SIMD elementwise ops).
 //===----------------------------------------------------------------------===//
 template <typename Op>
 mlir::Value emitScalarOpFor(mlir::ConversionPatternRewriter &rewriter,
     mlir::Location loc, mlir::Operation *op, mlir::Type elementType,
     llvm::ArrayRef<mlir::Value> scalarOperands) {
-  if (elementType.isa<mlir::IntegerType>()) {
+  mlir::Type actualElementType =
+      MathBuilder::elementTypeWithVector(elementType);
+  if (actualElementType.isa<mlir::IntegerType>()) {
     return rewriter.create<ScalarIOp<Op>>(
         loc, elementType, scalarOperands, mlir::None);
-  } else if (elementType.isa<mlir::FloatType>()) {
+  } else if (actualElementType.isa<mlir::FloatType>()) {
     return rewriter.create<ScalarFOp<Op>>(
         loc, elementType, scalarOperands, mlir::None);
   } else {
@@ -225,6 +240,86 @@ mlir::Value emitScalarOpFor(mlir::ConversionPatternRewriter &rewriter,
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Fusion of chains of element-wise ops into the loop nest of another op.
+//===----------------------------------------------------------------------===//
+
+/// Helper fusing into the loop nest of an op (the root op) the chain of
+/// element-wise ops that consume its result, so that the chain is computed in
+/// a single pass over memory without intermediate buffers. The root op is
+/// either an element-wise op, or an op such as MatMul, Gemm, or Conv whose
+/// output store phase then applies the chain as an epilogue.
+///
+/// An op is appended to the chain when it is the single user of the last op
+/// of the chain, is in the same block as the root op, and produces a result
+/// of the same static shape and element type as the root op. Binary ops are
+/// fused when their other operand is available before the root op and can be
+/// broadcast to the output shape.
+class ElementwiseFusionHelper {
+public:
+  ElementwiseFusionHelper(mlir::ConversionPatternRewriter &rewriter,
+      mlir::Operation *rootOp, bool enableFusion)
+      : rewriter(rewriter), rootOp(rootOp) {
+    if (enableFusion)
+      findFusibleOps();
+  }
+
+  /// Return true if at least one op is fused after the root op.
+  bool hasFusedOps() const { return !fusedOps.empty(); }
+
+  /// Last op of the chain, whose result is computed by the loop nest.
+  mlir::Operation *getLastOp() const {
+    return fusedOps.empty() ? rootOp : fusedOps.back();
+  }
+
+  /// Operands of the fused ops that are not computed by the chain, as
+  /// memrefs of at most the output rank.
+  llvm::ArrayRef<mlir::Value> getFusedOperands() const {
+    return fusedOperands;
+  }
+
+  /// Return true if all fused ops can be computed on vectors.
+  bool hasSIMDSupport() const;
+
+  /// Apply the fused ops to the scalar result of the root op at the given
+  /// output indices, loading the fused operands with broadcasting as needed.
+  mlir::Value emitFusedOps(KrnlBuilder &createKrnl,
+      mlir::ValueRange outputIndices, mlir::Type elementType,
+      mlir::Value rootResult) const;
+
+  /// Apply the fused ops to the scalar or vector result of the root op, given
+  /// the values of the fused operands.
+  mlir::Value emitFusedOps(mlir::Type elementOrVectorType,
+      mlir::Value rootResult,
+      llvm::ArrayRef<mlir::Value> fusedOperandValues) const;
+
+  /// Replace the last op of the chain by the result of the loop nest, and
+  /// erase the root op and the other fused ops.
+  void replaceOrEraseONNXOps(mlir::Value alloc) const {
+    mlir::Operation *previous = rootOp;
+    for (mlir::Operation *fusedOp : fusedOps) {
+      rewriter.eraseOp(previous);
+      previous = fusedOp;
+    }
+    rewriter.replaceOp(previous, alloc);
+  }
+
+private:
+  void findFusibleOps();
+
+  mlir::ConversionPatternRewriter &rewriter;
+  mlir::Operation *rootOp;
+  // Fused ops, in the order of the chain.
+  llvm::SmallVector<mlir::Operation *, 4> fusedOps;
+  // For each fused op, the indices in fusedOperands of its operands that are
+  // not computed by the chain: none for unary ops, one for binary ops, and
+  // min and max (-1 if absent) for Clip.
+  llvm::SmallVector<llvm::SmallVector<int64_t, 2>, 4> fusedOperandIndices;
+  // For each fused op, whether the chain computes its first operand.
+  llvm::SmallVector<bool, 4> chainIsFirstOperand;
+  llvm::SmallVector<mlir::Value, 4> fusedOperands;
+};
+
 //===----------------------------------------------------------------------===//
 // Type conversion from Onnx types to Krnl types:
 //   - from Tensor type to the Standard dialect MemRef type
@@ -264,7 +359,8 @@ public:
 
 // For all ONNX operations.
 void populateONNXToKrnlConversionPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    bool enableSIMD, bool enableFusion, bool enableParallel);
 
 // `ControlFlow` directory methods:
 void populateLoweringONNXIfOpPattern(
@@ -279,24 +375,27 @@ void populateLoweringONNXClipOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXCumSumOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXElementwiseOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXElementwiseOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableSIMD,
+    bool enableFusion, bool enableParallel);
 void populateLoweringONNXGemmOpPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    bool enableFusion, bool enableParallel);
 void populateLoweringONNXHardmaxOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXLRNOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXMatMulOpPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling,
+    bool enableFusion, bool enableParallel);
 void populateLoweringONNXRandomNormalOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXRandomNormalLikeOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXReductionOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXSoftmaxOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXReductionOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
+void populateLoweringONNXSoftmaxOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 void populateLoweringONNXTopKOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 
@@ -306,11 +405,12 @@ void populateLoweringONNXCategoryMapperOpPattern(
 
 // `NN` directory methods:
 void populateLoweringONNXConvOpPattern(mlir::RewritePatternSet &,
-    mlir::TypeConverter &, mlir::MLIRContext *, bool enableTiling);
-void populateLoweringONNXNormalizationOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXPoolingOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableFusion,
+    bool enableParallel);
+void populateLoweringONNXNormalizationOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
+void populateLoweringONNXPoolingOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 
 // `ObjectDetection` directory methods:
 void populateLoweringONNXNonMaxSuppressionOpPattern(
@@ -345,10 +445,10 @@ void populateLoweringONNXUnsqueezeOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXUnsqueezeV11OpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXTransposeOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXGatherOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXTransposeOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
+void populateLoweringONNXGatherOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 void populateLoweringONNXGatherElementsOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXGatherNDOpPattern(
@@ -367,8 +467,8 @@ void populateLoweringONNXConstantOfShapeOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXConstantOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
-void populateLoweringONNXConcatOpPattern(
-    mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
+void populateLoweringONNXConcatOpPattern(mlir::RewritePatternSet &,
+    mlir::TypeConverter &, mlir::MLIRContext *, bool enableParallel);
 void populateLoweringONNXConcatShapeTransposeOpPattern(
     mlir::RewritePatternSet &, mlir::TypeConverter &, mlir::MLIRContext *);
 void populateLoweringONNXDepthToSpaceOpPattern(
@@ -446,6 +546,42 @@ mlir::Value getOptionalScalarValue(mlir::ConversionPatternRewriter &rewriter,
     mlir::Location loc, mlir::Value optionalScalar, mlir::Type elementType,
     double defaultValue);
 
+//===----------------------------------------------------------------------===//
+// Support functions for parallelization.
+//===----------------------------------------------------------------------===//
+
+/// Minimum number of innermost computations that a loop nest must perform
+/// before its outer loops are run in parallel. Smaller loop nests stay serial
+/// as the cost of dispatching the work to threads would dominate.
+static constexpr int64_t gMinParallelWorkSize = 4096;
+
+/// Return true if it is profitable to run the outermost `numParallelLoops`
+/// loops of the loop nest defined by `lbs` and `ubs` in parallel, where each
+/// iteration of the loop nest performs `workPerIteration` computations.
+/// Loops with runtime bounds are assumed to be large.
+bool isParallelLoopNestProfitable(llvm::ArrayRef<IndexExpr> lbs,
+    llvm::ArrayRef<IndexExpr> ubs, int64_t numParallelLoops,
+    int64_t workPerIteration = 1);
+
+/// Emit a loop nest iterating from `lbs` to `ubs` and invoke `bodyBuilderFn`
+/// with the induction variables of all its loops. The outermost
+/// `numParallelLoops` loops, which must carry no dependence, are marked with
+/// krnl.parallel. Temporary buffers used by the body must be allocated inside
+/// `bodyBuilderFn` so that each parallel iteration works on its own copy.
+void iterateIEParallel(KrnlBuilder &createKrnl, int64_t numParallelLoops,
+    llvm::ArrayRef<IndexExpr> lbs, llvm::ArrayRef<IndexExpr> ubs,
+    mlir::function_ref<void(KrnlBuilder &createKrnl, mlir::ValueRange indices)>
+        bodyBuilderFn);
+
+/// Same as above when `enableParallel` is set and the loop nest is profitable
+/// to parallelize. Otherwise, emit a single krnl.iterate over all the loops.
+void iterateIEOptionalParallel(KrnlBuilder &createKrnl, bool enableParallel,
+    int64_t numParallelLoops, llvm::ArrayRef<IndexExpr> lbs,
+    llvm::ArrayRef<IndexExpr> ubs,
+    mlir::function_ref<void(KrnlBuilder &createKrnl, mlir::ValueRange indices)>
+        bodyBuilderFn,
+    int64_t workPerIteration = 1);
+
 //===----------------------------------------------------------------------===//
 // Support functions for help with custom layout.
 //===----------------------------------------------------------------------===//
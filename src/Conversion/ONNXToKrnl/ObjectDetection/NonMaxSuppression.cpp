@@ -4,15 +4,18 @@
 
 //===----- NonMaxSuppression.cpp - Lowering NonMaxSuppression Op ----------===//
 //
-// Copyright 2019-2020 The IBM Research Authors.
+// Copyright 2019-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
 // This file lowers the ONNX NonMaxSuppression Operator to Krnl dialect.
 //
+// The boxes are selected by the omTensorNonMaxSuppression runtime function,
+// which processes the (batch, class) pairs in parallel and stops visiting the
+// boxes of a pair once enough of them are selected.
+//
 //===----------------------------------------------------------------------===//
 
-#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
 #include "src/Dialect/Krnl/DialectBuilder.hpp"
 
@@ -20,77 +23,6 @@ using namespace mlir;
 
 namespace onnx_mlir {
 
-/// Compute the intersection-over-union (IOU) score between two boxes.
-/// IOU tells us how much two boxes are overlapped.
-static Value emitIOU(MathBuilder &createMath, SmallVectorImpl<Value> &box1,
-    SmallVectorImpl<Value> &box2, int64_t centerPointBox = 0) {
-  Value area1, area2;
-  Value y1_min, x1_min, y1_max, x1_max;
-  Value y2_min, x2_min, y2_max, x2_max;
-  if (centerPointBox == 0) {
-    // The box data is supplied as [y1, x1, y2, x2]. (y1, x1) and (y2, x2)
-    // are the coordinates of the diagonal pair of bottom-left and top-right
-    // corners.
-    y1_min = box1[0];
-    x1_min = box1[1];
-    y1_max = box1[2];
-    x1_max = box1[3];
-
-    y2_min = box2[0];
-    x2_min = box2[1];
-    y2_max = box2[2];
-    x2_max = box2[3];
-
-    area1 = createMath.mul(
-        createMath.sub(y1_max, y1_min), createMath.sub(x1_max, x1_min));
-    area2 = createMath.mul(
-        createMath.sub(y2_max, y2_min), createMath.sub(x2_max, x2_min));
-  } else {
-    // The box data is supplied as [x_center, y_center, width, height].
-    Value x1_center = box1[0];
-    Value y1_center = box1[1];
-    Value w1 = box1[2];
-    Value h1 = box1[3];
-
-    Value x2_center = box2[0];
-    Value y2_center = box2[1];
-    Value w2 = box2[2];
-    Value h2 = box2[3];
-
-    Value two = createMath.constant(w1.getType(), 2);
-    x1_min = createMath.sub(x1_center, createMath.div(w1, two));
-    x1_max = createMath.add(x1_center, createMath.div(w1, two));
-    y1_min = createMath.sub(y1_center, createMath.div(h1, two));
-    y1_max = createMath.add(y1_center, createMath.div(h1, two));
-
-    y2_min = createMath.sub(y2_center, createMath.div(h2, two));
-    y2_max = createMath.add(y2_center, createMath.div(h2, two));
-    x2_min = createMath.sub(x2_center, createMath.div(w2, two));
-    x2_max = createMath.add(x2_center, createMath.div(w2, two));
-
-    area1 = createMath.mul(h1, w1);
-    area2 = createMath.mul(h2, w2);
-  }
-
-  Value intersection_x_min = createMath.max(x1_min, x2_min);
-  Value intersection_y_min = createMath.max(y1_min, y2_min);
-  Value intersection_x_max = createMath.min(x1_max, x2_max);
-  Value intersection_y_max = createMath.min(y1_max, y2_max);
-
-  Value zero = createMath.constant(intersection_x_min.getType(), 0);
-  Value intersection_w = createMath.sub(intersection_x_max, intersection_x_min);
-  Value intersection_h = createMath.sub(intersection_y_max, intersection_y_min);
-  Value intersection_area = createMath.mul(createMath.max(intersection_w, zero),
-      createMath.max(intersection_h, zero));
-
-  Value union_area = createMath.add(area1, area2);
-  union_area = createMath.sub(union_area, intersection_area);
-  // Avoid zero division.
-  Value epsilon = createMath.constant(zero.getType(), 1e-8);
-  union_area = createMath.add(union_area, epsilon);
-  return createMath.div(intersection_area, union_area);
-}
-
 /// Suppress the number of output bounding boxes per class by scores.
 static void suppressByScores(ConversionPatternRewriter &rewriter, Location loc,
     Value scores, Value scoreThreshold, Value maxOutputPerClass) {
@@ -157,61 +89,15 @@ static void suppressByScores(ConversionPatternRewriter &rewriter, Location loc,
   create.krnl.store(create.math.min(x, y), maxOutputPerClass, {});
 }
 
-/// Bounding boxes may contain a mix of flipped and non-flipped boxes. Try to
-/// flip the flipped boxes back.
-/// BoundingBoxes: [num_of_batch, spatial_dimension, 4]
-static Value tryToUnflip(
-    ConversionPatternRewriter &rewriter, Location loc, Value boundingBoxes) {
-  MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl> create(
-      rewriter, loc);
-  SmallVector<IndexExpr, 4> ubs;
-  create.krnlIE.getShapeAsDims(boundingBoxes, ubs);
-  IndexExpr bs = ubs[0]; // batch size.
-  IndexExpr ss = ubs[1]; // spatial size.
-  LiteralIndexExpr zeroIE(0), oneIE(1), twoIE(2), threeIE(3);
-
-  Value resMemRef = insertAllocAndDeallocSimple(rewriter, nullptr,
-      boundingBoxes.getType().cast<MemRefType>(), loc, ubs,
-      /*insertDealloc=*/false);
-
-  ValueRange loopDef = create.krnl.defineLoops(2);
-  create.krnl.iterateIE(loopDef, loopDef, {zeroIE, zeroIE}, {bs, ss},
-      [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
-        MathBuilder createMath(createKrnl);
-        DimIndexExpr b(loopInd[0]), s(loopInd[1]);
-        // Load a bounding box.
-        Value y_min = createKrnl.loadIE(boundingBoxes, {b, s, zeroIE});
-        Value x_min = createKrnl.loadIE(boundingBoxes, {b, s, oneIE});
-        Value y_max = createKrnl.loadIE(boundingBoxes, {b, s, twoIE});
-        Value x_max = createKrnl.loadIE(boundingBoxes, {b, s, threeIE});
-
-        // Flip x.
-        Value gtX = createMath.sgt(x_min, x_max);
-        Value newXMin = createMath.select(gtX, x_max, x_min);
-        Value newXMax = createMath.select(gtX, x_min, x_max);
-
-        // Flip y.
-        Value gtY = createMath.sgt(y_min, y_max);
-        Value newYMin = createMath.select(gtY, y_max, y_min);
-        Value newYMax = createMath.select(gtY, y_min, y_max);
-
-        // Update the bounding box.
-        createKrnl.storeIE(newYMin, resMemRef, {b, s, zeroIE});
-        createKrnl.storeIE(newXMin, resMemRef, {b, s, oneIE});
-        createKrnl.storeIE(newYMax, resMemRef, {b, s, twoIE});
-        createKrnl.storeIE(newXMax, resMemRef, {b, s, threeIE});
-      });
-  return resMemRef;
-}
-
 struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
   ONNXNonMaxSuppressionOpLowering(
       TypeConverter &typeConverter, MLIRContext *ctx)
       : ConversionPattern(typeConverter,
             ONNXNonMaxSuppressionOp::getOperationName(), 1, ctx) {}
 
-  /// To understand how code is generated for NonMaxSuppression, look at the
-  /// python implementation at the end of this file.
+  /// The boxes are selected by the omTensorNonMaxSuppression runtime
+  /// function. The python implementation at the end of this file gives the
+  /// semantics it implements.
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     ONNXNonMaxSuppressionOp nmsOp = llvm::cast<ONNXNonMaxSuppressionOp>(op);
@@ -233,7 +119,6 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     // Common information.
     Type elementType = memRefType.getElementType();
     Type indexType = rewriter.getIndexType();
-    Type boolType = rewriter.getI1Type();
     Type i64Type = rewriter.getI64Type();
 
     // Operation's operands.
@@ -241,11 +126,16 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     Value boxes = operandAdaptor.boxes();
     // Scores.
     Value scores = operandAdaptor.scores();
+    // The runtime function only supports float boxes and scores, which are
+    // the only types allowed by ONNX.
+    Type boxType = boxes.getType().cast<MemRefType>().getElementType();
+    Type scoreType = scores.getType().cast<MemRefType>().getElementType();
+    if (!boxType.isF32() || !scoreType.isF32())
+      return emitError(loc, "not implemented yet");
     // Maximum number of output boxes per class.
     Value maxOutputBoxPerClass = getOptionalScalarValue(
         rewriter, loc, operandAdaptor.max_output_boxes_per_class(), i64Type, 0);
     // Score threshold.
-    Type scoreType = scores.getType().cast<MemRefType>().getElementType();
     Value scoreTH = getOptionalScalarValue(
         rewriter, loc, operandAdaptor.score_threshold(), scoreType, 0);
     // IOU threshold.
@@ -258,18 +148,12 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     // scores: [num_of_batch, num_of_class, spatial_dimension]
     IndexExpr bsIE = create.krnlIE.getShapeAsDim(scores, 0); // batch size.
     IndexExpr csIE = create.krnlIE.getShapeAsDim(scores, 1); // class size.
-    IndexExpr ssIE = create.krnlIE.getShapeAsDim(scores, 2); // spatial size.
-    Value bs = bsIE.getValue();
-    Value cs = csIE.getValue();
-    Value ss = ssIE.getValue();
+    Value ss = create.krnlIE.getShapeAsDim(scores, 2).getValue();
 
     // Frequently used constants.
     Value zero = create.math.constantIndex(0);
     Value one = create.math.constantIndex(1);
-    Value two = create.math.constantIndex(2);
     Value three = create.math.constantIndex(3);
-    Value falseVal = create.math.constant(boolType, 0);
-    Value trueVal = create.math.constant(boolType, 1);
 
     // Refine the number of output boxes per class by suppressing it using
     // spatial dimension size and score threshold.
@@ -281,15 +165,6 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     suppressByScores(rewriter, loc, scores, scoreTH, maxOutputPerClass);
     Value MOPC = create.krnl.load(maxOutputPerClass, {});
 
-    // Sort scores in the descending order.
-    Value order = emitArgSort(rewriter, loc, scores, /*axis=*/2,
-        /*ascending=*/false);
-
-    // Bounding boxes may contain a mix of flipped and non-flipped boxes. Try to
-    // unflip the flipped boxes.
-    if (centerPointBox == 0)
-      boxes = tryToUnflip(rewriter, loc, boxes);
-
     // The total number of output selected indices.
     IndexExpr numSelectedIndicesIE = bsIE * csIE * DimIndexExpr(MOPC);
 
@@ -306,10 +181,17 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
       outputShape.emplace_back(-1);
     outputShape.emplace_back(3);
     Value selectedMemRef = insertAllocAndDeallocSimple(rewriter, op,
-        MemRefType::get(outputShape, indexType), loc, outputDims,
+        MemRefType::get(outputShape, i64Type), loc, outputDims,
         /*insertDealloc=*/true);
-    // Initialize with value -1.
-    create.krnl.memset(selectedMemRef, create.math.constantIndex(-1));
+
+    // Select the boxes of each batch and class. The selected indices are
+    // stored first, and the rows that are not used are set to -1.
+    Value valMOPC = create.math.cast(i64Type, MOPC);
+    Value valCenterPointBox = create.math.constant(i64Type, centerPointBox);
+    SmallVector<Value, 6> callOperands = {
+        boxes, scores, valMOPC, iouTH, scoreTH, valCenterPointBox};
+    rewriter.create<KrnlCallOp>(
+        loc, "omTensorNonMaxSuppression", selectedMemRef, callOperands);
 
     // Effective number of selected indices. This is the final value for the 1st
     // dim of the output, which is suppressed by IOU during computation and
@@ -318,126 +200,20 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     Value effectiveNumSelectedIndices =
         create.mem.alloca(MemRefType::get({}, indexType));
     create.krnl.store(zero, effectiveNumSelectedIndices, {});
-
-    // Suppress by using IOU.
-    // Iterate over all bounding boxes in the descending order of scores.
-    Value effectiveMaxOutputPerClass =
-        create.mem.alloca(MemRefType::get({}, indexType));
-    ValueRange bcLoopDef = create.krnl.defineLoops(2);
-    create.krnl.iterate(bcLoopDef, bcLoopDef, {zero, zero}, {bs, cs},
-        [&](KrnlBuilder &createKrnl, ValueRange bcLoopInd) {
-          MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
-              createKrnl);
-          // Keep trace of the number of output boxes per class.
-          create.krnl.store(zero, effectiveMaxOutputPerClass, {});
-          // Keep trace of removed indices per class.
-          DimIndexExpr ssIE(ss);
-          SmallVector<IndexExpr, 1> dims = {ssIE};
-          SmallVector<int64_t, 1> shapes = {-1};
-          if (ssIE.isLiteral())
-            shapes[0] = ssIE.getLiteral();
-          Value removedIndices = insertAllocAndDeallocSimple(rewriter, nullptr,
-              MemRefType::get(shapes, boolType), loc, dims,
-              /*insertDealloc=*/true);
-          create.krnl.memset(removedIndices, falseVal);
-
-          // Iterate in the descending order of scores.
-          ValueRange sLoopDef = create.krnl.defineLoops(1);
-          create.krnl.iterate(sLoopDef, sLoopDef, {zero}, {ss},
-              [&](KrnlBuilder &createKrnl, ValueRange sLoopInd) {
-                Value b(bcLoopInd[0]), c(bcLoopInd[1]), s(sLoopInd[0]);
-                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
-                    createKrnl);
-
-                // Index of the bounding box with the largest score.
-                Value selectedBI = create.krnl.load(order, {b, c, s});
-
-                // Check conditions to select a bounding box.
-                // 1. Only bounding boxes whose score > score_threshold.
-                Value score = create.krnl.load(scores, {b, c, selectedBI});
-                Value checkScore = create.math.sgt(score, scoreTH);
-                // 2. Have not yet got enough outputs.
-                Value currentMOPC =
-                    create.krnl.load(effectiveMaxOutputPerClass, {});
-                Value checkMOPC = create.math.slt(currentMOPC, MOPC);
-                // 3. Bounding box has not yet been removed.
-                Value isRemoved =
-                    create.krnl.load(removedIndices, {selectedBI});
-                Value isNotRemoved = create.math.eq(isRemoved, falseVal);
-
-                // Only proceed if the box satisfies the above conditions.
-                Value canSelectBox = create.math.andi(
-                    create.math.andi(checkScore, checkMOPC), isNotRemoved);
-                auto ifOp = rewriter.create<scf::IfOp>(
-                    loc, canSelectBox, /*withElseRegion=*/false);
-                rewriter.setInsertionPointToStart(
-                    &ifOp.getThenRegion().front());
-
-                // Select the bounding box with the largest score.
-                SmallVector<Value, 4> selectedBox;
-                for (int i = 0; i < 4; ++i) {
-                  Value iVal = create.math.constantIndex(i);
-                  Value x = create.krnl.load(boxes, {b, selectedBI, iVal});
-                  selectedBox.emplace_back(x);
-                }
-
-                // Store the index of the selected box to the output.
-                // out_index = effective_num_selected_indices
-                // selected_indices[out_index] = [b, c, selected_box_index]
-                Value soVal = create.krnl.load(effectiveNumSelectedIndices, {});
-                create.krnl.store(b, selectedMemRef, {soVal, zero});
-                create.krnl.store(c, selectedMemRef, {soVal, one});
-                create.krnl.store(selectedBI, selectedMemRef, {soVal, two});
-
-                // Update the number of output boxes per class.
-                // effective_max_output_per_class += 1
-                create.krnl.store(create.math.add(currentMOPC, one),
-                    effectiveMaxOutputPerClass, {});
-
-                // Update the effective number of selected indices.
-                // effective_num_selected_indices += 1
-                create.krnl.store(create.math.add(soVal, one),
-                    effectiveNumSelectedIndices, {});
-
-                // Remove boxes overlapped too much with the selected box,
-                // using IOU.
-                ValueRange oLoopDef = create.krnl.defineLoops(1);
-                create.krnl.iterate(oLoopDef, oLoopDef, {zero}, {ss},
-                    [&](KrnlBuilder &createKrnl, ValueRange oLoopInd) {
-                      Value o(oLoopInd[0]);
-                      MathBuilder createMath(createKrnl);
-
-                      // Only proceed if a box has not yet been removed.
-                      Value isRemoved = createKrnl.load(removedIndices, {o});
-                      Value isNotRemoved = createMath.eq(isRemoved, falseVal);
-                      auto if1Op = rewriter.create<scf::IfOp>(
-                          loc, isNotRemoved, /*withElseRegion=*/false);
-                      rewriter.setInsertionPointToStart(
-                          &if1Op.getThenRegion().front());
-
-                      // Pick the current box.
-                      SmallVector<Value, 4> otherBox;
-                      for (int i = 0; i < 4; ++i) {
-                        Value iVal = createMath.constantIndex(i);
-                        Value x = createKrnl.load(boxes, {b, o, iVal});
-                        otherBox.emplace_back(x);
-                      }
-
-                      // Compute IOU between the selected and current boxes.
-                      Value iou = emitIOU(
-                          createMath, selectedBox, otherBox, centerPointBox);
-
-                      // Only proceed if IOU >= iou_threshold.
-                      Value checkIOU = createMath.sge(iou, iouTH);
-                      auto if2Op = rewriter.create<scf::IfOp>(
-                          loc, checkIOU, /*withElseRegion=*/false);
-                      rewriter.setInsertionPointToStart(
-                          &if2Op.getThenRegion().front());
-
-                      // If IOU is satisfied, mark the current box as removed.
-                      createKrnl.store(trueVal, removedIndices, {o});
-                    });
-              });
+    ValueRange nLoopDef = create.krnl.defineLoops(1);
+    create.krnl.iterate(nLoopDef, nLoopDef, {zero},
+        {numSelectedIndicesIE.getValue()},
+        [&](KrnlBuilder &createKrnl, ValueRange nLoopInd) {
+          MathBuilder createMath(createKrnl);
+          // Count the rows whose batch index is set.
+          Value batchIndex =
+              createKrnl.load(selectedMemRef, {nLoopInd[0], zero});
+          Value isSelected =
+              createMath.sge(batchIndex, createMath.constant(i64Type, 0));
+          Value count = createKrnl.load(effectiveNumSelectedIndices, {});
+          Value countPlusOne = createMath.add(count, one);
+          count = createMath.select(isSelected, countPlusOne, count);
+          createKrnl.store(count, effectiveNumSelectedIndices, {});
         });
 
     // Insert allocation and deallocation for the final output.
@@ -4,12 +4,15 @@
 
 //====--------------- PerfectHash.cpp - Perfect Hash Table ----------------===//
 //
-// Copyright 2021 The IBM Research Authors.
+// Copyright 2021-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
 // This file contains the implementation of a perfect hash table.
 //
+// The hash functions must match the ones used by the lookups at runtime
+// (src/Runtime/OMIndexLookup.inc).
+//
 //===----------------------------------------------------------------------===//
 
 #include "src/Conversion/ONNXToKrnl/PerfectHash.hpp"
@@ -20,7 +23,6 @@
 
 #include <map>
 #include <numeric>
-#include <string>
 #include <vector>
 
 #define DEBUG_TYPE "perfect_hash"
@@ -41,9 +43,17 @@ public:
     return hval;
   }
 
-  // Adaptation of 32-bit FNV for int64_t values.
+  // Hash an int64_t value with the 64-bit finalizer of MurmurHash3, after
+  // adding a multiple of the seed so that each seed gives a different hash.
   static inline uint32_t hash(uint32_t hval, int64_t val) {
-    return hash(hval, std::to_string(val));
+    uint64_t h = static_cast<uint64_t>(val) +
+                 static_cast<uint64_t>(hval) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
   }
 
   // Extracts the keys of the given map.
@@ -21,9 +21,12 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXConcatOpLowering : public ConversionPattern {
-  ONNXConcatOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  ONNXConcatOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, mlir::ONNXConcatOp::getOperationName(), 1, ctx) {}
+            typeConverter, mlir::ONNXConcatOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -72,13 +75,13 @@ struct ONNXConcatOpLowering : public ConversionPattern {
       Value accumulatedOffsetValue = accumulatedOffset.getValue();
       OpBuilder::InsertionGuard insertGuard(rewriter);
       // Create loop.
-      ValueRange loopDef = create.krnl.defineLoops(rank);
       SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0));
       SmallVector<IndexExpr, 4> ubs;
       create.krnlIE.getShapeAsDims(operands[i], ubs);
       // For each input, only the dimension 'axis' is different
       commonUB[axis] = ubs[axis];
-      create.krnl.iterateIE(loopDef, loopDef, lbs, commonUB,
+      iterateIEOptionalParallel(create.krnl, enableParallel,
+          std::max<int64_t>(rank - 1, 1), lbs, commonUB,
           [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
             // Indices for the read and write.
             SmallVector<Value, 4> readIndices, writeIndices;
@@ -107,8 +110,8 @@ struct ONNXConcatOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXConcatOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
-  patterns.insert<ONNXConcatOpLowering>(typeConverter, ctx);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXConcatOpLowering>(typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
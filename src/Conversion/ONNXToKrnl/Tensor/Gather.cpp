@@ -20,9 +20,12 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXGatherOpLowering : public ConversionPattern {
-  ONNXGatherOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  ONNXGatherOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, mlir::ONNXGatherOp::getOperationName(), 1, ctx) {}
+            typeConverter, mlir::ONNXGatherOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -79,9 +82,9 @@ struct ONNXGatherOpLowering : public ConversionPattern {
             out[ii + jj + kk] = data[ii + (indices[jj],) + kk]
     */
     // Define loops and iteration trip counts (equivalent to size of output)
-    ValueRange loopDef = create.krnl.defineLoops(outputRank);
     DimsExpr lbs(outputRank, zeroIE);
-    create.krnl.iterateIE(loopDef, loopDef, lbs, shapeHelper.getOutputDims(),
+    iterateIEOptionalParallel(create.krnl, enableParallel,
+        std::max<int64_t>(outputRank - 1, 1), lbs, shapeHelper.getOutputDims(),
         [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
           // Insert code inside the loop.
           IndexExprScope innerLoopScope(createKrnl);
@@ -123,8 +126,8 @@ struct ONNXGatherOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXGatherOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
-  patterns.insert<ONNXGatherOpLowering>(typeConverter, ctx);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXGatherOpLowering>(typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -4,12 +4,17 @@
 
 //===---------------- Resize.cpp - Lowering Resize Op ---------------------===//
 //
-// Copyright 2019-2022 The IBM Research Authors.
+// Copyright 2019-2023 The IBM Research Authors.
 //
 // =============================================================================
 //
 // This file lowers the ONNX Resize Operator to Krnl dialect.
 //
+// The nearest mode with the asymmetric and half_pixel coordinate
+// transformations is generated as a Krnl loop nest. The other modes call the
+// omTensorResize runtime function, which resizes the tensor axis by axis with
+// precomputed indices and coefficients.
+//
 //===----------------------------------------------------------------------===//
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
@@ -44,9 +49,15 @@ struct ONNXResizeOpLowering : public ConversionPattern {
     int64_t rank = memRefType.getShape().size();
 
     // Check implementation constraints
-    if (resizeOp.mode() == "nearest" &&
-        (resizeOp.coordinate_transformation_mode() != "asymmetric" &&
-            resizeOp.coordinate_transformation_mode() != "half_pixel"))
+    StringRef mode = resizeOp.mode();
+    StringRef coordinateMode = resizeOp.coordinate_transformation_mode();
+    bool nearestInKrnl =
+        mode == "nearest" &&
+        (coordinateMode == "asymmetric" || coordinateMode == "half_pixel");
+    Type elementType = memRefType.getElementType();
+    if (coordinateMode == "tf_crop_and_resize" ||
+        (!nearestInKrnl && !elementType.isF32() && !elementType.isF16() &&
+            !elementType.isInteger(8)))
       return emitError(loc, "not implemented yet");
 
     MultiDialectBuilder<KrnlBuilder, IndexExprBuilderForKrnl, MathBuilder,
@@ -126,23 +137,42 @@ struct ONNXResizeOpLowering : public ConversionPattern {
           rewriter, op, memRefType, loc, outputDims, insertDealloc);
     }
 
-    // Call external function when the mode is not "nearest"
-    // Create KrnlCallOp and replace the du chain
-    // One of inputs, scales() and size(), has to be None.
-    // For now, None input is picked out by KrnlCall builder,
-    // and different function will be called accordingly.
-    // Another issue is the attributes with default value.
-    // Currently, it is assumed that all the optional attributes have
-    // the default value and does appear in the Attribute dictionry.
-    // ToFix: Handle attributes for general case
-    if (resizeOp.mode() != "nearest") {
-      if (!isFromNone(resizeOp.scales())) {
-        rewriter.create<KrnlCallOp>(
-            loc, "Resize_Scales", alloc, op, operands, true);
-      } else {
-        rewriter.create<KrnlCallOp>(
-            loc, "Resize_Size", alloc, op, operands, true);
-      }
+    // Call the runtime for the modes that are not generated below. The scale
+    // of each axis is passed in a buffer, and the modes as the integers of the
+    // enumerations of the runtime.
+    if (!nearestInKrnl) {
+      MemRefType scalesType = MemRefType::get({rank}, rewriter.getF32Type());
+      Value scalesMemRef = create.mem.alloca(scalesType);
+      for (int64_t i = 0; i < rank; ++i)
+        create.krnl.store(
+            scaleValues[i], scalesMemRef, create.math.constantIndex(i));
+      int64_t modeInt = mode == "nearest" ? 0 : (mode == "linear" ? 1 : 2);
+      int64_t coordinateModeInt = 0;
+      if (coordinateMode == "asymmetric")
+        coordinateModeInt = 1;
+      else if (coordinateMode == "align_corners")
+        coordinateModeInt = 2;
+      else if (coordinateMode == "pytorch_half_pixel")
+        coordinateModeInt = 3;
+      else if (coordinateMode == "tf_half_pixel_for_nn")
+        coordinateModeInt = 4;
+      StringRef nearestMode = resizeOp.nearest_mode();
+      int64_t nearestModeInt = 0;
+      if (nearestMode == "round_prefer_ceil")
+        nearestModeInt = 1;
+      else if (nearestMode == "floor")
+        nearestModeInt = 2;
+      else if (nearestMode == "ceil")
+        nearestModeInt = 3;
+      Type i64Type = rewriter.getI64Type();
+      SmallVector<Value, 8> callOperands = {data, scalesMemRef,
+          create.math.constant(i64Type, modeInt),
+          create.math.constant(i64Type, coordinateModeInt),
+          create.math.constant(i64Type, nearestModeInt),
+          create.math.constant(rewriter.getF32Type(),
+              resizeOp.cubic_coeff_a().convertToFloat()),
+          create.math.constant(i64Type, resizeOp.exclude_outside())};
+      rewriter.create<KrnlCallOp>(loc, "omTensorResize", alloc, callOperands);
       rewriter.replaceOp(op, alloc);
       return success();
     }
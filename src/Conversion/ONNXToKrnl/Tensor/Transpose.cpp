@@ -20,9 +20,12 @@ using namespace mlir;
 namespace onnx_mlir {
 
 struct ONNXTransposeOpLowering : public ConversionPattern {
-  ONNXTransposeOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+  ONNXTransposeOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel)
       : ConversionPattern(
-            typeConverter, mlir::ONNXTransposeOp::getOperationName(), 1, ctx) {}
+            typeConverter, mlir::ONNXTransposeOp::getOperationName(), 1, ctx),
+        enableParallel(enableParallel) {}
+  bool enableParallel;
 
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
@@ -77,23 +80,23 @@ struct ONNXTransposeOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outMemRefType, loc, shapeHelper.getOutputDims());
 
-    ValueRange loopDef = create.krnl.defineLoops(outRank);
-    SmallVector<IndexExpr, 4> lbs(outRank, LiteralIndexExpr(0));
+    auto bodyFunction = [&](KrnlBuilder &createKrnl, ValueRange indices) {
+      // Compute the indices used by the load operation.
+      SmallVector<IndexExpr, 4> storeIndices;
+      for (uint64_t i = 0; i < outRank; ++i) {
+        Value index = indices[ArrayAttrIntVal(permAttr, i)];
+        storeIndices.emplace_back(DimIndexExpr(index));
+      }
+
+      Value loadData = createKrnl.load(data, indices);
+      createKrnl.storeIE(loadData, alloc, storeIndices);
+    };
 
+    SmallVector<IndexExpr, 4> lbs(outRank, LiteralIndexExpr(0));
     SmallVector<IndexExpr, 4> ubs;
     create.krnlIE.getShapeAsDims(data, ubs);
-    create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
-        [&](KrnlBuilder &createKrnl, ValueRange indices) {
-          // Compute the indices used by the load operation.
-          SmallVector<IndexExpr, 4> storeIndices;
-          for (uint64_t i = 0; i < outRank; ++i) {
-            Value index = indices[ArrayAttrIntVal(permAttr, i)];
-            storeIndices.emplace_back(DimIndexExpr(index));
-          }
-
-          Value loadData = createKrnl.load(data, indices);
-          createKrnl.storeIE(loadData, alloc, storeIndices);
-        });
+    iterateIEOptionalParallel(create.krnl, enableParallel,
+        std::max<int64_t>(outRank - 1, 1), lbs, ubs, bodyFunction);
 
     rewriter.replaceOp(op, alloc);
     return success();
@@ -101,8 +104,9 @@ struct ONNXTransposeOpLowering : public ConversionPattern {
 };
 
 void populateLoweringONNXTransposeOpPattern(RewritePatternSet &patterns,
-    TypeConverter &typeConverter, MLIRContext *ctx) {
-  patterns.insert<ONNXTransposeOpLowering>(typeConverter, ctx);
+    TypeConverter &typeConverter, MLIRContext *ctx, bool enableParallel) {
+  patterns.insert<ONNXTransposeOpLowering>(
+      typeConverter, ctx, enableParallel);
 }
 
 } // namespace onnx_mlir
@@ -120,6 +120,10 @@ void KrnlBuilder::permute(ValueRange loops, ArrayRef<int64_t> map) const {
   b().create<KrnlPermuteOp>(loc(), loops, map);
 }
 
+void KrnlBuilder::parallel(ValueRange loops) const {
+  b().create<KrnlParallelOp>(loc(), loops);
+}
+
 ValueRange KrnlBuilder::getInductionVarValue(ValueRange loops) const {
   return b()
       .template create<KrnlGetInductionVariableValueOp>(loc(), loops)
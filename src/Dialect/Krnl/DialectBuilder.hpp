@@ -51,6 +51,7 @@ struct KrnlBuilder : public DialectBuilder {
   mlir::ValueRange defineLoops(int64_t originalLoopNum) const;
   mlir::ValueRange block(mlir::Value loop, int64_t blockSize) const;
   void permute(mlir::ValueRange loops, mlir::ArrayRef<int64_t> map) const;
+  void parallel(mlir::ValueRange loops) const;
   mlir::ValueRange getInductionVarValue(mlir::ValueRange loops) const;
 
   // Lambda passes loop indices as 2nd parameter.
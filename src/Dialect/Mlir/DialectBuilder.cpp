@@ -47,8 +47,34 @@ namespace onnx_mlir {
 // ONNX Integers as MLIR signless, and only flag the ONNX Unsigned Integer as
 // MLIR unsigned integer.
 
+// Support for vectors: the type tests below look at the element type of vector
+// types, so that the same builder methods generate scalar or vector operations.
+
+/*static*/ Type MathBuilder::elementTypeWithVector(Type elementOrVectorType) {
+  VectorType vectorType = elementOrVectorType.dyn_cast<VectorType>();
+  if (vectorType)
+    return vectorType.getElementType();
+  return elementOrVectorType;
+}
+
+/*static*/ bool MathBuilder::isIntegerWithVector(Type elementOrVectorType) {
+  Type elementType = elementTypeWithVector(elementOrVectorType);
+  return elementType.isa<IntegerType>() || elementType.isa<IndexType>();
+}
+
+/*static*/ bool MathBuilder::isUnsignedIntegerWithVector(
+    Type elementOrVectorType) {
+  Type elementType = elementTypeWithVector(elementOrVectorType);
+  return elementType.isUnsignedInteger();
+}
+
+/*static*/ bool MathBuilder::isFloatWithVector(Type elementOrVectorType) {
+  Type elementType = elementTypeWithVector(elementOrVectorType);
+  return elementType.isa<FloatType>();
+}
+
 Value MathBuilder::abs(Value val) const {
-  if (val.getType().isa<IntegerType>() || val.getType().isa<IndexType>())
+  if (isIntegerWithVector(val.getType()))
     return b().create<math::AbsIOp>(loc(), val);
   return b().create<math::AbsFOp>(loc(), val);
 }
@@ -65,65 +91,65 @@ Value MathBuilder::ori(Value lhs, Value rhs) const {
 
 Value MathBuilder::add(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return b().create<arith::AddIOp>(loc(), lhs, rhs);
   return b().create<arith::AddFOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::sub(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return b().create<arith::SubIOp>(loc(), lhs, rhs);
   return b().create<arith::SubFOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::mul(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return b().create<arith::MulIOp>(loc(), lhs, rhs);
   return b().create<arith::MulFOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::div(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<FloatType>())
+  if (isFloatWithVector(lhs.getType()))
     return b().create<arith::DivFOp>(loc(), lhs, rhs);
-  else if (lhs.getType().isUnsignedInteger())
+  else if (isUnsignedIntegerWithVector(lhs.getType()))
     return b().create<arith::DivUIOp>(loc(), lhs, rhs);
   else
     return b().create<arith::DivSIOp>(loc(), lhs, rhs);
 }
 
 Value MathBuilder::exp(Value val) const {
-  assert(val.getType().isa<FloatType>() && "Data type must be float.");
+  assert(isFloatWithVector(val.getType()) && "Data type must be float.");
   return b().create<math::ExpOp>(loc(), val);
 }
 
 Value MathBuilder::exp2(Value val) const {
-  assert(val.getType().isa<FloatType>() && "Data type must be float.");
+  assert(isFloatWithVector(val.getType()) && "Data type must be float.");
   return b().create<math::Exp2Op>(loc(), val);
 }
 
 Value MathBuilder::log2(Value val) const {
-  assert(val.getType().isa<FloatType>() && "Data type must be float.");
+  assert(isFloatWithVector(val.getType()) && "Data type must be float.");
   return b().create<math::Log2Op>(loc(), val);
 }
 
 Value MathBuilder::sqrt(Value val) const {
-  assert(val.getType().isa<FloatType>() && "Data type must be float.");
+  assert(isFloatWithVector(val.getType()) && "Data type must be float.");
   return b().create<math::SqrtOp>(loc(), val);
 }
 
 Value MathBuilder::pow(Value base, Value exp) const {
-  assert(base.getType().isa<FloatType>() && "Data type must be float.");
+  assert(isFloatWithVector(base.getType()) && "Data type must be float.");
   return b().create<math::PowFOp>(loc(), base, exp);
 }
 
 Value MathBuilder::min(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     // Test for unsigned as signless are treated as signed.
-    if (lhs.getType().isUnsignedInteger())
+    if (isUnsignedIntegerWithVector(lhs.getType()))
       return b().create<arith::MinUIOp>(loc(), lhs, rhs);
     else
       return b().create<arith::MinSIOp>(loc(), lhs, rhs);
@@ -133,9 +159,9 @@ Value MathBuilder::min(Value lhs, Value rhs) const {
 
 Value MathBuilder::max(Value lhs, Value rhs) const {
   assert(lhs.getType() == rhs.getType() && "expected same type");
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     // Test for unsigned as signless are treated as signed.
-    if (lhs.getType().isUnsignedInteger())
+    if (isUnsignedIntegerWithVector(lhs.getType()))
       return b().create<arith::MaxUIOp>(loc(), lhs, rhs);
     else
       return b().create<arith::MaxSIOp>(loc(), lhs, rhs);
@@ -144,37 +170,37 @@ Value MathBuilder::max(Value lhs, Value rhs) const {
 }
 
 Value MathBuilder::sgt(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::sgt);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::OGT);
 }
 
 Value MathBuilder::sge(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::sge);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::OGE);
 }
 
 Value MathBuilder::slt(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::slt);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::OLT);
 }
 
 Value MathBuilder::sle(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::sle);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::OLE);
 }
 
 Value MathBuilder::eq(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::eq);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::OEQ);
 }
 
 Value MathBuilder::neq(Value lhs, Value rhs) const {
-  if (lhs.getType().isa<IntegerType>() || lhs.getType().isa<IndexType>())
+  if (isIntegerWithVector(lhs.getType()))
     return createArithCmp(lhs, rhs, arith::CmpIPredicate::ne);
   return createArithCmp(lhs, rhs, arith::CmpFPredicate::ONE);
 }
@@ -185,42 +211,37 @@ Value MathBuilder::select(Value cmp, Value lhs, Value rhs) const {
 }
 
 Value MathBuilder::constant(Type type, double val) const {
-  Value constant = nullptr;
-  TypeSwitch<Type>(type)
-      .Case<Float16Type>([&](Type) {
-        constant =
-            b().create<arith::ConstantOp>(loc(), b().getF16FloatAttr(val));
-      })
-      .Case<Float32Type>([&](Type) {
-        constant =
-            b().create<arith::ConstantOp>(loc(), b().getF32FloatAttr(val));
-      })
-      .Case<Float64Type>([&](Type) {
-        constant =
-            b().create<arith::ConstantOp>(loc(), b().getF64FloatAttr(val));
-      })
+  // Vector constants splat the constant of their element type.
+  Type elementType = elementTypeWithVector(type);
+  Attribute constantAttr = nullptr;
+  TypeSwitch<Type>(elementType)
+      .Case<Float16Type>(
+          [&](Type) { constantAttr = b().getF16FloatAttr(val); })
+      .Case<Float32Type>(
+          [&](Type) { constantAttr = b().getF32FloatAttr(val); })
+      .Case<Float64Type>(
+          [&](Type) { constantAttr = b().getF64FloatAttr(val); })
       .Case<IntegerType>([&](IntegerType type) {
         assert(val == (int64_t)val && "value is ambiguous");
         unsigned width = type.getWidth();
 
         if (width == 1)
-          constant =
-              b().create<arith::ConstantOp>(loc(), b().getBoolAttr(val != 0));
+          constantAttr = b().getBoolAttr(val != 0);
         else {
           assert(type.isSignless() &&
                  "arith::ConstantOp requires a signless type.");
-          constant = b().create<arith::ConstantOp>(
-              loc(), b().getIntegerAttr(type, APInt(width, (int64_t)val)));
+          constantAttr = b().getIntegerAttr(type, APInt(width, (int64_t)val));
         }
       })
       .Case<IndexType>([&](Type) {
-        constant =
-            b().create<arith::ConstantOp>(loc(), b().getIntegerAttr(type, val));
+        constantAttr = b().getIntegerAttr(elementType, val);
       })
       .Default([](Type) { llvm_unreachable("unsupported element type"); });
 
-  assert(constant != nullptr && "Expecting valid constant value");
-  return constant;
+  assert(constantAttr != nullptr && "Expecting valid constant value");
+  if (VectorType vecType = type.dyn_cast<VectorType>())
+    constantAttr = DenseElementsAttr::get(vecType, constantAttr);
+  return b().create<arith::ConstantOp>(loc(), constantAttr);
 }
 
 Value MathBuilder::constantIndex(int64_t val) const {
@@ -330,8 +351,10 @@ Value MathBuilder::createArithCmp(
     Value lhs, Value rhs, arith::CmpIPredicate pred) const {
   Type type = lhs.getType();
   assert(type == rhs.getType() && "Operands should have the same type");
-  assert(((type.isa<IntegerType>() && type.isSignlessInteger()) ||
-             type.isa<IndexType>()) &&
+  Type elementType = elementTypeWithVector(type);
+  assert(((elementType.isa<IntegerType>() &&
+              elementType.isSignlessInteger()) ||
+             elementType.isa<IndexType>()) &&
          "Expecting a signless IntegerType or an IndexType");
   return b().create<arith::CmpIOp>(loc(), pred, lhs, rhs);
 }
@@ -340,7 +363,7 @@ Value MathBuilder::createArithCmp(
     Value lhs, Value rhs, arith::CmpFPredicate pred) const {
   Type type = lhs.getType();
   assert(type == rhs.getType() && "Operands should have the same type");
-  assert(type.isa<FloatType>() && "Expecting a FloatType");
+  assert(isFloatWithVector(type) && "Expecting a FloatType");
   return b().create<arith::CmpFOp>(loc(), pred, lhs, rhs);
 }
 
@@ -81,6 +81,14 @@ struct MathBuilder final : DialectBuilder {
   MathBuilder(const DialectBuilder &db) : DialectBuilder(db) {}
   virtual ~MathBuilder() {}
 
+  // Support for vectors: the arithmetic methods below accept scalar values as
+  // well as vectors of scalars, dispatching on the element type of vectors.
+  // Constants of vector types are splatted.
+  static mlir::Type elementTypeWithVector(mlir::Type elementOrVectorType);
+  static bool isIntegerWithVector(mlir::Type elementOrVectorType);
+  static bool isUnsignedIntegerWithVector(mlir::Type elementOrVectorType);
+  static bool isFloatWithVector(mlir::Type elementOrVectorType);
+
   mlir::Value abs(mlir::Value val) const;
 
   mlir::Value andi(mlir::Value lhs, mlir::Value rhs) const;
@@ -10,6 +10,7 @@
 
 #include "src/Dialect/ONNX/ElementsAttr/DisposableElementsAttr.hpp"
 #include "src/Dialect/ONNX/ElementsAttr/DisposableElementsAttributeStorage.hpp"
+#include "src/Dialect/ONNX/ElementsAttr/ElementsAttrHelper.hpp"
 
 #include "src/Dialect/ONNX/ElementsAttr/Strides.hpp"
 
@@ -140,7 +141,9 @@ void DisposableElementsAttr::readWideNums(MutableArrayRef<WideNum> dst) const {
     return;
   }
   ArrayBuffer<WideNum> src = getBufferAsWideNums();
-  restrideArray<WideNum>(getShape(), getStrides(), src.get(), dst);
+  parallelRestrideArray(getContext(), sizeof(WideNum), getShape(),
+      getStrides(), castArrayRef<char>(src.get()),
+      castMutableArrayRef<char>(dst));
 }
 
 DenseElementsAttr DisposableElementsAttr::toDenseElementsAttr() const {
@@ -180,12 +183,13 @@ void DisposableElementsAttr::printAsDenseElementsAttr(
     // only slow but also defeats the garbage collection benefits of
     // DisposableElementsAttr, depending on when the printing
     // takes place (the print at the end of onnx-mlir-opt in lit tests is ok
-    // but the print in ONNXOpTransformPass::createTagForIR() is bad).
+    // but prints between passes, e.g. with --mlir-print-ir-after-all, are
+    // bad).
     printer.printAttribute(toDenseElementsAttr());
     // TODO: Do the work to print without constructing DenseElementsAttr.
   } else {
     // This special case is easy and by avoiding conversion to DenseElementsAttr
-    // we save a lot of time in ONNXOpTransformPass::createTagForIR() if we set:
+    // we save a lot of time when printing the IR if we set:
     // --mlir-elide-elementsattrs-if-larger=1
     printer << "dense<__elided__> : " << getType();
   }
@@ -193,9 +197,20 @@ void DisposableElementsAttr::printAsDenseElementsAttr(
 
 void DisposableElementsAttr::readBytesAsWideNums(
     ArrayRef<char> srcBytes, llvm::MutableArrayRef<WideNum> dst) const {
-  widenArray(getBufferBType(), srcBytes, dst);
-  if (const Transformer &transformer = getTransformer())
-    transformer(dst);
+  // Transformers are element-wise, so slices of the elements can be widened
+  // and transformed in parallel.
+  BType bufferBType = getBufferBType();
+  unsigned bufBytewidth = getBufferElementBytewidth();
+  const Transformer &transformer = getTransformer();
+  parallelForChunks(getContext(), dst.size(), kMinParallelElements,
+      [&](size_t begin, size_t end) {
+        MutableArrayRef<WideNum> dstSlice = dst.slice(begin, end - begin);
+        widenArray(bufferBType,
+            srcBytes.slice(begin * bufBytewidth, (end - begin) * bufBytewidth),
+            dstSlice);
+        if (transformer)
+          transformer(dstSlice);
+      });
 }
 
 ArrayRef<char> DisposableElementsAttr::getBufferBytes() const {
@@ -237,7 +252,8 @@ void DisposableElementsAttr::readRawBytes(
   unsigned elemBytewidth = bytewidthOfBType(btype);
   if (!isTransformedOrCast()) {
     auto srcBytes = getBufferBytes();
-    restrideArray(elemBytewidth, getShape(), getStrides(), srcBytes, dstBytes);
+    parallelRestrideArray(getContext(), elemBytewidth, getShape(),
+        getStrides(), srcBytes, dstBytes);
   } else if (elemBytewidth == sizeof(WideNum)) {
     readWideNums(castMutableArrayRef<WideNum>(dstBytes));
   } else {
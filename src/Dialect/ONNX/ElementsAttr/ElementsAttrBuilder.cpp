@@ -130,6 +130,32 @@ ElementsAttrBuilder::Transformer composeTransforms(
       snd(dst);
     };
 }
+
+// Calls fun(begin, offset, sliceShape) in parallel for slices
+// [begin, begin + n) of the outermost dimension of shape, where offset is the
+// flat index of the first element of the slice and sliceShape is shape with n
+// in place of the outermost dimension.
+void parallelForOuterSlices(MLIRContext *context, ArrayRef<int64_t> shape,
+    function_ref<void(int64_t, int64_t, ArrayRef<int64_t>)> fun) {
+  if (shape.empty())
+    return fun(0, 0, shape);
+  int64_t rowSize = ShapedType::getNumElements(shape.drop_front());
+  size_t minRows = kMinParallelElements / std::max<int64_t>(rowSize, 1);
+  parallelForChunks(context, shape[0], minRows, [&](size_t begin, size_t end) {
+    SmallVector<int64_t, 4> sliceShape(shape.begin(), shape.end());
+    sliceShape[0] = end - begin;
+    fun(begin, begin * rowSize, sliceShape);
+  });
+}
+
+// Returns the elements of src from index begin in the outermost dimension.
+template <typename T>
+StridedArrayRef<T> dropOuterRows(StridedArrayRef<T> src, int64_t begin) {
+  if (src.strides.empty())
+    return src;
+  return StridedArrayRef<T>(
+      src.drop_front(begin * src.strides[0]), src.strides);
+}
 } // namespace
 
 // TODO: Inline this implementation to help the compiler inline fun into the
@@ -181,9 +207,15 @@ ElementsAttr ElementsAttrBuilder::combine(ElementsAttr lhs, ElementsAttr rhs,
       getWideNumsAndExpandedStrides(rhs, combinedShape, xpRhsStrides);
   StridedArrayRef<WideNum> stridedRhs(rhsNums.get(), xpRhsStrides);
 
+  MLIRContext *context = disposablePool.getContext();
   return fromWideNums(combinedType, [&](MutableArrayRef<WideNum> dstNums) {
-    mapStrides<WideNum, WideNum, WideNum>(
-        combinedShape, dstNums, stridedLhs, stridedRhs, combiner);
+    parallelForOuterSlices(context, combinedShape,
+        [&](int64_t begin, int64_t offset, ArrayRef<int64_t> sliceShape) {
+          mapStrides<WideNum, WideNum, WideNum>(sliceShape,
+              dstNums.slice(offset, ShapedType::getNumElements(sliceShape)),
+              dropOuterRows(stridedLhs, begin),
+              dropOuterRows(stridedRhs, begin), combiner);
+        });
   });
 }
 
@@ -222,15 +254,25 @@ ElementsAttr ElementsAttrBuilder::where(ElementsAttr cond, ElementsAttr lhs,
       getWideNumsAndExpandedStrides(rhs, combinedShape, xpRhsStrides);
   StridedArrayRef<WideNum> stridedRhs(rhsNums.get(), xpRhsStrides);
 
+  MLIRContext *context = disposablePool.getContext();
   return fromWideNums(combinedType, [&](MutableArrayRef<WideNum> dstNums) {
     // Copy cond into dstNums with broadcast.
-    restrideArray<WideNum>(
-        combinedShape, xpCondStrides, condNums.get(), dstNums);
-
-    WideNum *end = traverseStrides<WideNum *, WideNum, WideNum>(combinedShape,
-        dstNums.begin(), stridedLhs, stridedRhs,
-        [](WideNum *res, WideNum x, WideNum y) { *res = res->u64 ? x : y; });
-    assert(end == dstNums.end() && "traverses every dstNums element");
+    parallelRestrideArray(context, sizeof(WideNum), combinedShape,
+        xpCondStrides, castArrayRef<char>(condNums.get()),
+        castMutableArrayRef<char>(dstNums));
+
+    parallelForOuterSlices(context, combinedShape,
+        [&](int64_t begin, int64_t offset, ArrayRef<int64_t> sliceShape) {
+          MutableArrayRef<WideNum> dstSlice =
+              dstNums.slice(offset, ShapedType::getNumElements(sliceShape));
+          WideNum *end = traverseStrides<WideNum *, WideNum, WideNum>(
+              sliceShape, dstSlice.begin(), dropOuterRows(stridedLhs, begin),
+              dropOuterRows(stridedRhs, begin),
+              [](WideNum *res, WideNum x, WideNum y) {
+                *res = res->u64 ? x : y;
+              });
+          assert(end == dstSlice.end() && "traverses every dstNums element");
+        });
   });
 }
 
@@ -330,7 +372,8 @@ ElementsAttr ElementsAttrBuilder::reshape(
     return fromRawBytes(
         reshapedType, disp.getBufferBType(), [disp](MutableArrayRef<char> dst) {
           auto src = disp.getBufferBytes();
-          restrideArray(disp.getBufferElementBytewidth(), disp.getShape(),
+          parallelRestrideArray(disp.getContext(),
+              disp.getBufferElementBytewidth(), disp.getShape(),
               disp.getStrides(), src, dst);
         });
 
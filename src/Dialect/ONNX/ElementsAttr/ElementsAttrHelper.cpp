@@ -12,8 +12,10 @@
 
 #include "src/Dialect/ONNX/ElementsAttr/BType.hpp"
 #include "src/Dialect/ONNX/ElementsAttr/DisposableElementsAttr.hpp"
+#include "src/Dialect/ONNX/ElementsAttr/Strides.hpp"
 
 #include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Threading.h"
 
 #include <algorithm>
 
@@ -77,4 +79,38 @@ void readElementsWideNums(ElementsAttr elms, MutableArrayRef<WideNum> dst) {
   readDenseElementsWideNums(elms, dst);
 }
 
+void parallelForChunks(MLIRContext *context, size_t size,
+    size_t minChunkSize, function_ref<void(size_t, size_t)> fun) {
+  size_t numChunks = size / std::max<size_t>(minChunkSize, 1);
+  if (numChunks <= 1 || !context->isMultithreadingEnabled())
+    return fun(0, size);
+  size_t chunkSize = (size + numChunks - 1) / numChunks;
+  parallelFor(context, 0, numChunks, [&](size_t chunk) {
+    size_t begin = chunk * chunkSize;
+    if (begin < size)
+      fun(begin, std::min(size, begin + chunkSize));
+  });
+}
+
+void parallelRestrideArray(MLIRContext *context, unsigned elementBytewidth,
+    ArrayRef<int64_t> shape, ArrayRef<int64_t> srcStrides, ArrayRef<char> src,
+    MutableArrayRef<char> dst) {
+  if (shape.empty())
+    return restrideArray(elementBytewidth, shape, srcStrides, src, dst);
+  auto xpSrcStrides = expandStrides(srcStrides, shape);
+  size_t rowBytes =
+      ShapedType::getNumElements(shape.drop_front()) * elementBytewidth;
+  size_t minRows =
+      kMinParallelElements * elementBytewidth / std::max<size_t>(rowBytes, 1);
+  parallelForChunks(
+      context, shape[0], minRows, [&](size_t begin, size_t end) {
+        SmallVector<int64_t, 4> sliceShape(shape.begin(), shape.end());
+        sliceShape[0] = end - begin;
+        size_t srcOffset = begin * xpSrcStrides[0] * elementBytewidth;
+        restrideArray(elementBytewidth, sliceShape, xpSrcStrides,
+            src.drop_front(srcOffset),
+            dst.slice(begin * rowBytes, (end - begin) * rowBytes));
+      });
+}
+
 } // namespace onnx_mlir
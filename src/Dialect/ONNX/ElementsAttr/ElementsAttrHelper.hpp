@@ -16,6 +16,7 @@
 
 #include "mlir/IR/BuiltinAttributeInterfaces.h"
 #include "mlir/IR/BuiltinAttributes.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 
 #include <algorithm>
 
@@ -47,6 +48,22 @@ ArrayBuffer<WideNum> getElementsWideNums(mlir::ElementsAttr elms);
 void readElementsWideNums(
     mlir::ElementsAttr elms, llvm::MutableArrayRef<WideNum> dst);
 
+// Calls fun on consecutive subranges [begin, end) which partition [0, size),
+// in parallel on the thread pool of context when multi-threading is enabled.
+// Subranges have at least minChunkSize entries, except if size is smaller.
+void parallelForChunks(mlir::MLIRContext *context, size_t size,
+    size_t minChunkSize, llvm::function_ref<void(size_t, size_t)> fun);
+
+// Like restrideArray() in Strides.hpp, but unpacks slices of the outermost
+// dimension in parallel with parallelForChunks().
+void parallelRestrideArray(mlir::MLIRContext *context,
+    unsigned elementBytewidth, llvm::ArrayRef<int64_t> shape,
+    llvm::ArrayRef<int64_t> srcStrides, llvm::ArrayRef<char> src,
+    llvm::MutableArrayRef<char> dst);
+
+// Minimum number of elements processed by each thread in parallelForChunks().
+constexpr size_t kMinParallelElements = 1 << 14;
+
 // Include template implementations.
 #include "ElementsAttrHelper.hpp.inc"
 
@@ -22,4 +22,13 @@ const std::string LAYOUT_NCHW4C = "NCHW4C";
 const std::string LAYOUT_KCMN4C4K = "KCMN4C4K";
 const std::string LAYOUT_STANDARD = "STANDARD";
 
+/// Attribute set by the ConvOpt pass on convolutions to select the algorithm
+/// of their CPU lowering, and its values. Convolutions without it use the
+/// direct algorithm.
+const std::string CONV_ALGORITHM_ATTR = "conv_algorithm";
+const std::string CONV_ALGORITHM_DIRECT = "DIRECT";
+const std::string CONV_ALGORITHM_IM2COL = "IM2COL";
+const std::string CONV_ALGORITHM_WINOGRAD_2X2 = "WINOGRAD_2X2";
+const std::string CONV_ALGORITHM_WINOGRAD_4X4 = "WINOGRAD_4X4";
+
 } // namespace onnx_mlir
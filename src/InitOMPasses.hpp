@@ -37,6 +37,10 @@ void initOMPasses(int optLevel) {
     return createConvOptONNXToONNXPass();
   });
 
+  mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
+    return createONNXLayoutPropagationPass();
+  });
+
   mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
     return createShapeInferencePass();
   });
@@ -68,12 +72,17 @@ void initOMPasses(int optLevel) {
     return krnl::createKrnlOptimizeMemoryPoolsPass();
   });
 
+  mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
+    return krnl::createKrnlPlanStaticMemoryPass();
+  });
+
   mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
     return krnl::createConvertKrnlToAffinePass();
   });
 
   mlir::registerPass([optLevel]() -> std::unique_ptr<mlir::Pass> {
-    return createLowerToKrnlPass(optLevel, /* enableParallel */ false);
+    return createLowerToKrnlPass(optLevel, /* enableSIMD */ false,
+        /* enableFusion */ false, /* enableParallel */ false);
   });
 
   mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
@@ -88,6 +97,10 @@ void initOMPasses(int optLevel) {
     return krnl::createLowerKrnlRegionPass();
   });
 
+  mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
+    return krnl::createLowerParallelToRuntimePass();
+  });
+
   mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
     return krnl::createConvertKrnlToLLVMPass();
   });
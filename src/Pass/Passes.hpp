@@ -30,15 +30,20 @@ std::unique_ptr<mlir::Pass> createScrubDisposablePass(bool closeAfter = true);
 
 /// Pass for ONNX graph level optimization
 std::unique_ptr<mlir::Pass> createONNXOpTransformPass();
-std::unique_ptr<mlir::Pass> createONNXOpTransformPass(
-    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt);
+std::unique_ptr<mlir::Pass> createONNXOpTransformPass(int threshold,
+    bool report, bool targetCPU, bool enableSimdDataLayoutOpt,
+    bool enableConvAlgorithmSelection);
 
 /// Pass for rewriting inside frontend dialect.
 std::unique_ptr<mlir::Pass> createDecomposeONNXToONNXPass(
     const std::string &target = "");
 
 std::unique_ptr<mlir::Pass> createConvOptONNXToONNXPass(
-    bool enableSimdDataLayoutOpt = false);
+    bool enableSimdDataLayoutOpt = false,
+    bool enableAlgorithmSelection = false);
+
+/// Pass for propagating the NCHWxC layout of convolutions across the graph.
+std::unique_ptr<mlir::Pass> createONNXLayoutPropagationPass();
 
 std::unique_ptr<mlir::Pass> createShapeInferencePass(
     bool analyzeAllFunctions = false);
@@ -66,10 +71,15 @@ std::unique_ptr<mlir::Pass> createONNXPreKrnlVerifyPass();
 
 /// Add pass for lowering to Krnl IR.
 std::unique_ptr<mlir::Pass> createLowerToKrnlPass();
-std::unique_ptr<mlir::Pass> createLowerToKrnlPass(
-    int optLevel, bool enableParallel);
-std::unique_ptr<mlir::Pass> createLowerToKrnlPass(
-    bool emitDealloc, bool enableTiling, bool enableParallel);
+std::unique_ptr<mlir::Pass> createLowerToKrnlPass(int optLevel,
+    bool enableSIMD, bool enableFusion, bool enableParallel);
+/// Cache sizes are in KiB.
+std::unique_ptr<mlir::Pass> createLowerToKrnlPass(int optLevel,
+    bool enableSIMD, bool enableFusion, bool enableParallel, bool enableInPlace,
+    int64_t l1CacheSize, int64_t l2CacheSize, int64_t l3CacheSize);
+std::unique_ptr<mlir::Pass> createLowerToKrnlPass(bool emitDealloc,
+    bool enableTiling, bool enableSIMD, bool enableFusion,
+    bool enableParallel);
 
 #ifdef ONNX_MLIR_ENABLE_MHLO
 /// Add pass for lowering to Mhlo IR.
@@ -98,16 +108,25 @@ std::unique_ptr<mlir::Pass> createKrnlBundleMemoryPoolsPass();
 /// Pass for optimizing memory pools.
 std::unique_ptr<mlir::Pass> createKrnlOptimizeMemoryPoolsPass();
 
+/// Pass for planning the offsets in static memory pools by liveness.
+std::unique_ptr<mlir::Pass> createKrnlPlanStaticMemoryPass();
+std::unique_ptr<mlir::Pass> createKrnlPlanStaticMemoryPass(bool report);
+
 /// Pass for lowering Seq in Krnl dialect.
 std::unique_ptr<mlir::Pass> createConvertSeqToMemrefPass();
 
 /// Pass for lowering krnl.region operation.
 std::unique_ptr<mlir::Pass> createLowerKrnlRegionPass();
 
+/// Pass for lowering parallel loops to calls to the runtime thread pool.
+std::unique_ptr<mlir::Pass> createLowerParallelToRuntimePass();
+
 /// Pass for lowering Krnl dialect to LLVM dialect.
 std::unique_ptr<mlir::Pass> createConvertKrnlToLLVMPass();
 std::unique_ptr<mlir::Pass> createConvertKrnlToLLVMPass(
     bool verifyInputTensors);
+std::unique_ptr<mlir::Pass> createConvertKrnlToLLVMPass(bool verifyInputTensors,
+    bool useScratchArena, bool reuseMemoryPool, bool useOutputBuffers);
 
 } // namespace krnl
 
@@ -32,6 +32,13 @@ const std::string ExecutionSession::_queryEntryPointsName =
     "omQueryEntryPoints";
 const std::string ExecutionSession::_inputSignatureName = "omInputSignature";
 const std::string ExecutionSession::_outputSignatureName = "omOutputSignature";
+const std::string ExecutionSession::_setNumThreadsName = "omSetNumThreads";
+const std::string ExecutionSession::_setMemoryPoolBufferName =
+    "omMemoryPoolSetBuffer";
+const std::string ExecutionSession::_getMemoryPoolMaxSizeName =
+    "omMemoryPoolGetMaxSize";
+const std::string ExecutionSession::_entryPointWithOutputsSuffix =
+    "_with_outputs";
 
 ExecutionSession::ExecutionSession(
     std::string sharedLibPath, bool defaultEntryPoint) {
@@ -58,6 +65,18 @@ ExecutionSession::ExecutionSession(
       _sharedLibraryHandle.getAddressOfSymbol(_outputSignatureName.c_str()));
   if (!_outputSignatureFunc)
     throw std::runtime_error(reportSymbolLoadingError(_outputSignatureName));
+
+  // Optional, the thread pool is not linked in models without parallel loops.
+  _setNumThreadsFunc = reinterpret_cast<setNumThreadsFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(_setNumThreadsName.c_str()));
+
+  // Optional, the memory pools are only linked in models reusing them.
+  _setMemoryPoolBufferFunc = reinterpret_cast<setMemoryPoolBufferFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(
+          _setMemoryPoolBufferName.c_str()));
+  _getMemoryPoolMaxSizeFunc = reinterpret_cast<getMemoryPoolMaxSizeFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(
+          _getMemoryPoolMaxSizeName.c_str()));
   errno = 0; // No errors.
 }
 
@@ -72,11 +91,29 @@ void ExecutionSession::setEntryPoint(const std::string &entryPointName) {
   if (!_entryPointFunc)
     throw std::runtime_error(reportSymbolLoadingError(entryPointName));
   _entryPointName = entryPointName;
+  _entryPointWithOutputsFunc = reinterpret_cast<entryPointWithOutputsFuncType>(
+      _sharedLibraryHandle.getAddressOfSymbol(
+          (entryPointName + _entryPointWithOutputsSuffix).c_str()));
+  errno = 0; // No errors.
+}
+
+void ExecutionSession::setMemoryPoolBuffer(void *buffer, int64_t size) {
+  if (_setMemoryPoolBufferFunc && _setMemoryPoolBufferFunc(buffer, size) != 0)
+    throw std::runtime_error(reportErrnoError());
   errno = 0; // No errors.
 }
 
+int64_t ExecutionSession::getMemoryPoolMaxSize() const {
+  return _getMemoryPoolMaxSizeFunc ? _getMemoryPoolMaxSizeFunc() : 0;
+}
+
 std::vector<OMTensorUniquePtr> ExecutionSession::run(
     std::vector<OMTensorUniquePtr> ins) {
+  return run(std::move(ins), {});
+}
+
+std::vector<OMTensorUniquePtr> ExecutionSession::run(
+    std::vector<OMTensorUniquePtr> ins, const std::vector<OMTensor *> &outs) {
   if (!_entryPointFunc)
     throw std::runtime_error(reportUndefinedEntryPointIn("run"));
 
@@ -85,7 +122,16 @@ std::vector<OMTensorUniquePtr> ExecutionSession::run(
     omts.emplace_back(inOmt.get());
   auto *wrappedInput = omTensorListCreate(&omts[0], (int64_t)omts.size());
 
-  auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  // The output list does not own the tensors supplied by the caller.
+  std::vector<OMTensor *> outOmts(outs);
+  OMTensorList *suppliedOutput =
+      outOmts.empty()
+          ? nullptr
+          : omTensorListCreate(&outOmts[0], (int64_t)outOmts.size());
+
+  auto *wrappedOutput = invokeEntryPoint(wrappedInput, suppliedOutput);
+  if (suppliedOutput)
+    omTensorListDestroyShallow(suppliedOutput);
 
   // We created a wrapper for the input list, but the input list does not really
   // own the tensor in the list, as they are coming as OMTensorUniquePtr. So we
@@ -114,6 +160,11 @@ std::vector<OMTensorUniquePtr> ExecutionSession::run(
 // Run using public interface. Explicit calls are needed to free tensor & tensor
 // lists.
 OMTensorList *ExecutionSession::run(OMTensorList *input) {
+  return run(input, nullptr);
+}
+
+OMTensorList *ExecutionSession::run(
+    OMTensorList *input, OMTensorList *output) {
   if (!_entryPointFunc) {
     std::stringstream errStr;
     errStr << "Must set the entry point before calling run function"
@@ -121,8 +172,8 @@ OMTensorList *ExecutionSession::run(OMTensorList *input) {
     errno = EINVAL;
     throw std::runtime_error(errStr.str());
   }
-  OMTensorList *output = _entryPointFunc(input);
-  if (!output) {
+  OMTensorList *result = invokeEntryPoint(input, output);
+  if (!result) {
     std::stringstream errStr;
     std::string errMessageStr = std::string(strerror(errno));
     errStr << "Runtime error during inference returning with ERRNO code '"
@@ -130,7 +181,22 @@ OMTensorList *ExecutionSession::run(OMTensorList *input) {
     throw std::runtime_error(errStr.str());
   }
   errno = 0; // No errors.
-  return output;
+  return result;
+}
+
+OMTensorList *ExecutionSession::invokeEntryPoint(
+    OMTensorList *input, OMTensorList *output) {
+  // The thread pool of a model is shared by all its sessions, apply the
+  // setting of this session before running.
+  if (_setNumThreadsFunc)
+    _setNumThreadsFunc(_numThreads);
+  if (!output)
+    return _entryPointFunc(input);
+  if (_entryPointWithOutputsFunc)
+    return _entryPointWithOutputsFunc(input, output);
+  // The model allocates its outputs, copy them into the supplied tensors.
+  omOutputBuffersBegin(output);
+  return omOutputBuffersEnd(_entryPointFunc(input));
 }
 
 const std::string ExecutionSession::inputSignature() const {
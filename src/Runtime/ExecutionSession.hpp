@@ -25,8 +25,13 @@
 namespace onnx_mlir {
 
 using entryPointFuncType = OMTensorList *(*)(OMTensorList *);
+using entryPointWithOutputsFuncType = OMTensorList *(*)(
+    OMTensorList *, OMTensorList *);
 using queryEntryPointsFuncType = const char **(*)(int64_t *);
 using signatureFuncType = const char *(*)(const char *);
+using setNumThreadsFuncType = void (*)(int64_t);
+using setMemoryPoolBufferFuncType = int (*)(void *, int64_t);
+using getMemoryPoolMaxSizeFuncType = int64_t (*)(void);
 using OMTensorUniquePtr = std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>;
 
 /* ExecutionSession
@@ -41,6 +46,14 @@ using OMTensorUniquePtr = std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>;
  * function.
  * EPERM when the model executed on a machine without a compatible
  * hardware/specialized accelerator.
+ *
+ * Compiled models are re-entrant: run may be called concurrently by several
+ * threads on a single session, each with its own inputs and outputs. The
+ * settings of the session (entry point and number of threads) must not be
+ * changed while it runs, and the number of threads applies to all the
+ * sessions of a model. Models compiled with --scratch-arena allocate their
+ * internal buffers from per-thread arenas, so that concurrent runs do not
+ * contend on the allocator.
  */
 class ExecutionSession {
 public:
@@ -59,6 +72,25 @@ public:
   // defaultEntryPoint is false or there are multiple entry points in the model.
   void setEntryPoint(const std::string &entryPointName);
 
+  // Set the number of threads running the parallel loops of the model when
+  // this session runs it. A value smaller than 1 selects the default, given by
+  // the ONNX_MLIR_NUM_THREADS environment variable or the number of online
+  // processors. Models compiled without parallel loops ignore this setting.
+  void setNumThreads(int64_t numThreads) { _numThreads = numThreads; }
+  int64_t getNumThreads() const { return _numThreads; }
+
+  // Supply the memory of the memory pool of the model, which is then not
+  // allocated by the runtime. The buffer is owned by the caller, and is used
+  // by one run at a time; concurrent runs use memory pools allocated by the
+  // runtime. A NULL buffer stops using the buffer. Only models compiled with
+  // --reuse-memory-pool use the buffer, other models ignore it. The buffer
+  // applies to all the sessions of a model, and cannot be replaced while a
+  // run uses it (EBUSY).
+  void setMemoryPoolBuffer(void *buffer, int64_t size);
+  // Get the size of the buffer able to hold the largest memory pool used by
+  // the runs so far, or 0 for models compiled without --reuse-memory-pool.
+  int64_t getMemoryPoolMaxSize() const;
+
   llvm::sys::DynamicLibrary &getSharedLibraryHandle() {
     return _sharedLibraryHandle;
   };
@@ -70,6 +102,16 @@ public:
   // tensor lists.
   OMTensorList *run(OMTensorList *input);
 
+  // Run with outputs written into the buffers of the given tensors, owned by
+  // the caller, when the tensors have the data type and shape of the outputs.
+  // Models compiled with --caller-output-buffers compute the outputs directly
+  // in the buffers; for other models, the outputs are copied into them. The
+  // returned tensors hold the outputs and do not own the buffers of the given
+  // tensors.
+  std::vector<OMTensorUniquePtr> run(
+      std::vector<OMTensorUniquePtr> ins, const std::vector<OMTensor *> &outs);
+  OMTensorList *run(OMTensorList *input, OMTensorList *output);
+
   // Get input and output signature as a Json string. For example for nminst:
   // `[ { "type" : "f32" , "dims" : [1 , 1 , 28 , 28] , "name" : "image" } ]`
   const std::string inputSignature() const;
@@ -78,6 +120,11 @@ public:
   ~ExecutionSession();
 
 protected:
+  // Call the entry point with the settings of this session, and the output
+  // tensors supplied by the caller if output is not NULL.
+  OMTensorList *invokeEntryPoint(
+      OMTensorList *input, OMTensorList *output = nullptr);
+
   // Error reporting processing when throwing runtime errors. Set errno as
   // appropriate.
   std::string reportLibraryOpeningError(const std::string &libraryName) const;
@@ -93,6 +140,10 @@ protected:
   // Entry point function.
   std::string _entryPointName;
   entryPointFuncType _entryPointFunc = nullptr;
+  // Variant of the entry point taking the output tensors, only present in
+  // models compiled with --caller-output-buffers.
+  static const std::string _entryPointWithOutputsSuffix;
+  entryPointWithOutputsFuncType _entryPointWithOutputsFunc = nullptr;
 
   // Query entry point function.
   static const std::string _queryEntryPointsName;
@@ -103,5 +154,17 @@ protected:
   static const std::string _outputSignatureName;
   signatureFuncType _inputSignatureFunc = nullptr;
   signatureFuncType _outputSignatureFunc = nullptr;
+
+  // Thread pool configuration, only present in models with parallel loops.
+  static const std::string _setNumThreadsName;
+  setNumThreadsFuncType _setNumThreadsFunc = nullptr;
+  int64_t _numThreads = 0;
+
+  // Memory pool configuration, only present in models compiled with
+  // --reuse-memory-pool.
+  static const std::string _setMemoryPoolBufferName;
+  static const std::string _getMemoryPoolMaxSizeName;
+  setMemoryPoolBufferFuncType _setMemoryPoolBufferFunc = nullptr;
+  getMemoryPoolMaxSizeFuncType _getMemoryPoolMaxSizeFunc = nullptr;
 };
 } // namespace onnx_mlir
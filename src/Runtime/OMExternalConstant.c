@@ -0,0 +1,15 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===- OMExternalConstant.c - OMExternalConstant C Implementation ---------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains implementation of the OMExternalConstant functions.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OMExternalConstant.inc"
@@ -0,0 +1,15 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- OMOutputBuffers.c - OMOutputBuffers C Implementation --------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains implementation of the OMOutputBuffers functions.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OMOutputBuffers.inc"
@@ -45,6 +45,8 @@ PYBIND11_MODULE(PyRuntime, m) {
       .def("set_entry_point", &onnx_mlir::PyExecutionSession::pySetEntryPoint,
           py::arg("name"))
       .def("run", &onnx_mlir::PyExecutionSession::pyRun, py::arg("input"))
+      .def("set_num_threads", &onnx_mlir::PyExecutionSession::setNumThreads,
+          py::arg("num_threads"))
       .def("input_signature", &onnx_mlir::PyExecutionSession::pyInputSignature)
       .def("output_signature",
           &onnx_mlir::PyExecutionSession::pyOutputSignature);
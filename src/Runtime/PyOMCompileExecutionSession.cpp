@@ -135,7 +135,7 @@ std::vector<py::array> PyOMCompileExecutionSession::pyRun(
   }
 
   auto *wrappedInput = omTensorListCreate(&omts[0], omts.size());
-  auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  auto *wrappedOutput = invokeEntryPoint(wrappedInput);
   if (!wrappedOutput)
     throw std::runtime_error(reportErrnoError());
   std::vector<py::array> outputPyArrays;
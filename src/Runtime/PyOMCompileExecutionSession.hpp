@@ -70,6 +70,9 @@ PYBIND11_MODULE(PyCompileAndRuntime, m) {
           py::arg("name"))
       .def("run", &onnx_mlir::PyOMCompileExecutionSession::pyRun,
           py::arg("input"))
+      .def("set_num_threads",
+          &onnx_mlir::PyOMCompileExecutionSession::setNumThreads,
+          py::arg("num_threads"))
       .def("input_signature",
           &onnx_mlir::PyOMCompileExecutionSession::pyInputSignature)
       .def("output_signature",
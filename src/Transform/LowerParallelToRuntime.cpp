@@ -0,0 +1,274 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- LowerParallelToRuntime.cpp ------------------------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This pass lowers scf.parallel loops into calls to the onnx-mlir runtime
+// thread pool (omParallelFor, see src/Runtime/OMThreadPool.inc).
+//
+// The body of each outermost parallel loop is outlined into a function with
+// the signature `void(int64_t begin, int64_t end, void *ctx)`, which executes
+// the iterations [begin, end) of the linearized iteration space. Values
+// defined above the loop are passed to the outlined function through a
+// context structure allocated on the stack of the caller. Constants are
+// cloned into the outlined function instead. The call to the runtime is
+// nested in an scf.execute_region that keeps the captured buffers alive until
+// the parallel loop completes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Analysis/DataLayoutAnalysis.h"
+#include "mlir/Conversion/LLVMCommon/TypeConverter.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/BlockAndValueMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/RegionUtils.h"
+#include "llvm/ADT/SetVector.h"
+
+#include "src/Dialect/Mlir/DialectBuilder.hpp"
+#include "src/Pass/Passes.hpp"
+
+using namespace mlir;
+
+namespace {
+
+/// Name of the runtime function executing a parallel loop.
+static const char *PARALLEL_FOR_API = "omParallelFor";
+
+/*!
+ *  Module pass that lowers scf.parallel operations to runtime calls.
+ */
+class LowerParallelToRuntimePass
+    : public PassWrapper<LowerParallelToRuntimePass, OperationPass<ModuleOp>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(LowerParallelToRuntimePass)
+
+  StringRef getArgument() const override {
+    return "lower-parallel-to-runtime";
+  }
+
+  StringRef getDescription() const override {
+    return "Outline scf.parallel loops and run them with the onnx-mlir "
+           "runtime thread pool";
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, LLVM::LLVMDialect, scf::SCFDialect>();
+  }
+
+  void runOnOperation() override;
+
+private:
+  LogicalResult lowerParallelOp(scf::ParallelOp parallelOp,
+      LLVMTypeConverter &typeConverter, int64_t &outlinedCounter);
+};
+
+void LowerParallelToRuntimePass::runOnOperation() {
+  ModuleOp module = getOperation();
+  MLIRContext *ctx = &getContext();
+  // Use the same type conversion as the lowering to LLVM so that the casts
+  // introduced here are reconciled by that lowering.
+  const auto &dataLayoutAnalysis = getAnalysis<DataLayoutAnalysis>();
+  LowerToLLVMOptions options(ctx, dataLayoutAnalysis.getAtOrAbove(module));
+  LLVMTypeConverter typeConverter(ctx, options);
+
+  // Only outermost parallel loops are outlined. Nested parallel loops end up
+  // in the outlined functions and are executed sequentially by each thread.
+  SmallVector<scf::ParallelOp, 4> parallelOps;
+  module.walk([&](scf::ParallelOp parallelOp) {
+    if (!parallelOp->getParentOfType<scf::ParallelOp>())
+      parallelOps.emplace_back(parallelOp);
+  });
+
+  int64_t outlinedCounter = 0;
+  for (scf::ParallelOp parallelOp : parallelOps)
+    if (failed(lowerParallelOp(parallelOp, typeConverter, outlinedCounter)))
+      return signalPassFailure();
+}
+
+LogicalResult LowerParallelToRuntimePass::lowerParallelOp(
+    scf::ParallelOp parallelOp, LLVMTypeConverter &typeConverter,
+    int64_t &outlinedCounter) {
+  // Loops with reductions are left to the sequential lowering.
+  if (!parallelOp.getInitVals().empty())
+    return success();
+
+  Location loc = parallelOp.getLoc();
+  MLIRContext *ctx = parallelOp.getContext();
+  auto parentFunc = parallelOp->getParentOfType<func::FuncOp>();
+  ModuleOp module = parallelOp->getParentOfType<ModuleOp>();
+  if (!parentFunc || !module)
+    return success();
+
+  OpBuilder b(parallelOp);
+  onnx_mlir::MultiDialectBuilder<onnx_mlir::MathBuilder, onnx_mlir::LLVMBuilder>
+      create(b, loc);
+  Type indexTy = b.getIndexType();
+  Type i64Ty = b.getI64Type();
+  Type i8PtrTy = LLVM::LLVMPointerType::get(b.getI8Type());
+
+  // Compute the trip count of each parallel dimension and the total number of
+  // iterations of the linearized iteration space.
+  SmallVector<Value, 4> lbs(parallelOp.getLowerBound());
+  SmallVector<Value, 4> steps(parallelOp.getStep());
+  SmallVector<Value, 4> tripCounts;
+  Value numIterations = create.math.constantIndex(1);
+  for (auto [lb, ub, step] :
+      llvm::zip(lbs, parallelOp.getUpperBound(), steps)) {
+    Value tripCount = b.createOrFold<arith::CeilDivSIOp>(
+        loc, b.createOrFold<arith::SubIOp>(loc, ub, lb), step);
+    tripCount = b.createOrFold<arith::MaxSIOp>(
+        loc, tripCount, create.math.constantIndex(0));
+    tripCounts.emplace_back(tripCount);
+    numIterations =
+        b.createOrFold<arith::MulIOp>(loc, numIterations, tripCount);
+  }
+
+  // Values used by the loop body but defined outside of it, including the
+  // loop bounds. Constants are rematerialized inside the outlined function.
+  llvm::SetVector<Value> usedValues;
+  getUsedValuesDefinedAbove(parallelOp.getRegion(), usedValues);
+  usedValues.insert(lbs.begin(), lbs.end());
+  usedValues.insert(steps.begin(), steps.end());
+  usedValues.insert(tripCounts.begin(), tripCounts.end());
+  SmallVector<Value, 8> constants, captures;
+  SmallVector<Type, 8> captureTypes;
+  for (Value val : usedValues) {
+    if (matchPattern(val, m_Constant())) {
+      constants.emplace_back(val);
+      continue;
+    }
+    Type convertedType = typeConverter.convertType(val.getType());
+    // Leave the loop sequential when a value cannot be passed to the outlined
+    // function.
+    if (!convertedType || !LLVM::isCompatibleType(convertedType))
+      return success();
+    captures.emplace_back(val);
+    captureTypes.emplace_back(convertedType);
+  }
+  Type contextTy = LLVM::LLVMStructType::getLiteral(ctx, captureTypes);
+  Type contextPtrTy = LLVM::LLVMPointerType::get(contextTy);
+
+  // Create the outlined function.
+  std::string outlinedName;
+  do {
+    outlinedName = (parentFunc.getName() + "_parallel_" +
+                    std::to_string(outlinedCounter++))
+                       .str();
+  } while (module.lookupSymbol(outlinedName));
+  auto outlinedType = b.getFunctionType({i64Ty, i64Ty, i8PtrTy}, {});
+  func::FuncOp outlinedFunc;
+  {
+    OpBuilder::InsertionGuard guard(b);
+    b.setInsertionPoint(parentFunc);
+    outlinedFunc = b.create<func::FuncOp>(loc, outlinedName, outlinedType);
+    outlinedFunc.setPrivate();
+    Block *entryBlock = outlinedFunc.addEntryBlock();
+    b.setInsertionPointToStart(entryBlock);
+
+    // Unpack the context.
+    BlockAndValueMapping mapper;
+    for (Value val : constants)
+      mapper.map(val, b.clone(*val.getDefiningOp())->getResult(0));
+    if (!captures.empty()) {
+      Value contextPtr =
+          create.llvm.bitcast(contextPtrTy, entryBlock->getArgument(2));
+      Value context = create.llvm.load(contextPtr);
+      for (int64_t i = 0, e = captures.size(); i < e; ++i) {
+        Value field = create.llvm.extractValue(captureTypes[i], context, {i});
+        mapper.map(captures[i], b.create<UnrealizedConversionCastOp>(
+                                      loc, captures[i].getType(), field)
+                                    .getResult(0));
+      }
+    }
+
+    // Iterate over [begin, end) and recover the parallel induction variables
+    // from the linearized index, innermost dimension first.
+    Value begin = create.math.cast(indexTy, entryBlock->getArgument(0));
+    Value end = create.math.cast(indexTy, entryBlock->getArgument(1));
+    auto forOp =
+        b.create<scf::ForOp>(loc, begin, end, create.math.constantIndex(1));
+    b.setInsertionPointToStart(forOp.getBody());
+    Value linearIndex = forOp.getInductionVar();
+    ValueRange ivs = parallelOp.getInductionVars();
+    for (int64_t d = ivs.size() - 1; d >= 0; --d) {
+      Value tripCount = mapper.lookup(tripCounts[d]);
+      Value index = linearIndex;
+      if (d > 0) {
+        index = b.create<arith::RemSIOp>(loc, linearIndex, tripCount);
+        linearIndex = create.math.div(linearIndex, tripCount);
+      }
+      Value iv = create.math.add(mapper.lookup(lbs[d]),
+          create.math.mul(index, mapper.lookup(steps[d])));
+      mapper.map(ivs[d], iv);
+    }
+    for (Operation &op : parallelOp.getBody()->without_terminator())
+      b.clone(op, mapper);
+
+    b.setInsertionPointToEnd(entryBlock);
+    b.create<func::ReturnOp>(loc);
+  }
+
+  // Pack the context and call the runtime in a region, so that the region
+  // is the last use of the captured buffers in the parent block: the casts
+  // packing them are not memref uses for the buffer deallocation pass, which
+  // would otherwise free them before the call. The context is allocated in
+  // the entry block so that parallel loops nested in sequential loops do not
+  // grow the stack.
+  auto executeOp = b.create<scf::ExecuteRegionOp>(loc, TypeRange());
+  b.setInsertionPointToStart(&executeOp.getRegion().emplaceBlock());
+  Value contextPtr = create.llvm.nullI8Ptr();
+  if (!captures.empty()) {
+    Value contextAlloca;
+    {
+      OpBuilder::InsertionGuard guard(b);
+      b.setInsertionPointToStart(&parentFunc.getBody().front());
+      contextAlloca = create.llvm._alloca(contextPtrTy,
+          create.llvm.constant(i64Ty, (int64_t)1), /*alignment=*/0);
+    }
+    Value context = b.create<LLVM::UndefOp>(loc, contextTy);
+    for (int64_t i = 0, e = captures.size(); i < e; ++i) {
+      Value field = b.create<UnrealizedConversionCastOp>(
+                         loc, captureTypes[i], captures[i])
+                        .getResult(0);
+      context = create.llvm.insertValue(contextTy, context, field, {i});
+    }
+    create.llvm.store(context, contextAlloca);
+    contextPtr = create.llvm.bitcastI8Ptr(contextAlloca);
+  }
+  Type outlinedPtrTy = typeConverter.convertType(outlinedType);
+  Value outlinedPtr = b.create<UnrealizedConversionCastOp>(loc, outlinedPtrTy,
+                           b.create<func::ConstantOp>(loc, outlinedType,
+                                SymbolRefAttr::get(outlinedFunc))
+                               .getResult())
+                          .getResult(0);
+  FlatSymbolRefAttr parallelForRef =
+      create.llvm.getOrInsertSymbolRef(module, PARALLEL_FOR_API,
+          LLVM::LLVMVoidType::get(ctx), {outlinedPtrTy, i64Ty, i8PtrTy});
+  create.llvm.call({}, parallelForRef,
+      {outlinedPtr, create.math.cast(i64Ty, numIterations), contextPtr});
+  b.create<scf::YieldOp>(loc);
+
+  parallelOp.erase();
+  return success();
+}
+
+} // namespace
+
+namespace onnx_mlir {
+namespace krnl {
+std::unique_ptr<Pass> createLowerParallelToRuntimePass() {
+  return std::make_unique<LowerParallelToRuntimePass>();
+}
+} // namespace krnl
+} // namespace onnx_mlir
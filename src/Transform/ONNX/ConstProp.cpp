@@ -29,6 +29,7 @@
 #include "src/Support/Common.hpp"
 #include "src/Support/TypeUtilities.hpp"
 
+#include <limits>
 #include <math.h>
 #include <numeric>
 #include <unordered_map>
@@ -707,6 +708,504 @@ Value ConstPropReshape(
       .getResult();
 }
 
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for compute ops: MatMul, Gemm, Conv,
+// reductions and Softmax.
+//
+// These ops are only folded if their result has at most kMaxFoldedElements
+// elements and folding them takes at most kMaxFoldedWork multiply-adds (or
+// element visits for reductions and Softmax), to bound compile time and the
+// size of the constants.
+//===----------------------------------------------------------------------===//
+
+constexpr int64_t kMaxFoldedElements = 1 << 20;
+constexpr int64_t kMaxFoldedWork = int64_t(1) << 30;
+
+bool isFoldableComputeOp(Value result) {
+  Operation *op = result.getDefiningOp();
+  int64_t outputSize = getNumberOfElements(result.getType());
+  if (outputSize > kMaxFoldedElements)
+    return false;
+  int64_t work;
+  if (auto matMulOp = dyn_cast<ONNXMatMulOp>(op)) {
+    work = outputSize * getShape(matMulOp.A().getType()).back();
+  } else if (auto gemmOp = dyn_cast<ONNXGemmOp>(op)) {
+    ArrayRef<int64_t> aShape = getShape(gemmOp.A().getType());
+    work = outputSize * (gemmOp.transA() ? aShape[0] : aShape[1]);
+  } else if (auto convOp = dyn_cast<ONNXConvOp>(op)) {
+    ArrayRef<int64_t> wShape = getShape(convOp.W().getType());
+    work = outputSize * ShapedType::getNumElements(wShape.drop_front());
+  } else {
+    work = getNumberOfElements(op->getOperand(0).getType());
+  }
+  return work <= kMaxFoldedWork;
+}
+
+// Calls act with a zero of the wide type (double, int64_t, or uint64_t)
+// of elemType, whose WideNum field holds the values of that element type.
+template <typename Action>
+void dispatchByWideType(Type elemType, Action &&act) {
+  switch (wideBTypeOfBType(btypeOfMlirType(elemType))) {
+  case BType::DOUBLE:
+    return act(double(0));
+  case BType::INT64:
+    return act(int64_t(0));
+  case BType::UINT64:
+    return act(uint64_t(0));
+  default:
+    llvm_unreachable("unsupported element type");
+  }
+}
+
+// Computes c += a * b for the row-major matrices a (M x K), b (K x N) and
+// c (M x N). The reduction dimension is blocked so that a block of rows of b
+// stays in cache while it is applied to every row of a, and the innermost
+// loop runs over contiguous elements of b and c so that it vectorizes.
+template <typename T>
+void matMulAccumulate(
+    const T *a, const T *b, T *c, int64_t M, int64_t N, int64_t K) {
+  constexpr int64_t kBlockK = 64;
+  for (int64_t k0 = 0; k0 < K; k0 += kBlockK) {
+    int64_t k1 = std::min(K, k0 + kBlockK);
+    for (int64_t i = 0; i < M; ++i) {
+      T *cRow = c + i * N;
+      for (int64_t k = k0; k < k1; ++k) {
+        T aik = a[i * K + k];
+        const T *bRow = b + k * N;
+        for (int64_t j = 0; j < N; ++j)
+          cRow[j] += aik * bRow[j];
+      }
+    }
+  }
+}
+
+// Computes the batched matrix products c = a * b of row-major matrices a
+// (batchSize x M x K), b (batchSize x K x N) and c (batchSize x M x N), in
+// parallel over blocks of rows of a and c.
+template <typename T>
+void matMulBatch(MLIRContext *context, ArrayRef<T> a, ArrayRef<T> b,
+    MutableArrayRef<T> c, int64_t batchSize, int64_t M, int64_t N,
+    int64_t K) {
+  std::fill(c.begin(), c.end(), T(0));
+  size_t minRows = kMinParallelElements / std::max<int64_t>(N * K, 1);
+  parallelForChunks(
+      context, batchSize * M, minRows, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end;) {
+          int64_t batch = row / M;
+          int64_t rows = std::min<int64_t>(M - row % M, end - row);
+          matMulAccumulate(a.data() + row * K, b.data() + batch * K * N,
+              c.data() + row * N, rows, N, K);
+          row += rows;
+        }
+      });
+}
+
+Value ConstPropMatMul(PatternRewriter &rewriter, Value replacingValue,
+    Value lhsValue, Value rhsValue) {
+  ConstPropCounters::count("MatMul", {lhsValue, rhsValue});
+  ShapedType outputType = replacingValue.getType().cast<ShapedType>();
+  ElementsAttr lhs = getConstValueElements(lhsValue);
+  ElementsAttr rhs = getConstValueElements(rhsValue);
+
+  // Promote 1-D operands to matrices and broadcast the batch dimensions.
+  SmallVector<int64_t, 4> lhsShape(lhs.getType().getShape());
+  SmallVector<int64_t, 4> rhsShape(rhs.getType().getShape());
+  if (lhsShape.size() == 1)
+    lhsShape.insert(lhsShape.begin(), 1);
+  if (rhsShape.size() == 1)
+    rhsShape.push_back(1);
+  int64_t M = lhsShape[lhsShape.size() - 2];
+  int64_t K = lhsShape.back();
+  int64_t N = rhsShape.back();
+  size_t batchRank = std::max(lhsShape.size(), rhsShape.size()) - 2;
+  SmallVector<int64_t, 4> batchShape(batchRank, 1);
+  for (ArrayRef<int64_t> shape : {lhsShape, rhsShape}) {
+    ArrayRef<int64_t> batchDims = shape.drop_back(2);
+    for (size_t i = 0; i < batchDims.size(); ++i) {
+      int64_t &dim = batchShape[batchRank - batchDims.size() + i];
+      dim = std::max(dim, batchDims[i]);
+    }
+  }
+
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  auto expandToBatch = [&](ElementsAttr elms, ArrayRef<int64_t> shape,
+                           int64_t rows, int64_t cols) {
+    SmallVector<int64_t, 4> expandedShape(batchShape);
+    expandedShape.append({rows, cols});
+    return getElementsWideNums(elementsBuilder.expand(
+        elementsBuilder.reshape(elms, shape), expandedShape));
+  };
+  ArrayBuffer<WideNum> lhsNums = expandToBatch(lhs, lhsShape, M, K);
+  ArrayBuffer<WideNum> rhsNums = expandToBatch(rhs, rhsShape, K, N);
+  int64_t batchSize = ShapedType::getNumElements(batchShape);
+
+  MLIRContext *context = rewriter.getContext();
+  ElementsAttr resultElements = elementsBuilder.fromWideNums(
+      outputType, [&](MutableArrayRef<WideNum> dst) {
+        dispatchByWideType(outputType.getElementType(), [&](auto zero) {
+          using T = decltype(zero);
+          matMulBatch<T>(context, castArrayRef<T>(lhsNums.get()),
+              castArrayRef<T>(rhsNums.get()), castMutableArrayRef<T>(dst),
+              batchSize, M, N, K);
+        });
+      });
+  return createReplacingConstantOp(rewriter, replacingValue, resultElements)
+      .getResult();
+}
+
+Value ConstPropGemm(PatternRewriter &rewriter, Value replacingValue,
+    Value aValue, Value bValue, Value cValue) {
+  ConstPropCounters::count("Gemm", {aValue, bValue, cValue});
+  ONNXGemmOp gemmOp = cast<ONNXGemmOp>(replacingValue.getDefiningOp());
+  ShapedType outputType = replacingValue.getType().cast<ShapedType>();
+  ArrayRef<int64_t> outputShape = outputType.getShape();
+  int64_t M = outputShape[0];
+  int64_t N = outputShape[1];
+
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  ElementsAttr a = getConstValueElements(aValue);
+  ElementsAttr b = getConstValueElements(bValue);
+  if (gemmOp.transA())
+    a = elementsBuilder.transpose(a, {1, 0});
+  if (gemmOp.transB())
+    b = elementsBuilder.transpose(b, {1, 0});
+  int64_t K = a.getType().getShape()[1];
+  ArrayBuffer<WideNum> aNums = getElementsWideNums(a);
+  ArrayBuffer<WideNum> bNums = getElementsWideNums(b);
+  bool hasBias = !isFromNone(cValue);
+  ElementsAttr bias = hasBias ? getConstValueElements(cValue) : nullptr;
+  ArrayBuffer<WideNum> cNums =
+      hasBias ? getElementsWideNums(elementsBuilder.expand(bias, outputShape))
+              : ArrayBuffer<WideNum>();
+  double alpha = gemmOp.alpha().convertToDouble();
+  double beta = gemmOp.beta().convertToDouble();
+
+  MLIRContext *context = rewriter.getContext();
+  ElementsAttr resultElements = elementsBuilder.fromWideNums(
+      outputType, [&](MutableArrayRef<WideNum> dst) {
+        dispatchByWideType(outputType.getElementType(), [&](auto zero) {
+          using T = decltype(zero);
+          MutableArrayRef<T> y = castMutableArrayRef<T>(dst);
+          matMulBatch<T>(context, castArrayRef<T>(aNums.get()),
+              castArrayRef<T>(bNums.get()), y, 1, M, N, K);
+          if (alpha != 1)
+            for (T &v : y)
+              v = static_cast<T>(alpha * v);
+          if (hasBias) {
+            ArrayRef<T> c = castArrayRef<T>(cNums.get());
+            for (int64_t i = 0; i < M * N; ++i)
+              y[i] += static_cast<T>(beta * c[i]);
+          }
+        });
+      });
+  return createReplacingConstantOp(rewriter, replacingValue, resultElements)
+      .getResult();
+}
+
+// Computes one image of a convolution with the filters of one group, as the
+// matrix product of the filters (CO x CI * kernel size) and the columns of
+// the input patches (CI * kernel size x output size).
+void ConstPropConvImpl(MLIRContext *context, ArrayRef<double> image,
+    ArrayRef<int64_t> imageShape, ArrayRef<double> filters,
+    ArrayRef<int64_t> kernelShape, ArrayRef<int64_t> outputShape,
+    ArrayRef<int64_t> pads, ArrayRef<int64_t> strides,
+    ArrayRef<int64_t> dilations, int64_t CI, int64_t CO,
+    MutableArrayRef<double> output) {
+  size_t spatialRank = kernelShape.size();
+  int64_t kernelSize = ShapedType::getNumElements(kernelShape);
+  int64_t outputSize = ShapedType::getNumElements(outputShape);
+  int64_t imageSize = ShapedType::getNumElements(imageShape);
+  std::vector<double> columns(CI * kernelSize * outputSize, 0);
+  SmallVector<int64_t, 4> kernelPos(spatialRank), outputPos(spatialRank);
+  for (int64_t kk = 0; kk < kernelSize; ++kk) {
+    for (int64_t d = spatialRank - 1, r = kk; d >= 0; --d) {
+      kernelPos[d] = r % kernelShape[d];
+      r /= kernelShape[d];
+    }
+    for (int64_t o = 0; o < outputSize; ++o) {
+      int64_t imageIndex = 0;
+      bool inBounds = true;
+      for (int64_t d = spatialRank - 1, r = o; d >= 0; --d) {
+        outputPos[d] = r % outputShape[d];
+        r /= outputShape[d];
+      }
+      for (size_t d = 0; d < spatialRank && inBounds; ++d) {
+        int64_t pos = outputPos[d] * strides[d] - pads[d] +
+                      kernelPos[d] * dilations[d];
+        inBounds = pos >= 0 && pos < imageShape[d];
+        imageIndex = imageIndex * imageShape[d] + pos;
+      }
+      if (!inBounds)
+        continue;
+      for (int64_t ci = 0; ci < CI; ++ci)
+        columns[(ci * kernelSize + kk) * outputSize + o] =
+            image[ci * imageSize + imageIndex];
+    }
+  }
+  matMulBatch<double>(
+      context, filters, columns, output, 1, CO, outputSize, CI * kernelSize);
+}
+
+Value ConstPropConv(PatternRewriter &rewriter, Value replacingValue,
+    Value xValue, Value wValue, Value bValue) {
+  ConstPropCounters::count("Conv", {xValue, wValue, bValue});
+  Operation *op = replacingValue.getDefiningOp();
+  ONNXConvOp convOp = cast<ONNXConvOp>(op);
+
+  // Get pads, strides and dilations via ShapeHelper.
+  ONNXConvOpShapeHelper shapeHelper(op, {});
+  if (failed(shapeHelper.computeShape())) {
+    convOp.emitError("Failed to scan " + ONNXConvOp::getOperationName() +
+                     " parameters successfully");
+    return nullptr;
+  }
+  size_t spatialRank = shapeHelper.kernelShape.size();
+  SmallVector<int64_t, 4> pads;
+  for (size_t d = 0; d < spatialRank; ++d)
+    pads.emplace_back(shapeHelper.pads[d].getLiteral());
+
+  ShapedType outputType = replacingValue.getType().cast<ShapedType>();
+  ArrayRef<int64_t> outputShape = outputType.getShape();
+  ArrayRef<int64_t> xShape = getShape(xValue.getType());
+  ArrayRef<int64_t> wShape = getShape(wValue.getType());
+  int64_t G = convOp.group();
+  int64_t N = xShape[0];
+  int64_t CI = wShape[1];
+  int64_t CO = wShape[0] / G;
+  ArrayRef<int64_t> imageShape = xShape.drop_front(2);
+  ArrayRef<int64_t> kernelShape = wShape.drop_front(2);
+  ArrayRef<int64_t> outputImageShape = outputShape.drop_front(2);
+  int64_t imageSize = CI * ShapedType::getNumElements(imageShape);
+  int64_t filtersSize = CO * ShapedType::getNumElements(wShape.drop_front());
+  int64_t outputSize = CO * ShapedType::getNumElements(outputImageShape);
+
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  ArrayBuffer<WideNum> xNums =
+      getElementsWideNums(getConstValueElements(xValue));
+  ArrayBuffer<WideNum> wNums =
+      getElementsWideNums(getConstValueElements(wValue));
+  bool hasBias = !isFromNone(bValue);
+  ArrayBuffer<WideNum> bNums =
+      hasBias ? getElementsWideNums(getConstValueElements(bValue))
+              : ArrayBuffer<WideNum>();
+
+  MLIRContext *context = rewriter.getContext();
+  ElementsAttr resultElements = elementsBuilder.fromWideNums(
+      outputType, [&](MutableArrayRef<WideNum> dst) {
+        ArrayRef<double> x = castArrayRef<double>(xNums.get());
+        ArrayRef<double> w = castArrayRef<double>(wNums.get());
+        MutableArrayRef<double> y = castMutableArrayRef<double>(dst);
+        for (int64_t n = 0; n < N; ++n) {
+          for (int64_t g = 0; g < G; ++g) {
+            ConstPropConvImpl(context,
+                x.slice((n * G + g) * imageSize, imageSize), imageShape,
+                w.slice(g * filtersSize, filtersSize), kernelShape,
+                outputImageShape, pads, shapeHelper.strides,
+                shapeHelper.dilations, CI, CO,
+                y.slice((n * G + g) * outputSize, outputSize));
+          }
+        }
+        if (hasBias) {
+          ArrayRef<double> b = castArrayRef<double>(bNums.get());
+          int64_t pixels = outputSize / CO;
+          for (int64_t i = 0; i < static_cast<int64_t>(y.size()); ++i)
+            y[i] += b[(i / pixels) % (G * CO)];
+        }
+      });
+  return createReplacingConstantOp(rewriter, replacingValue, resultElements)
+      .getResult();
+}
+
+template <typename OP, typename T, class Enable = void>
+struct ReductionOpImpl {};
+
+template <typename T>
+struct ReductionOpImpl<ONNXReduceSumOp, T> {
+  static T identity() { return 0; }
+  static T eval(T acc, T val) { return acc + val; }
+};
+
+template <typename T>
+struct ReductionOpImpl<ONNXReduceSumV11Op, T>
+    : ReductionOpImpl<ONNXReduceSumOp, T> {};
+
+// ReduceMean divides the sum by the number of reduced elements.
+template <typename T>
+struct ReductionOpImpl<ONNXReduceMeanOp, T>
+    : ReductionOpImpl<ONNXReduceSumOp, T> {};
+
+template <typename T>
+struct ReductionOpImpl<ONNXReduceProdOp, T> {
+  static T identity() { return 1; }
+  static T eval(T acc, T val) { return acc * val; }
+};
+
+template <typename T>
+struct ReductionOpImpl<ONNXReduceMaxOp, T> {
+  static T identity() {
+    return std::numeric_limits<T>::has_infinity
+               ? -std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::lowest();
+  }
+  static T eval(T acc, T val) { return std::max(acc, val); }
+};
+
+template <typename T>
+struct ReductionOpImpl<ONNXReduceMinOp, T> {
+  static T identity() {
+    return std::numeric_limits<T>::has_infinity
+               ? std::numeric_limits<T>::infinity()
+               : std::numeric_limits<T>::max();
+  }
+  static T eval(T acc, T val) { return std::min(acc, val); }
+};
+
+// Reduces src into dst along the axes marked in isReductionAxis. The layout of
+// dst is that of the shape of src with every reduced axis of size 1.
+template <typename ReductionOp, typename T>
+void ConstPropReduceImpl(ArrayRef<T> src, ArrayRef<int64_t> shape,
+    ArrayRef<bool> isReductionAxis, MutableArrayRef<T> dst) {
+  using Impl = ReductionOpImpl<ReductionOp, T>;
+  size_t rank = shape.size();
+  std::fill(dst.begin(), dst.end(), Impl::identity());
+  if (rank == 0) {
+    dst[0] = Impl::eval(dst[0], src[0]);
+    return;
+  }
+  std::vector<int64_t> srcStrides = getStrides(shape);
+  SmallVector<int64_t, 4> reducedShape(shape.begin(), shape.end());
+  for (size_t axis = 0; axis < rank; ++axis)
+    if (isReductionAxis[axis])
+      reducedShape[axis] = 1;
+  std::vector<int64_t> dstStrides = getStrides(reducedShape);
+  for (size_t axis = 0; axis < rank; ++axis)
+    if (isReductionAxis[axis])
+      dstStrides[axis] = 0;
+  // The innermost loop runs over contiguous elements of src and either
+  // contiguous elements of dst or a single element of dst.
+  auto traverse = [&](size_t axis, size_t srcPos, size_t dstPos,
+                      const auto &recurse) -> void {
+    if (axis == rank - 1) {
+      const T *in = src.data() + srcPos;
+      T *out = dst.data() + dstPos;
+      int64_t dimSize = shape[axis];
+      if (dstStrides[axis] == 0) {
+        T acc = *out;
+        for (int64_t i = 0; i < dimSize; ++i)
+          acc = Impl::eval(acc, in[i]);
+        *out = acc;
+      } else {
+        for (int64_t i = 0; i < dimSize; ++i)
+          out[i] = Impl::eval(out[i], in[i]);
+      }
+    } else {
+      for (int64_t i = 0; i < shape[axis]; ++i) {
+        recurse(axis + 1, srcPos, dstPos, recurse);
+        srcPos += srcStrides[axis];
+        dstPos += dstStrides[axis];
+      }
+    }
+  };
+  traverse(0, 0, 0, traverse);
+}
+
+template <typename ReductionOp>
+Value ConstPropReduce(
+    PatternRewriter &rewriter, Value replacingValue, Value constValue) {
+  ConstPropCounters::count("Reduce", {constValue});
+  Operation *op = replacingValue.getDefiningOp();
+
+  // Get the reduction axes via ShapeHelper.
+  ONNXGenericReductionOpShapeHelper<ReductionOp> shapeHelper(op, {});
+  if (failed(shapeHelper.computeShape())) {
+    op->emitError("Failed to scan " + ReductionOp::getOperationName() +
+                  " parameters successfully");
+    return nullptr;
+  }
+  ArrayRef<bool> isReductionAxis = shapeHelper.isReductionAxis;
+
+  ShapedType outputType = replacingValue.getType().cast<ShapedType>();
+  ElementsAttr inputElements = getConstValueElements(constValue);
+  ArrayRef<int64_t> inputShape = inputElements.getType().getShape();
+  int64_t reducedCount = 1;
+  for (size_t axis = 0; axis < inputShape.size(); ++axis)
+    if (isReductionAxis[axis])
+      reducedCount *= inputShape[axis];
+  ArrayBuffer<WideNum> inputNums = getElementsWideNums(inputElements);
+
+  OnnxElementsAttrBuilder elementsBuilder(rewriter.getContext());
+  ElementsAttr resultElements = elementsBuilder.fromWideNums(
+      outputType, [&](MutableArrayRef<WideNum> dst) {
+        dispatchByWideType(outputType.getElementType(), [&](auto zero) {
+          using T = decltype(zero);
+          MutableArrayRef<T> out = castMutableArrayRef<T>(dst);
+          ConstPropReduceImpl<ReductionOp, T>(castArrayRef<T>(inputNums.get()),
+              inputShape, isReductionAxis, out);
+          if constexpr (std::is_same_v<ReductionOp, ONNXReduceMeanOp>) {
+            for (T &v : out)
+              v /= static_cast<T>(reducedCount);
+          }
+        });
+      });
+  return createReplacingConstantOp(rewriter, replacingValue, resultElements)
+      .getResult();
+}
+
+// Computes softmax over the middle dimension of src with shape
+// (outer x axisSize x inner), with the innermost loops running over
+// contiguous elements.
+void ConstPropSoftmaxImpl(MLIRContext *context, ArrayRef<double> src,
+    MutableArrayRef<double> dst, int64_t outer, int64_t axisSize,
+    int64_t inner) {
+  size_t minOuter =
+      kMinParallelElements / std::max<int64_t>(axisSize * inner, 1);
+  parallelForChunks(context, outer, minOuter, [&](size_t begin, size_t end) {
+    std::vector<double> maxes(inner), sums(inner);
+    for (size_t o = begin; o < end; ++o) {
+      const double *in = src.data() + o * axisSize * inner;
+      double *out = dst.data() + o * axisSize * inner;
+      std::copy_n(in, inner, maxes.begin());
+      for (int64_t a = 1; a < axisSize; ++a)
+        for (int64_t i = 0; i < inner; ++i)
+          maxes[i] = std::max(maxes[i], in[a * inner + i]);
+      std::fill(sums.begin(), sums.end(), 0);
+      for (int64_t a = 0; a < axisSize; ++a)
+        for (int64_t i = 0; i < inner; ++i) {
+          out[a * inner + i] = exp(in[a * inner + i] - maxes[i]);
+          sums[i] += out[a * inner + i];
+        }
+      for (int64_t a = 0; a < axisSize; ++a)
+        for (int64_t i = 0; i < inner; ++i)
+          out[a * inner + i] /= sums[i];
+    }
+  });
+}
+
+Value ConstPropSoftmax(
+    PatternRewriter &rewriter, Value replacingValue, Value constValue) {
+  ConstPropCounters::count("Softmax", {constValue});
+  ONNXSoftmaxOp softmaxOp = cast<ONNXSoftmaxOp>(replacingValue.getDefiningOp());
+  ShapedType outputType = replacingValue.getType().cast<ShapedType>();
+  ArrayRef<int64_t> shape = outputType.getShape();
+  int64_t axis = softmaxOp.axis();
+  if (axis < 0)
+    axis += shape.size();
+  int64_t outer = ShapedType::getNumElements(shape.take_front(axis));
+  int64_t inner = ShapedType::getNumElements(shape.drop_front(axis + 1));
+
+  ElementsAttr inputElements = getConstValueElements(constValue);
+  ArrayBuffer<WideNum> inputNums = getElementsWideNums(inputElements);
+  MLIRContext *context = rewriter.getContext();
+  OnnxElementsAttrBuilder elementsBuilder(context);
+  ElementsAttr resultElements = elementsBuilder.fromWideNums(
+      outputType, [&](MutableArrayRef<WideNum> dst) {
+        ConstPropSoftmaxImpl(context, castArrayRef<double>(inputNums.get()),
+            castMutableArrayRef<double>(dst), outer, shape[axis], inner);
+      });
+  return createReplacingConstantOp(rewriter, replacingValue, resultElements)
+      .getResult();
+}
+
 //===----------------------------------------------------------------------===//
 // Pattern definition.
 //===----------------------------------------------------------------------===//
@@ -98,6 +98,125 @@ bool ExpressONNXConvOpAsMatmul(ONNXConvOp convOp, bool verbose = 0) {
   return true;
 }
 
+// Cost model selecting the algorithm of the CPU lowering of a convolution.
+// Costs are estimated in units of a scalar multiply-add:
+// - direct: loop nest computing one multiply-add at a time;
+// - im2col: the input patches of each image are gathered into a matrix that
+//   is multiplied by the filters using the SIMD krnl.matmul microkernel;
+// - Winograd F(m x m, 3 x 3), with alpha = m + 2: input and filter tiles are
+//   transformed so that the convolution becomes alpha^2 matrix
+//   multiplications, followed by a transform of the output tiles.
+// Only convolutions with static shapes and float types are considered.
+//
+// The costs are first-order estimates, not measurements:
+// - a multiply-add of the direct loops is the unit;
+// - krnl.matmul computes its multiply-adds with SIMD vectors of 4 f32 on the
+//   narrowest targets (SSE, VSX, Z vector), hence a quarter of the unit;
+//   wider vectors only make im2col and Winograd more attractive;
+// - copying an element, or a multiply-add of the Winograd transforms that are
+//   not vectorized, costs as much as a scalar multiply-add.
+// Since they ignore caches, the selection is off by default and enabled with
+// --conv-algorithm-selection.
+static constexpr double DIRECT_COST_PER_MAC = 1.0;
+static constexpr double MATMUL_COST_PER_MAC = 1.0 / 4;
+static constexpr double COPY_COST_PER_ELEMENT = 1.0;
+static constexpr double TRANSFORM_COST_PER_OP = 1.0;
+// Largest temporary buffer used by im2col or Winograd, in bytes.
+static constexpr int64_t MAX_CONV_BUFFER_SIZE = 64 * 1024 * 1024;
+
+std::string selectConvAlgorithm(ONNXConvOp convOp, bool verbose = 0) {
+  Type xType = convOp.X().getType();
+  Type wType = convOp.W().getType();
+  Type yType = convOp.Y().getType();
+  if (!hasStaticShape(xType) || !hasStaticShape(wType) ||
+      !hasStaticShape(yType))
+    return CONV_ALGORITHM_DIRECT;
+  if (hasCustomONNXTensorDataLayout(xType) ||
+      hasCustomONNXTensorDataLayout(wType))
+    return CONV_ALGORITHM_DIRECT;
+  Type elementType = getElementType(xType);
+  if (!elementType.isa<FloatType>())
+    return CONV_ALGORITHM_DIRECT;
+  int64_t elementSize = getEltSizeInBytes(xType);
+  ArrayRef<int64_t> xShape = getShape(xType);
+  ArrayRef<int64_t> wShape = getShape(wType);
+  ArrayRef<int64_t> yShape = getShape(yType);
+  int64_t rank = yShape.size();
+  int64_t N = yShape[0], CO = yShape[1], G = convOp.group();
+  int64_t CIPerGroup = wShape[1];
+  int64_t kernelSize = 1, outputSize = 1, inputSize = 1;
+  for (int64_t i = 2; i < rank; ++i) {
+    kernelSize *= wShape[i];
+    outputSize *= yShape[i];
+    inputSize *= xShape[i];
+  }
+  double numMACs = (double)N * CO * CIPerGroup * kernelSize * outputSize;
+
+  std::string algorithm = CONV_ALGORITHM_DIRECT;
+  double bestCost = numMACs * DIRECT_COST_PER_MAC;
+  auto consider = [&](const std::string &candidate, double cost) {
+    if (verbose)
+      printf("conv algorithm %s: estimated cost %g\n", candidate.c_str(), cost);
+    if (cost < bestCost) {
+      algorithm = candidate;
+      bestCost = cost;
+    }
+  };
+  if (verbose)
+    printf("conv algorithm %s: estimated cost %g\n", algorithm.c_str(),
+        bestCost);
+
+  // Im2col: gather one patch matrix per image and group, then multiply.
+  int64_t patchSize = CIPerGroup * kernelSize * outputSize;
+  if (patchSize * elementSize <= MAX_CONV_BUFFER_SIZE)
+    consider(CONV_ALGORITHM_IM2COL,
+        numMACs * MATMUL_COST_PER_MAC +
+            (double)N * G * patchSize * COPY_COST_PER_ELEMENT);
+
+  // Winograd: 2D, 3x3 kernels with unit strides and dilations, no groups.
+  bool hasUnitStridesAndDilations = true;
+  for (int64_t i = 0; i < rank - 2; ++i) {
+    if (convOp.strides().has_value() &&
+        ArrayAttrIntVal(convOp.strides(), i) != 1)
+      hasUnitStridesAndDilations = false;
+    if (convOp.dilations().has_value() &&
+        ArrayAttrIntVal(convOp.dilations(), i) != 1)
+      hasUnitStridesAndDilations = false;
+  }
+  if (rank == 4 && G == 1 && wShape[2] == 3 && wShape[3] == 3 &&
+      hasUnitStridesAndDilations) {
+    int64_t CI = CIPerGroup;
+    for (int64_t m : {2, 4}) {
+      // The larger tiles lose too much precision below 32 bits.
+      if (m == 4 && elementType.getIntOrFloatBitWidth() < 32)
+        continue;
+      int64_t alpha = m + 2;
+      int64_t tiles = N * ((yShape[2] + m - 1) / m) * ((yShape[3] + m - 1) / m);
+      // Transformed filters, inputs, and outputs.
+      int64_t bufferSize = alpha * alpha * (CO * CI + (CI + CO) * tiles);
+      if (bufferSize * elementSize > MAX_CONV_BUFFER_SIZE)
+        continue;
+      double matmulCost =
+          (double)alpha * alpha * CO * CI * tiles * MATMUL_COST_PER_MAC;
+      // Each transform is a product by a constant matrix on each side.
+      double filterCost =
+          (double)CO * CI * (alpha * 3 * 3 + alpha * alpha * 3) *
+          TRANSFORM_COST_PER_OP;
+      double inputCost =
+          (double)CI * tiles * 2 * alpha * alpha * alpha *
+              TRANSFORM_COST_PER_OP +
+          (double)N * CI * inputSize * COPY_COST_PER_ELEMENT;
+      double outputCost = (double)CO * tiles *
+                          (m * alpha * alpha + m * m * alpha) *
+                          TRANSFORM_COST_PER_OP;
+      consider(m == 2 ? CONV_ALGORITHM_WINOGRAD_2X2
+                      : CONV_ALGORITHM_WINOGRAD_4X4,
+          matmulCost + filterCost + inputCost + outputCost);
+    }
+  }
+  return algorithm;
+}
+
 } // namespace onnx_mlir
 
 namespace {
@@ -215,8 +334,9 @@ struct ConvOptONNXToONNXPass
   ConvOptONNXToONNXPass(const ConvOptONNXToONNXPass &pass)
       : mlir::PassWrapper<ConvOptONNXToONNXPass,
             OperationPass<func::FuncOp>>() {}
-  ConvOptONNXToONNXPass(bool enableSimdDataLayout) {
+  ConvOptONNXToONNXPass(bool enableSimdDataLayout, bool selectAlgorithm) {
     this->enableSimdDataLayoutOpt = enableSimdDataLayout;
+    this->enableAlgorithmSelection = selectAlgorithm;
   };
 
   StringRef getArgument() const override { return "conv-opt-onnx"; }
@@ -231,6 +351,12 @@ struct ConvOptONNXToONNXPass
       llvm::cl::desc("Enable SIMD data layout optimizations"),
       ::llvm::cl::init(false)};
 
+  // Usage: onnx-mlir-opt --conv-opt-onnx='select-algorithm'
+  Option<bool> enableAlgorithmSelection{*this, "select-algorithm",
+      llvm::cl::desc("Select the im2col or Winograd algorithm of the "
+                     "convolutions with a cost model"),
+      ::llvm::cl::init(false)};
+
   void runOnOperation() final;
 };
 
@@ -272,7 +398,20 @@ void ConvOptONNXToONNXPass::runOnOperation() {
     patterns.insert<Conv1x1ToMatmulPattern>(context);
 
   if (failed(applyPartialConversion(function, target, std::move(patterns))))
-    signalPassFailure();
+    return signalPassFailure();
+
+  // Record the algorithm selected by the cost model on the remaining
+  // convolutions, for their lowering to Krnl.
+  if (!enableAlgorithmSelection)
+    return;
+  function.walk([&](ONNXConvOp convOp) {
+    std::string algorithm = onnx_mlir::selectConvAlgorithm(convOp, DEBUG);
+    if (algorithm == onnx_mlir::CONV_ALGORITHM_DIRECT)
+      convOp->removeAttr(onnx_mlir::CONV_ALGORITHM_ATTR);
+    else
+      convOp->setAttr(onnx_mlir::CONV_ALGORITHM_ATTR,
+          StringAttr::get(context, algorithm));
+  });
 }
 
 } // namespace
@@ -283,8 +422,9 @@ namespace onnx_mlir {
  * Create a DecomposeONNX pass.
  */
 std::unique_ptr<mlir::Pass> createConvOptONNXToONNXPass(
-    bool enableSimdDataLayoutOpt) {
-  return std::make_unique<ConvOptONNXToONNXPass>(enableSimdDataLayoutOpt);
+    bool enableSimdDataLayoutOpt, bool enableAlgorithmSelection) {
+  return std::make_unique<ConvOptONNXToONNXPass>(
+      enableSimdDataLayoutOpt, enableAlgorithmSelection);
 }
 
 } // namespace onnx_mlir
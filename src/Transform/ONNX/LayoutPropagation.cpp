@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- LayoutPropagation.cpp - ONNX Layout Propagation for CPU ------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file propagates the blocked NCHWxC layout introduced by the ConvOpt pass
+// for convolutions through the layout-agnostic ops that follow them, so that
+// activations stay in that layout from convolution to convolution and are only
+// converted back at the edges of the graph or before layout-sensitive ops such
+// as Reshape or Flatten.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "src/Dialect/ONNX/ONNXLayoutHelper.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Dialect/ONNX/ONNXOps/OpHelper.hpp"
+#include "src/Pass/Passes.hpp"
+#include "src/Support/TypeUtilities.hpp"
+
+using namespace mlir;
+using namespace onnx_mlir;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Helper functions for this pass
+//===----------------------------------------------------------------------===//
+
+/// Return the NCHWxC tensor transformed into the given standard tensor by a
+/// LayoutTransform op, or nullptr if there is none.
+Value getNCHWxCSource(Value value) {
+  if (hasCustomONNXTensorDataLayout(value.getType()))
+    return nullptr;
+  auto transformOp =
+      dyn_cast_or_null<ONNXLayoutTransformOp>(value.getDefiningOp());
+  if (!transformOp)
+    return nullptr;
+  Value source = transformOp.data();
+  if (getONNXTensorLayout(source.getType()) !=
+      ONNXTensorEncodingAttr::DataLayout::NCHWxC)
+    return nullptr;
+  return source;
+}
+
+//===----------------------------------------------------------------------===//
+// Layout propagation patterns
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+// Layout propagation for layout-agnostic ONNX operations
+//
+// Relu, Add, pooling, and BatchNorm compute each output element from input
+// elements at the same logical (N, C, H, W) indices, or at indices that do
+// not depend on the layout. Their Krnl lowerings only use logical indices,
+// and thus accept operands and results in any layout. For example,
+//   onnx.Conv (NCHW4C) -> LayoutTransform (STANDARD) -> onnx.Relu
+// becomes
+//   onnx.Conv (NCHW4C) -> onnx.Relu (NCHW4C) -> LayoutTransform (STANDARD)
+// so that the transform moves down to the next layout-sensitive op, or is
+// removed together with the transform to NCHW4C of the next convolution.
+//
+//===----------------------------------------------------------------------===//
+
+template <typename ONNX_OP>
+class ONNXLayoutPropagationPattern : public OpRewritePattern<ONNX_OP> {
+public:
+  using OpRewritePattern<ONNX_OP>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(
+      ONNX_OP onnxOp, PatternRewriter &rewriter) const override {
+    Operation *genericOp = onnxOp.getOperation();
+    Location loc = genericOp->getLoc();
+    Value output = genericOp->getResult(0);
+    Type outputType = output.getType();
+
+    // Only 4D outputs, in the standard layout, can use NCHWxC.
+    if (!isRankedShapedType(outputType) || getRank(outputType) != 4 ||
+        hasCustomONNXTensorDataLayout(outputType))
+      return failure();
+
+    // Operands with the rank and channels of the output that are transformed
+    // from NCHWxC tensors with the same encoding use these tensors directly.
+    // Their spatial dimensions may differ, as for pooling. Other operands,
+    // such as the per-channel parameters of BatchNorm, are left in the
+    // standard layout.
+    ONNXTensorEncodingAttr encoding;
+    SmallVector<Value, 4> newOperands;
+    for (Value operand : genericOp->getOperands()) {
+      Value source = getNCHWxCSource(operand);
+      if (!source || getRank(source.getType()) != 4 ||
+          getShape(source.getType())[1] != getShape(outputType)[1]) {
+        newOperands.emplace_back(operand);
+        continue;
+      }
+      ONNXTensorEncodingAttr sourceEncoding =
+          getONNXTensorEncoding(source.getType());
+      if (encoding && sourceEncoding != encoding)
+        return failure();
+      encoding = sourceEncoding;
+      newOperands.emplace_back(source);
+    }
+    if (!encoding)
+      return failure();
+
+    // Compute the op in NCHWxC, and transform its result back.
+    Operation *newOp = rewriter.clone(*genericOp);
+    rewriter.updateRootInPlace(newOp, [&]() {
+      newOp->setOperands(newOperands);
+      newOp->getResult(0).setType(
+          convertTensorTypeToTensorTypeWithEncoding(outputType, encoding));
+    });
+    Value replacedValue = rewriter.create<ONNXLayoutTransformOp>(loc,
+        outputType, newOp->getResult(0),
+        rewriter.getStringAttr(LAYOUT_STANDARD));
+    rewriter.replaceOp(genericOp, replacedValue);
+    return success();
+  }
+};
+
+/// The pattern
+///   LayoutTransform (LayoutTransform (%X (NCHWxC), STANDARD), NCHWxC)
+/// can be replaced by %X.
+class ONNXLayoutTransformPairPattern
+    : public OpRewritePattern<ONNXLayoutTransformOp> {
+public:
+  using OpRewritePattern<ONNXLayoutTransformOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(ONNXLayoutTransformOp transformOp,
+      PatternRewriter &rewriter) const override {
+    Value source = getNCHWxCSource(transformOp.data());
+    if (!source || source.getType() != transformOp.output().getType())
+      return failure();
+    rewriter.replaceOp(transformOp, source);
+    return success();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// ONNX layout propagation Pass
+//===----------------------------------------------------------------------===//
+
+struct ONNXLayoutPropagationPass
+    : public PassWrapper<ONNXLayoutPropagationPass,
+          OperationPass<func::FuncOp>> {
+
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ONNXLayoutPropagationPass)
+
+  StringRef getArgument() const override { return "layout-prop-onnx"; }
+
+  StringRef getDescription() const override {
+    return "Propagate the NCHWxC layout of convolutions through "
+           "layout-agnostic ONNX ops for optimized CPU execution.";
+  }
+
+  void runOnOperation() override {
+    func::FuncOp function = getOperation();
+    MLIRContext *context = &getContext();
+    RewritePatternSet patterns(context);
+
+    // Layout-agnostic ops.
+    patterns.insert<ONNXLayoutPropagationPattern<ONNXReluOp>>(context);
+    patterns.insert<ONNXLayoutPropagationPattern<ONNXAddOp>>(context);
+    patterns.insert<ONNXLayoutPropagationPattern<ONNXMaxPoolSingleOutOp>>(
+        context);
+    patterns.insert<ONNXLayoutPropagationPattern<ONNXAveragePoolOp>>(context);
+    patterns.insert<
+        ONNXLayoutPropagationPattern<ONNXBatchNormalizationInferenceModeOp>>(
+        context);
+
+    // Remove the transform pairs between consecutive layers.
+    patterns.insert<ONNXLayoutTransformPairPattern>(context);
+    ONNXLayoutTransformOp::getCanonicalizationPatterns(patterns, context);
+    (void)applyPatternsAndFoldGreedily(function, std::move(patterns));
+  }
+};
+
+} // namespace
+
+namespace onnx_mlir {
+
+/*!
+ * Create a LayoutPropagation pass.
+ */
+std::unique_ptr<mlir::Pass> createONNXLayoutPropagationPass() {
+  return std::make_unique<ONNXLayoutPropagationPass>();
+}
+
+} // namespace onnx_mlir
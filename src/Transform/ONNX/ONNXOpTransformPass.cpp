@@ -15,7 +15,8 @@
 
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
-#include "llvm/Support/raw_sha1_ostream.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 
 #include "src/Dialect/ONNX/ONNXOps.hpp"
 #include "src/Pass/Passes.hpp"
@@ -46,33 +47,58 @@ struct ONNXOpTransformPass : public mlir::PassWrapper<ONNXOpTransformPass,
       "onnx-op-transform-simd-data-layout",
       llvm::cl::desc("Enable SIMD data layout opt in op transform passes."),
       llvm::cl::init(false)};
+  Option<bool> onnxOpTransformConvAlgorithmSelection{*this,
+      "onnx-op-transform-conv-algorithm-selection",
+      llvm::cl::desc(
+          "Enable conv algorithm selection in op transform passes."),
+      llvm::cl::init(false)};
 
   ONNXOpTransformPass() = default;
   ONNXOpTransformPass(const ONNXOpTransformPass &pass)
       : mlir::PassWrapper<ONNXOpTransformPass,
             OperationPass<mlir::ModuleOp>>() {}
   ONNXOpTransformPass(int threshold, bool report, bool targetCPU,
-      bool enableSimdDataLayoutOpt) {
+      bool enableSimdDataLayoutOpt, bool enableConvAlgorithmSelection) {
     this->onnxOpTransformThreshold = threshold;
     this->onnxOpTransformReport = report;
     this->onnxOpTransformTargetCPU = targetCPU;
     this->onnxOpTransformEnableSimdDataLayout = enableSimdDataLayoutOpt;
+    this->onnxOpTransformConvAlgorithmSelection = enableConvAlgorithmSelection;
   }
 
   void runOnOperation() final;
 
 private:
+  // Hash the structure of the IR: the names, attributes, and result types of
+  // the ops, their regions and block arguments, and their operands, numbered
+  // in the order in which values are visited. Attributes are hashed by
+  // identity, which MLIR uniques, so that large constants are neither
+  // printed nor read: a DisposableElementsAttr is only replaced by another
+  // instance when a transformation computes new contents.
   uint64_t createTagForIR(mlir::ModuleOp module) {
-    // NOTE: This is slow for real models because they contain large
-    // constant tensors that are expensive to print. A workaround is to
-    // elide them from printing with --mlir-elide-elementsattrs-if-larger=1
-    //
-    // TODO: Hash without printing to speed this up, e.g. along the lines of
-    // how blocks are hashed in mlir/lib/Transforms/Utils/RegionUtils.cpp
-    llvm::raw_sha1_ostream sha1_ostream;
-    module->print(sha1_ostream, mlir::OpPrintingFlags());
-    std::array<uint8_t, 20> sha1 = sha1_ostream.sha1();
-    return *reinterpret_cast<uint64_t *>(sha1.data());
+    llvm::DenseMap<Value, unsigned> valueNumbers;
+    auto getValueNumber = [&](Value value) {
+      return valueNumbers.try_emplace(value, valueNumbers.size())
+          .first->second;
+    };
+    llvm::hash_code hash = 0;
+    module->walk<WalkOrder::PreOrder>([&](Operation *op) {
+      hash = llvm::hash_combine(hash, op->getName(), op->getAttrDictionary(),
+          op->getNumSuccessors());
+      for (Value operand : op->getOperands())
+        hash = llvm::hash_combine(hash, getValueNumber(operand));
+      for (Value result : op->getResults())
+        hash = llvm::hash_combine(
+            hash, result.getType(), getValueNumber(result));
+      for (Region &region : op->getRegions()) {
+        hash = llvm::hash_combine(hash, region.getBlocks().size());
+        for (Block &block : region)
+          for (BlockArgument arg : block.getArguments())
+            hash =
+                llvm::hash_combine(hash, arg.getType(), getValueNumber(arg));
+      }
+    });
+    return static_cast<uint64_t>(static_cast<size_t>(hash));
   }
 };
 
@@ -94,8 +120,12 @@ void ONNXOpTransformPass::runOnOperation() {
     if (onnxOpTransformTargetCPU) {
       dynamicPM.addNestedPass<func::FuncOp>(
           onnx_mlir::createConvOptONNXToONNXPass(
-              onnxOpTransformEnableSimdDataLayout));
+              onnxOpTransformEnableSimdDataLayout,
+              onnxOpTransformConvAlgorithmSelection));
       dynamicPM.addPass(onnx_mlir::createShapeInferencePass());
+      if (onnxOpTransformEnableSimdDataLayout)
+        dynamicPM.addNestedPass<func::FuncOp>(
+            onnx_mlir::createONNXLayoutPropagationPass());
     }
     dynamicPM.addNestedPass<func::FuncOp>(
         onnx_mlir::createConstPropONNXToONNXPass());
@@ -126,7 +156,8 @@ std::unique_ptr<mlir::Pass> onnx_mlir::createONNXOpTransformPass() {
 }
 
 std::unique_ptr<mlir::Pass> onnx_mlir::createONNXOpTransformPass(
-    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt) {
-  return std::make_unique<ONNXOpTransformPass>(
-      threshold, report, targetCPU, enableSimdDataLayoutOpt);
+    int threshold, bool report, bool targetCPU, bool enableSimdDataLayoutOpt,
+    bool enableConvAlgorithmSelection) {
+  return std::make_unique<ONNXOpTransformPass>(threshold, report, targetCPU,
+      enableSimdDataLayoutOpt, enableConvAlgorithmSelection);
 }
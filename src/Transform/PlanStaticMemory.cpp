@@ -0,0 +1,269 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- PlanStaticMemory.cpp - Plan Static Memory Pool Offsets ------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This pass assigns the offsets of the internal MemRefs of a function in the
+// static memory pools emitted by the BundleMemoryPools pass.
+//
+// The live interval of each MemRef spans the operations of the function that
+// use it, directly or through views. MemRefs whose intervals do not overlap
+// can share memory, which makes the offset assignment an interval graph
+// coloring problem. MemRefs are placed from the largest to the smallest, each
+// in the smallest gap left by the placed MemRefs whose intervals overlap with
+// its own, so that the memory pool only needs the peak size of the MemRefs
+// live at the same time. Contrary to the OptimizeMemoryPools pass, MemRefs of
+// different sizes share memory.
+//
+// The planned size of the memory pools of each function is recorded in its
+// krnl.planned_peak_memory attribute, and optionally reported.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "src/Dialect/Krnl/KrnlOps.hpp"
+#include "src/Pass/Passes.hpp"
+#include "src/Support/KrnlSupport.hpp"
+
+#include <limits>
+#include <map>
+
+using namespace mlir;
+using namespace onnx_mlir;
+
+namespace {
+
+// Name of the function attribute recording the planned size of its memory
+// pools.
+const StringRef PLANNED_PEAK_MEMORY_ATTR = "krnl.planned_peak_memory";
+
+// MemRef of a memory pool, made of the getrefs sharing the same offset.
+struct PlannedBuffer {
+  SmallVector<KrnlGetRefOp, 2> getRefs;
+  int64_t size = 0;
+  // Indices in the top-level block of the first and last operations using
+  // the MemRef, inclusive.
+  int64_t start = std::numeric_limits<int64_t>::max();
+  int64_t end = -1;
+  int64_t offset = -1;
+
+  bool overlaps(const PlannedBuffer &other) const {
+    return start <= other.end && other.start <= end;
+  }
+};
+
+int64_t alignOffset(int64_t offset, int64_t alignment) {
+  if (alignment <= 1)
+    return offset;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// Extend the live interval of buffer with the operations of the top-level
+/// block using value, directly or through views of value.
+void extendLiveInterval(PlannedBuffer &buffer, Value value, Block *topBlock,
+    const DenseMap<Operation *, int64_t> &opIndices) {
+  for (Operation *user : value.getUsers()) {
+    Operation *topOp = topBlock->findAncestorOpInBlock(*user);
+    if (topOp) {
+      int64_t index = opIndices.lookup(topOp);
+      buffer.start = std::min(buffer.start, index);
+      buffer.end = std::max(buffer.end, index);
+    }
+    auto viewOp = dyn_cast<ViewLikeOpInterface>(user);
+    if (viewOp && viewOp.getViewSource() == value)
+      for (Value view : user->getResults())
+        extendLiveInterval(buffer, view, topBlock, opIndices);
+  }
+}
+
+/// Return the buffers of a static memory pool, or fail if the offsets of its
+/// MemRefs cannot be planned.
+LogicalResult collectBuffers(memref::AllocOp allocOp, Block *topBlock,
+    const DenseMap<Operation *, int64_t> &opIndices,
+    SmallVectorImpl<PlannedBuffer> &buffers) {
+  std::map<int64_t, int64_t> offsetToBuffer;
+  for (Operation *user : allocOp->getUsers()) {
+    if (isa<memref::DeallocOp>(user))
+      continue;
+    auto getRef = dyn_cast<KrnlGetRefOp>(user);
+    IntegerAttr offsetAttr;
+    if (!getRef || getRef.mempool() != allocOp.getResult() ||
+        !matchPattern(getRef.offset(), m_Constant(&offsetAttr)) ||
+        !hasAllConstantDimensions(
+            getRef.getResult().getType().cast<MemRefType>()))
+      return failure();
+    auto it = offsetToBuffer.emplace(offsetAttr.getInt(), buffers.size());
+    if (it.second)
+      buffers.emplace_back();
+    PlannedBuffer &buffer = buffers[it.first->second];
+    buffer.getRefs.emplace_back(getRef);
+    buffer.size =
+        std::max(buffer.size, getMemRefSizeInBytes(getRef.getResult()));
+    extendLiveInterval(buffer, getRef.getResult(), topBlock, opIndices);
+  }
+  return success(!buffers.empty());
+}
+
+/// Assign the offsets of the buffers, and return the size of the memory pool.
+int64_t assignOffsets(
+    MutableArrayRef<PlannedBuffer> buffers, int64_t alignment) {
+  SmallVector<PlannedBuffer *, 16> order;
+  for (PlannedBuffer &buffer : buffers)
+    order.emplace_back(&buffer);
+  llvm::stable_sort(order, [](PlannedBuffer *a, PlannedBuffer *b) {
+    return a->size > b->size || (a->size == b->size && a->start < b->start);
+  });
+
+  int64_t poolSize = 0;
+  SmallVector<PlannedBuffer *, 16> placed;
+  for (PlannedBuffer *buffer : order) {
+    SmallVector<PlannedBuffer *, 16> live;
+    for (PlannedBuffer *other : placed)
+      if (buffer->overlaps(*other))
+        live.emplace_back(other);
+    llvm::sort(live, [](PlannedBuffer *a, PlannedBuffer *b) {
+      return a->offset < b->offset;
+    });
+
+    // Use the smallest gap between the live buffers the buffer fits in, or
+    // place it after them.
+    int64_t bestOffset = -1;
+    int64_t bestGap = std::numeric_limits<int64_t>::max();
+    int64_t gapBegin = 0;
+    for (PlannedBuffer *other : live) {
+      int64_t offset = alignOffset(gapBegin, alignment);
+      int64_t gap = other->offset - offset;
+      if (gap >= buffer->size && gap < bestGap) {
+        bestOffset = offset;
+        bestGap = gap;
+      }
+      gapBegin = std::max(gapBegin, other->offset + other->size);
+    }
+    buffer->offset =
+        bestOffset >= 0 ? bestOffset : alignOffset(gapBegin, alignment);
+    poolSize = std::max(poolSize, buffer->offset + buffer->size);
+    placed.emplace_back(buffer);
+  }
+  return poolSize;
+}
+
+/*!
+ *  Function pass that plans the offsets of the MemRefs in static memory pools.
+ */
+class KrnlPlanStaticMemoryPass
+    : public PassWrapper<KrnlPlanStaticMemoryPass,
+          OperationPass<func::FuncOp>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(KrnlPlanStaticMemoryPass)
+
+  KrnlPlanStaticMemoryPass() = default;
+  KrnlPlanStaticMemoryPass(const KrnlPlanStaticMemoryPass &pass)
+      : PassWrapper<KrnlPlanStaticMemoryPass, OperationPass<func::FuncOp>>() {}
+  KrnlPlanStaticMemoryPass(bool report) { this->report = report; }
+
+  StringRef getArgument() const override { return "plan-static-memory"; }
+
+  StringRef getDescription() const override {
+    return "Assign the offsets of the MemRefs in static memory pools based on "
+           "their live intervals.";
+  }
+
+  Option<bool> report{*this, "report",
+      llvm::cl::desc("Report the planned size of the memory pools of each "
+                     "function."),
+      llvm::cl::init(false)};
+
+  void runOnOperation() override {
+    func::FuncOp function = getOperation();
+    if (function.isExternal())
+      return;
+    Block *topBlock = &function.getBody().front();
+
+    DenseMap<Operation *, int64_t> opIndices;
+    int64_t index = 0;
+    for (Operation &op : *topBlock)
+      opIndices[&op] = index++;
+
+    SmallVector<memref::AllocOp, 4> pools;
+    for (Operation &op : *topBlock) {
+      auto allocOp = dyn_cast<memref::AllocOp>(op);
+      if (allocOp && checkOpResultIsUsedByGetRef(&allocOp) &&
+          allocOp.getType().getRank() == 1 &&
+          hasAllConstantDimensions(allocOp.getType()) &&
+          getMemRefEltSizeInBytes(allocOp.getType()) == 1)
+        pools.emplace_back(allocOp);
+    }
+
+    int64_t totalSize = 0;
+    int64_t totalPlannedSize = 0;
+    int64_t numBuffers = 0;
+    for (memref::AllocOp allocOp : pools) {
+      int64_t poolSize = allocOp.getType().getShape()[0];
+      SmallVector<PlannedBuffer, 16> buffers;
+      if (failed(collectBuffers(allocOp, topBlock, opIndices, buffers))) {
+        totalSize += poolSize;
+        totalPlannedSize += poolSize;
+        continue;
+      }
+      int64_t alignment = getAllocAlignment(allocOp);
+      int64_t plannedSize = assignOffsets(buffers, alignment);
+      // Keep the current offsets if they are better, e.g. for MemRefs that
+      // already share memory.
+      if (plannedSize >= poolSize) {
+        totalSize += poolSize;
+        totalPlannedSize += poolSize;
+        continue;
+      }
+
+      OpBuilder builder(allocOp);
+      Location loc = allocOp.getLoc();
+      auto newAllocOp = builder.create<memref::AllocOp>(loc,
+          MemRefType::get({plannedSize}, builder.getIntegerType(8)),
+          allocOp.getAlignmentAttr());
+      for (PlannedBuffer &buffer : buffers) {
+        Value offset = builder.create<arith::ConstantOp>(
+            loc, builder.getI64IntegerAttr(buffer.offset));
+        for (KrnlGetRefOp getRef : buffer.getRefs)
+          getRef->setOperand(1, offset);
+      }
+      allocOp.getResult().replaceAllUsesWith(newAllocOp.getResult());
+      allocOp.erase();
+
+      totalSize += poolSize;
+      totalPlannedSize += plannedSize;
+      numBuffers += buffers.size();
+    }
+
+    if (pools.empty())
+      return;
+    function->setAttr(PLANNED_PEAK_MEMORY_ATTR,
+        IntegerAttr::get(IntegerType::get(function.getContext(), 64),
+            totalPlannedSize));
+    if (report)
+      llvm::outs() << "Static memory plan of " << function.getName() << ": "
+                   << totalPlannedSize << " bytes peak memory for "
+                   << numBuffers << " buffers, instead of " << totalSize
+                   << " bytes\n";
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> onnx_mlir::krnl::createKrnlPlanStaticMemoryPass() {
+  return std::make_unique<KrnlPlanStaticMemoryPass>();
+}
+
+std::unique_ptr<Pass> onnx_mlir::krnl::createKrnlPlanStaticMemoryPass(
+    bool report) {
+  return std::make_unique<KrnlPlanStaticMemoryPass>(report);
+}
@@ -0,0 +1,28 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm="reuse-memory-pool use-scratch-arena" %s | FileCheck %s
+
+// Test that the static memory pool of the function is acquired from the
+// memory pools kept across inferences, that other internal buffers use the
+// scratch arenas, and that outputs are still allocated with malloc.
+func.func @test_memory_pool_reuse(%arg0: memref<10xf32>) -> memref<10xf32> {
+  %c0_i64 = arith.constant 0 : i64
+  %0 = memref.alloc() {alignment = 64 : i64} : memref<400xi8>
+  %1 = "krnl.getref"(%0, %c0_i64) : (memref<400xi8>, i64) -> memref<10x10xf32>
+  %2 = memref.alloc() : memref<10xf32>
+  %3 = memref.alloc() : memref<10xf32>
+  memref.dealloc %2 : memref<10xf32>
+  memref.dealloc %0 : memref<400xi8>
+  return %3 : memref<10xf32>
+
+// CHECK-DAG:     llvm.func @omMemoryPoolRelease(!llvm.ptr<i8>)
+// CHECK-DAG:     llvm.func @omMemoryPoolAcquire(i64, i64) -> !llvm.ptr<i8>
+// CHECK-DAG:     llvm.func @omScratchFree(!llvm.ptr<i8>)
+// CHECK-DAG:     llvm.func @omScratchAlloc(i64, i64) -> !llvm.ptr<i8>
+// CHECK-LABEL:   llvm.func @test_memory_pool_reuse
+// CHECK:           [[ALIGNMENT_:%.+]] = llvm.mlir.constant(64 : i64) : i64
+// CHECK:           [[POOL_:%.+]] = llvm.call @omMemoryPoolAcquire({{.*}}, [[ALIGNMENT_]]) : (i64, i64) -> !llvm.ptr<i8>
+// CHECK:           llvm.call @omScratchAlloc
+// CHECK:           llvm.call @malloc
+// CHECK:           llvm.call @omScratchFree({{.*}}) : (!llvm.ptr<i8>) -> ()
+// CHECK:           llvm.call @omMemoryPoolRelease({{.*}}) : (!llvm.ptr<i8>) -> ()
+// CHECK-NOT:       llvm.call @free
+}
@@ -0,0 +1,46 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm="use-output-buffers" %s | FileCheck %s
+
+// Test that outputs are allocated with omOutputAlloc, directly or through a
+// view, that internal buffers and outputs returned twice use malloc, and that
+// the entry point gets a variant taking the output tensors.
+module {
+  func.func @main_graph(%arg0: memref<10xf32>) -> (memref<10xf32>, memref<2x5xf32>, memref<10xf32>, memref<10xf32>) {
+    %0 = memref.alloc() {alignment = 16 : i64} : memref<10xf32>
+    %1 = memref.alloc() {alignment = 16 : i64} : memref<10xf32>
+    %2 = memref.reinterpret_cast %1 to offset: [0], sizes: [2, 5], strides: [5, 1] : memref<10xf32> to memref<2x5xf32>
+    %3 = memref.alloc() : memref<10xf32>
+    %4 = memref.alloc() : memref<10xf32>
+    memref.dealloc %4 : memref<10xf32>
+    return %0, %2, %3, %3 : memref<10xf32>, memref<2x5xf32>, memref<10xf32>, memref<10xf32>
+  }
+  "krnl.entry_point"() {func = @main_graph, numInputs = 1 : i32, numOutputs = 4 : i32, signature = "[in_sig]\00@[out_sig]\00"} : () -> ()
+
+// CHECK-DAG:     llvm.func @omOutputAlloc(i64, i64, i64, !llvm.ptr<i64>, i64, i64) -> !llvm.ptr<i8>
+// CHECK-DAG:     llvm.func @omOutputBuffersBegin(!llvm.ptr<i8>)
+// CHECK-DAG:     llvm.func @omOutputBuffersEnd(!llvm.ptr<i8>) -> !llvm.ptr<i8>
+// CHECK-LABEL:   llvm.func @main_graph
+// CHECK:           [[SHAPE_0_:%.+]] = llvm.alloca {{.*}} x i64 : (i64) -> !llvm.ptr<i64>
+// CHECK:           [[DIM_0_:%.+]] = llvm.getelementptr [[SHAPE_0_]]
+// CHECK:           llvm.store {{.*}}, [[DIM_0_]] : !llvm.ptr<i64>
+// CHECK-DAG:       [[INDEX_0_:%.+]] = llvm.mlir.constant(0 : i64) : i64
+// CHECK-DAG:       [[FLOAT_:%.+]] = llvm.mlir.constant(1 : i64) : i64
+// CHECK:           [[BUFFER_0_:%.+]] = llvm.call @omOutputAlloc([[INDEX_0_]], [[FLOAT_]], {{.*}}, [[SHAPE_0_]], {{.*}}, {{.*}}) : (i64, i64, i64, !llvm.ptr<i64>, i64, i64) -> !llvm.ptr<i8>
+// CHECK:           llvm.ptrtoint [[BUFFER_0_]] : !llvm.ptr<i8> to i64
+// CHECK:           llvm.urem
+// CHECK:           llvm.sub
+// CHECK:           llvm.urem
+// CHECK:           llvm.getelementptr [[BUFFER_0_]]
+// CHECK:           llvm.call @omOutputAlloc({{.*}}) : (i64, i64, i64, !llvm.ptr<i64>, i64, i64) -> !llvm.ptr<i8>
+// CHECK-NOT:       llvm.call @omOutputAlloc
+// CHECK:           llvm.call @malloc
+// CHECK:           llvm.call @malloc
+// CHECK:           llvm.call @free
+
+// CHECK:         llvm.func @run_main_graph({{.*}}: !llvm.ptr<i8>) -> !llvm.ptr<i8> {
+// CHECK:         llvm.func @run_main_graph_with_outputs([[INPUT_:%.+]]: !llvm.ptr<i8>, [[OUTPUT_:%.+]]: !llvm.ptr<i8>) -> !llvm.ptr<i8> {
+// CHECK:           llvm.call @omOutputBuffersBegin([[OUTPUT_]]) : (!llvm.ptr<i8>) -> ()
+// CHECK:           [[RESULTS_:%.+]] = llvm.call @run_main_graph([[INPUT_]]) : (!llvm.ptr<i8>) -> !llvm.ptr<i8>
+// CHECK:           [[RES_:%.+]] = llvm.call @omOutputBuffersEnd([[RESULTS_]]) : (!llvm.ptr<i8>) -> !llvm.ptr<i8>
+// CHECK:           llvm.return [[RES_]] : !llvm.ptr<i8>
+// CHECK:         }
+}
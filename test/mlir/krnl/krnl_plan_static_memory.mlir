@@ -0,0 +1,66 @@
+// RUN: onnx-mlir-opt -O3 --plan-static-memory %s -split-input-file | FileCheck %s
+
+/// MemRefs of different sizes that are not live at the same time share memory.
+/// Each MemRef of the chain is read while the next one is written, so that A
+/// and C share the memory after B.
+func.func @plan_chain(%arg0: f32) -> f32 {
+  %c0 = arith.constant 0 : index
+  %c0_i64 = arith.constant 0 : i64
+  %c200_i64 = arith.constant 200 : i64
+  %c1000_i64 = arith.constant 1000 : i64
+  %0 = memref.alloc() {alignment = 16 : i64} : memref<1400xi8>
+  %1 = "krnl.getref"(%0, %c1000_i64) : (memref<1400xi8>, i64) -> memref<100xf32>
+  %2 = "krnl.getref"(%0, %c200_i64) : (memref<1400xi8>, i64) -> memref<200xf32>
+  %3 = "krnl.getref"(%0, %c0_i64) : (memref<1400xi8>, i64) -> memref<50xf32>
+  krnl.store %arg0, %1[%c0] : memref<100xf32>
+  %4 = krnl.load %1[%c0] : memref<100xf32>
+  krnl.store %4, %2[%c0] : memref<200xf32>
+  %5 = krnl.load %1[%c0] : memref<100xf32>
+  %6 = krnl.load %2[%c0] : memref<200xf32>
+  krnl.store %6, %3[%c0] : memref<50xf32>
+  %7 = krnl.load %2[%c0] : memref<200xf32>
+  %8 = krnl.load %3[%c0] : memref<50xf32>
+  %9 = arith.addf %5, %7 : f32
+  %10 = arith.addf %9, %8 : f32
+  memref.dealloc %0 : memref<1400xi8>
+  return %10 : f32
+
+// CHECK-LABEL:  func @plan_chain
+// CHECK-SAME:     krnl.planned_peak_memory = 1200 : i64
+// CHECK:           [[POOL_:%.+]] = memref.alloc() {alignment = 16 : i64} : memref<1200xi8>
+// CHECK-DAG:       [[OFFSET_0_:%.+]] = arith.constant 0 : i64
+// CHECK-DAG:       [[OFFSET_800_:%.+]] = arith.constant 800 : i64
+// CHECK-DAG:       [[A_:%.+]] = "krnl.getref"([[POOL_]], [[OFFSET_800_]]) : (memref<1200xi8>, i64) -> memref<100xf32>
+// CHECK-DAG:       [[B_:%.+]] = "krnl.getref"([[POOL_]], [[OFFSET_0_]]) : (memref<1200xi8>, i64) -> memref<200xf32>
+// CHECK-DAG:       [[C_:%.+]] = "krnl.getref"([[POOL_]], [[OFFSET_800_]]) : (memref<1200xi8>, i64) -> memref<50xf32>
+// CHECK:           memref.dealloc [[POOL_]] : memref<1200xi8>
+}
+
+// -----
+
+/// MemRefs used in the same loop nest are live at the same time.
+func.func @plan_loop(%arg0: memref<10xf32>) -> memref<10xf32> {
+  %c0_i64 = arith.constant 0 : i64
+  %c48_i64 = arith.constant 48 : i64
+  %0 = memref.alloc() : memref<10xf32>
+  %1 = memref.alloc() : memref<88xi8>
+  %2 = "krnl.getref"(%1, %c48_i64) : (memref<88xi8>, i64) -> memref<10xf32>
+  %3 = "krnl.getref"(%1, %c0_i64) : (memref<88xi8>, i64) -> memref<10xf32>
+  %4 = krnl.define_loops 1
+  krnl.iterate(%4) with (%4 -> %arg1 = 0 to 10) {
+    %5 = krnl.load %arg0[%arg1] : memref<10xf32>
+    krnl.store %5, %2[%arg1] : memref<10xf32>
+    %6 = krnl.load %2[%arg1] : memref<10xf32>
+    krnl.store %6, %3[%arg1] : memref<10xf32>
+    %7 = krnl.load %3[%arg1] : memref<10xf32>
+    krnl.store %7, %0[%arg1] : memref<10xf32>
+  }
+  memref.dealloc %1 : memref<88xi8>
+  return %0 : memref<10xf32>
+
+// CHECK-LABEL:  func @plan_loop
+// CHECK-SAME:     krnl.planned_peak_memory = 80 : i64
+// CHECK:           [[POOL_:%.+]] = memref.alloc() : memref<80xi8>
+// CHECK-DAG:       "krnl.getref"([[POOL_]], {{.*}}) : (memref<80xi8>, i64) -> memref<10xf32>
+// CHECK-DAG:       "krnl.getref"([[POOL_]], {{.*}}) : (memref<80xi8>, i64) -> memref<10xf32>
+}
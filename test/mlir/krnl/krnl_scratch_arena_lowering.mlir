@@ -0,0 +1,19 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm="use-scratch-arena" %s | FileCheck %s
+
+// Test that buffers deallocated by the model use the scratch arenas, and that
+// outputs are still allocated with malloc.
+func.func @test_scratch_arena(%arg0: memref<10xf32>) -> memref<10xf32> {
+  %0 = memref.alloc() {alignment = 64 : i64} : memref<40xi8>
+  %1 = memref.alloc() : memref<10xf32>
+  memref.dealloc %0 : memref<40xi8>
+  return %1 : memref<10xf32>
+
+// CHECK-DAG:     llvm.func @omScratchFree(!llvm.ptr<i8>)
+// CHECK-DAG:     llvm.func @omScratchAlloc(i64, i64) -> !llvm.ptr<i8>
+// CHECK-LABEL:   llvm.func @test_scratch_arena
+// CHECK:           [[ALIGNMENT_:%.+]] = llvm.mlir.constant(64 : i64) : i64
+// CHECK:           [[BUFFER_:%.+]] = llvm.call @omScratchAlloc({{.*}}, [[ALIGNMENT_]]) : (i64, i64) -> !llvm.ptr<i8>
+// CHECK:           llvm.call @malloc
+// CHECK:           llvm.call @omScratchFree({{.*}}) : (!llvm.ptr<i8>) -> ()
+// CHECK-NOT:       llvm.call @free
+}
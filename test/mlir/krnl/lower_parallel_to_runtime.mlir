@@ -0,0 +1,53 @@
+// RUN: onnx-mlir-opt --lower-parallel-to-runtime %s -split-input-file | FileCheck %s
+
+func.func @parallel_copy(%arg0: memref<64x128xf32>, %arg1: memref<64x128xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c64 = arith.constant 64 : index
+  %c128 = arith.constant 128 : index
+  scf.parallel (%i) = (%c0) to (%c64) step (%c1) {
+    scf.for %j = %c0 to %c128 step %c1 {
+      %0 = memref.load %arg0[%i, %j] : memref<64x128xf32>
+      memref.store %0, %arg1[%i, %j] : memref<64x128xf32>
+    }
+  }
+  return
+
+// CHECK-LABEL:  func.func private @parallel_copy_parallel_0
+// CHECK-SAME:     ([[BEGIN_:%.+]]: i64, [[END_:%.+]]: i64, [[CTX_:%.+]]: !llvm.ptr<i8>) {
+// CHECK:           [[CONTEXT_PTR_:%.+]] = llvm.bitcast [[CTX_]] : !llvm.ptr<i8> to !llvm.ptr<struct<{{.*}}>>
+// CHECK:           [[CONTEXT_:%.+]] = llvm.load [[CONTEXT_PTR_]]
+// CHECK:           [[FIELD_0_:%.+]] = llvm.extractvalue [[CONTEXT_]][0]
+// CHECK:           [[INPUT_:%.+]] = builtin.unrealized_conversion_cast [[FIELD_0_]] : !llvm.struct<{{.*}}> to memref<64x128xf32>
+// CHECK:           [[FIELD_1_:%.+]] = llvm.extractvalue [[CONTEXT_]][1]
+// CHECK:           [[OUTPUT_:%.+]] = builtin.unrealized_conversion_cast [[FIELD_1_]] : !llvm.struct<{{.*}}> to memref<64x128xf32>
+// CHECK-DAG:       [[BEGIN_INDEX_:%.+]] = arith.index_cast [[BEGIN_]] : i64 to index
+// CHECK-DAG:       [[END_INDEX_:%.+]] = arith.index_cast [[END_]] : i64 to index
+// CHECK:           scf.for [[I_0_:%.+]] = [[BEGIN_INDEX_]] to [[END_INDEX_]] step {{.*}} {
+// CHECK:             [[VAR_0_:%.+]] = arith.muli [[I_0_]], {{.*}} : index
+// CHECK:             [[VAR_1_:%.+]] = arith.addi {{.*}}, [[VAR_0_]] : index
+// CHECK:             scf.for [[I_1_:%.+]] = {{.*}} {
+// CHECK:               [[LOAD_:%.+]] = memref.load [[INPUT_]]{{.}}[[VAR_1_]], [[I_1_]]{{.}} : memref<64x128xf32>
+// CHECK:               memref.store [[LOAD_]], [[OUTPUT_]]{{.}}[[VAR_1_]], [[I_1_]]{{.}} : memref<64x128xf32>
+// CHECK:             }
+// CHECK:           }
+// CHECK:           return
+// CHECK:         }
+
+// CHECK-LABEL:  func.func @parallel_copy
+// CHECK-SAME:     ([[PARAM_0_:%.+]]: memref<64x128xf32>, [[PARAM_1_:%.+]]: memref<64x128xf32>) {
+// CHECK:           [[CONTEXT_ALLOCA_:%.+]] = llvm.alloca {{.*}} x !llvm.struct<{{.*}}>
+// CHECK-NOT:       scf.parallel
+// CHECK:           scf.execute_region {
+// CHECK-DAG:       [[CAST_0_:%.+]] = builtin.unrealized_conversion_cast [[PARAM_0_]] : memref<64x128xf32> to !llvm.struct<{{.*}}>
+// CHECK-DAG:       [[CAST_1_:%.+]] = builtin.unrealized_conversion_cast [[PARAM_1_]] : memref<64x128xf32> to !llvm.struct<{{.*}}>
+// CHECK:           llvm.store {{.*}}, [[CONTEXT_ALLOCA_]]
+// CHECK:           [[CONTEXT_:%.+]] = llvm.bitcast [[CONTEXT_ALLOCA_]] : !llvm.ptr<struct<{{.*}}>> to !llvm.ptr<i8>
+// CHECK:           [[FUNC_:%.+]] = constant @parallel_copy_parallel_0 : (i64, i64, !llvm.ptr<i8>) -> ()
+// CHECK:           [[FUNC_PTR_:%.+]] = builtin.unrealized_conversion_cast [[FUNC_]]
+// CHECK:           llvm.call @omParallelFor([[FUNC_PTR_]], {{.*}}, [[CONTEXT_]])
+// CHECK:             scf.yield
+// CHECK:           }
+// CHECK:           return
+// CHECK:         }
+}
@@ -0,0 +1,36 @@
+// RUN: onnx-mlir-opt --lower-parallel-to-runtime --buffer-deallocation %s -split-input-file | FileCheck %s
+
+// The buffer read by the outlined loop is freed after the parallel loop
+// completes, not after the last use of the buffer in its function.
+func.func @parallel_dealloc(%arg0: memref<64xf32>, %arg1: memref<64xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c64 = arith.constant 64 : index
+  %cst = arith.constant 2.0 : f32
+  %0 = memref.alloc() : memref<64xf32>
+  scf.for %i = %c0 to %c64 step %c1 {
+    %1 = memref.load %arg0[%i] : memref<64xf32>
+    %2 = arith.mulf %1, %cst : f32
+    memref.store %2, %0[%i] : memref<64xf32>
+  }
+  scf.parallel (%i) = (%c0) to (%c64) step (%c1) {
+    %1 = memref.load %0[%i] : memref<64xf32>
+    memref.store %1, %arg1[%i] : memref<64xf32>
+  }
+  return
+
+// CHECK-LABEL:  func.func @parallel_dealloc
+// CHECK-SAME:     ([[PARAM_0_:%.+]]: memref<64xf32>, [[PARAM_1_:%.+]]: memref<64xf32>) {
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<64xf32>
+// CHECK-NOT:       memref.dealloc
+// CHECK:           scf.execute_region {
+// CHECK-NOT:         memref.dealloc
+// CHECK:             builtin.unrealized_conversion_cast [[RES_]] : memref<64xf32> to !llvm.struct<{{.*}}>
+// CHECK-NOT:         memref.dealloc
+// CHECK:             llvm.call @omParallelFor
+// CHECK:             scf.yield
+// CHECK:           }
+// CHECK:           memref.dealloc [[RES_]] : memref<64xf32>
+// CHECK:           return
+// CHECK:         }
+}
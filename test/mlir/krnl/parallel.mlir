@@ -0,0 +1,38 @@
+// RUN: onnx-mlir-opt -O3 --convert-krnl-to-affine %s -split-input-file | FileCheck %s
+
+func.func @simple_parallel(%arg0 : memref<10x20xf32>) {
+  %ii, %jj = krnl.define_loops 2
+  krnl.parallel(%ii) : !krnl.loop
+  krnl.iterate(%ii, %jj) with (%ii -> %i = 0 to 10, %jj -> %j = 0 to 20) {
+    %cst = arith.constant 0.0 : f32
+    krnl.store %cst, %arg0[%i, %j] : memref<10x20xf32>
+  }
+  return
+
+  // CHECK-LABEL: simple_parallel
+  // CHECK:       affine.parallel ([[I_0_:%.+]]) = (0) to (10) {
+  // CHECK:         affine.for [[I_1_:%.+]] = 0 to 20 {
+  // CHECK:           affine.store {{.*}}, {{.*}}{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<10x20xf32>
+  // CHECK:         }
+  // CHECK:       }
+}
+
+// -----
+
+func.func @parallel_with_block(%arg0 : memref<64xf32>) {
+  %ii = krnl.define_loops 1
+  %ib, %il = krnl.block %ii 16 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  krnl.parallel(%ib) : !krnl.loop
+  krnl.iterate(%ib, %il) with (%ii -> %i = 0 to 64) {
+    %cst = arith.constant 0.0 : f32
+    krnl.store %cst, %arg0[%i] : memref<64xf32>
+  }
+  return
+
+  // CHECK-LABEL: parallel_with_block
+  // CHECK:       affine.parallel ([[I_0_:%.+]]) = (0) to (64) step (16) {
+  // CHECK:         affine.for [[I_1_:%.+]] = #{{.*}}([[I_0_]]) to #{{.*}}([[I_0_]]) {
+  // CHECK:           affine.store {{.*}}, {{.*}}{{.}}[[I_1_]]{{.}} : memref<64xf32>
+  // CHECK:         }
+  // CHECK:       }
+}
@@ -827,3 +827,93 @@ func.func @test_reshape() -> tensor<*xf32> {
 // CHECK:           return [[VAR_0_]] : tensor<1x9xf32>
 // CHECK:         }
 }
+
+// -----
+
+func.func @test_matmul() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>
+  %1 = onnx.Constant dense<[[5.0, 6.0], [7.0, 8.0]]> : tensor<2x2xf32>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<2x2xf32>, tensor<2x2xf32>) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_matmul
+// CHECK-SAME:   () -> tensor<2x2xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[1.900000e+01, 2.200000e+01], [4.300000e+01, 5.000000e+01]{{.}}> : tensor<2x2xf32>
+// CHECK:           return [[VAR_0_]] : tensor<2x2xf32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_gemm() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>
+  %1 = onnx.Constant dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>
+  %2 = onnx.Constant dense<[1.0, 2.0]> : tensor<2xf32>
+  %3 = "onnx.Gemm"(%0, %1, %2) {alpha = 2.0 : f32, transB = 1 : si64} : (tensor<2x2xf32>, tensor<2x2xf32>, tensor<2xf32>) -> tensor<*xf32>
+  "func.return"(%3) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_gemm
+// CHECK-SAME:   () -> tensor<2x2xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[1.100000e+01, 2.400000e+01], [2.300000e+01, 5.200000e+01]{{.}}> : tensor<2x2xf32>
+// CHECK:           return [[VAR_0_]] : tensor<2x2xf32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_conv() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0], [7.0, 8.0, 9.0]]]]> : tensor<1x1x3x3xf32>
+  %1 = onnx.Constant dense<1.0> : tensor<1x1x2x2xf32>
+  %2 = "onnx.NoValue"() {value} : () -> none
+  %3 = "onnx.Conv"(%0, %1, %2) {auto_pad = "NOTSET", group = 1 : si64} : (tensor<1x1x3x3xf32>, tensor<1x1x2x2xf32>, none) -> tensor<*xf32>
+  "func.return"(%3) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_conv
+// CHECK-SAME:   () -> tensor<1x1x2x2xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}{{.}}{{.}}[1.200000e+01, 1.600000e+01], [2.400000e+01, 2.800000e+01]{{.}}{{.}}{{.}}> : tensor<1x1x2x2xf32>
+// CHECK:           return [[VAR_0_]] : tensor<1x1x2x2xf32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_reduce_mean() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>
+  %1 = "onnx.ReduceMean"(%0) {axes = [1], keepdims = 0 : si64} : (tensor<2x2xf32>) -> tensor<*xf32>
+  "func.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_reduce_mean
+// CHECK-SAME:   () -> tensor<2xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<[1.500000e+00, 3.500000e+00]> : tensor<2xf32>
+// CHECK:           return [[VAR_0_]] : tensor<2xf32>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_reduce_sum() -> tensor<*xi64> {
+  %0 = onnx.Constant dense<[[1, 2, 3], [4, 5, 6]]> : tensor<2x3xi64>
+  %1 = onnx.Constant dense<[0]> : tensor<1xi64>
+  %2 = "onnx.ReduceSum"(%0, %1) {keepdims = 1 : si64, noop_with_empty_axes = 0 : si64} : (tensor<2x3xi64>, tensor<1xi64>) -> tensor<*xi64>
+  "func.return"(%2) : (tensor<*xi64>) -> ()
+
+// CHECK-LABEL:  func.func @test_reduce_sum
+// CHECK-SAME:   () -> tensor<1x3xi64> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.}}[5, 7, 9]{{.}}> : tensor<1x3xi64>
+// CHECK:           return [[VAR_0_]] : tensor<1x3xi64>
+// CHECK:         }
+}
+
+// -----
+
+func.func @test_softmax() -> tensor<*xf32> {
+  %0 = onnx.Constant dense<[[1.0, 1.0], [2.0, 2.0]]> : tensor<2x2xf32>
+  %1 = "onnx.Softmax"(%0) {axis = -1 : si64} : (tensor<2x2xf32>) -> tensor<*xf32>
+  "func.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func.func @test_softmax
+// CHECK-SAME:   () -> tensor<2x2xf32> {
+// CHECK:           [[VAR_0_:%.+]] = onnx.Constant dense<{{.*}}5.000000e-01{{.*}}> : tensor<2x2xf32>
+// CHECK:           return [[VAR_0_]] : tensor<2x2xf32>
+// CHECK:         }
+}
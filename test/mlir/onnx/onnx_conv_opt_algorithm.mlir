@@ -0,0 +1,56 @@
+// RUN: onnx-mlir-opt --conv-opt-onnx='select-algorithm' %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --conv-opt-onnx %s -split-input-file | FileCheck %s --check-prefix=DEFAULT
+
+// Without select-algorithm, all convolutions keep the direct loops.
+// DEFAULT-NOT:     conv_algorithm
+
+// -----
+
+// Stride-1 3x3 convolutions with many channels use Winograd.
+func.func @test_conv_winograd(%arg0: tensor<1x64x56x56xf32>, %arg1: tensor<64x64x3x3xf32>, %arg2: tensor<64xf32>) -> tensor<1x64x56x56xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x64x56x56xf32>, tensor<64x64x3x3xf32>, tensor<64xf32>) -> tensor<1x64x56x56xf32>
+  return %0 : tensor<1x64x56x56xf32>
+
+// CHECK-LABEL:  func.func @test_conv_winograd
+// CHECK:           "onnx.Conv"
+// CHECK-SAME:      conv_algorithm = "WINOGRAD_4X4"
+}
+
+// -----
+
+// Strided convolutions with large kernels use im2col.
+func.func @test_conv_im2col(%arg0: tensor<1x3x224x224xf32>, %arg1: tensor<64x3x7x7xf32>) -> tensor<1x64x112x112xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [7, 7], pads = [3, 3, 3, 3], strides = [2, 2]} : (tensor<1x3x224x224xf32>, tensor<64x3x7x7xf32>, none) -> tensor<1x64x112x112xf32>
+  return %1 : tensor<1x64x112x112xf32>
+
+// CHECK-LABEL:  func.func @test_conv_im2col
+// CHECK:           "onnx.Conv"
+// CHECK-SAME:      conv_algorithm = "IM2COL"
+}
+
+// -----
+
+// Depthwise convolutions do too little work per patch: keep the direct loops.
+func.func @test_conv_depthwise_direct(%arg0: tensor<1x32x16x16xf32>, %arg1: tensor<32x1x3x3xf32>) -> tensor<1x32x16x16xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 32 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x32x16x16xf32>, tensor<32x1x3x3xf32>, none) -> tensor<1x32x16x16xf32>
+  return %1 : tensor<1x32x16x16xf32>
+
+// CHECK-LABEL:  func.func @test_conv_depthwise_direct
+// CHECK-NOT:       conv_algorithm
+// CHECK:           return
+}
+
+// -----
+
+// Dynamic shapes keep the direct loops.
+func.func @test_conv_dynamic_direct(%arg0: tensor<?x64x56x56xf32>, %arg1: tensor<64x64x3x3xf32>) -> tensor<?x64x56x56xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<?x64x56x56xf32>, tensor<64x64x3x3xf32>, none) -> tensor<?x64x56x56xf32>
+  return %1 : tensor<?x64x56x56xf32>
+
+// CHECK-LABEL:  func.func @test_conv_dynamic_direct
+// CHECK-NOT:       conv_algorithm
+// CHECK:           return
+}
@@ -0,0 +1,49 @@
+// RUN: onnx-mlir-opt --conv-opt-onnx='simd-data-layout' --layout-prop-onnx %s -split-input-file | FileCheck %s
+
+// -----
+
+// Activations stay in NCHW4C from the first convolution to the Reshape, which
+// depends on the layout.
+func.func @test_layout_prop_conv_relu_conv_add(%arg0: tensor<1x8x16x16xf32>, %arg1: tensor<8x8x3x3xf32>, %arg2: tensor<8x8x3x3xf32>, %arg3: tensor<1x8x16x16xf32>) -> tensor<1x2048xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x8x16x16xf32>, tensor<8x8x3x3xf32>, none) -> tensor<1x8x16x16xf32>
+  %2 = "onnx.Relu"(%1) : (tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32>
+  %3 = "onnx.Conv"(%2, %arg2, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x8x16x16xf32>, tensor<8x8x3x3xf32>, none) -> tensor<1x8x16x16xf32>
+  %4 = "onnx.Add"(%3, %arg3) : (tensor<1x8x16x16xf32>, tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32>
+  %5 = "onnx.Constant"() {value = dense<[1, 2048]> : tensor<2xi64>} : () -> tensor<2xi64>
+  %6 = "onnx.Reshape"(%4, %5) : (tensor<1x8x16x16xf32>, tensor<2xi64>) -> tensor<1x2048xf32>
+  return %6 : tensor<1x2048xf32>
+
+// CHECK-LABEL:  func.func @test_layout_prop_conv_relu_conv_add
+// CHECK-NOT:       target_layout = "STANDARD"
+// CHECK:           [[X_:%.+]] = "onnx.LayoutTransform"(%arg0) {target_layout = #onnx.layout<{dataLayout = "NCHW4C"}>}
+// CHECK-NOT:       target_layout = "STANDARD"
+// CHECK:           [[CONV_0_:%.+]] = "onnx.Conv"([[X_]], {{.*}} -> tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK-NOT:       target_layout = "STANDARD"
+// CHECK:           [[RELU_:%.+]] = "onnx.Relu"([[CONV_0_]]) : (tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>) -> tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK-NOT:       target_layout = "STANDARD"
+// CHECK:           [[CONV_1_:%.+]] = "onnx.Conv"([[RELU_]], {{.*}} -> tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK:           [[ADD_:%.+]] = "onnx.Add"([[CONV_1_]], %arg3) : (tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>, tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK:           [[STD_:%.+]] = "onnx.LayoutTransform"([[ADD_]]) {target_layout = "STANDARD"}
+// CHECK:           "onnx.Reshape"([[STD_]]
+}
+
+// -----
+
+// Pooling and BatchNorm keep the layout; the result is converted back at the
+// end of the graph.
+func.func @test_layout_prop_pool_batchnorm(%arg0: tensor<1x8x16x16xf32>, %arg1: tensor<8x8x3x3xf32>, %arg2: tensor<8xf32>, %arg3: tensor<8xf32>, %arg4: tensor<8xf32>, %arg5: tensor<8xf32>) -> tensor<1x8x8x8xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x8x16x16xf32>, tensor<8x8x3x3xf32>, none) -> tensor<1x8x16x16xf32>
+  %2 = "onnx.MaxPoolSingleOut"(%1) {auto_pad = "NOTSET", kernel_shape = [2, 2], strides = [2, 2]} : (tensor<1x8x16x16xf32>) -> tensor<1x8x8x8xf32>
+  %3 = "onnx.BatchNormalizationInferenceMode"(%2, %arg2, %arg3, %arg4, %arg5) {epsilon = 1.00000007E-5 : f32} : (tensor<1x8x8x8xf32>, tensor<8xf32>, tensor<8xf32>, tensor<8xf32>, tensor<8xf32>) -> tensor<1x8x8x8xf32>
+  return %3 : tensor<1x8x8x8xf32>
+
+// CHECK-LABEL:  func.func @test_layout_prop_pool_batchnorm
+// CHECK:           [[CONV_:%.+]] = "onnx.Conv"
+// CHECK-NOT:       target_layout = "STANDARD"
+// CHECK:           [[POOL_:%.+]] = "onnx.MaxPoolSingleOut"([[CONV_]]) {{.*}} -> tensor<1x8x8x8xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK:           [[BN_:%.+]] = "onnx.BatchNormalizationInferenceMode"([[POOL_]], %arg2, %arg3, %arg4, %arg5) {{.*}} -> tensor<1x8x8x8xf32, #onnx.layout<{dataLayout = "NCHW4C"}>>
+// CHECK:           [[STD_:%.+]] = "onnx.LayoutTransform"([[BN_]]) {target_layout = "STANDARD"}
+// CHECK:           return [[STD_]] : tensor<1x8x8x8xf32>
+}
@@ -0,0 +1,85 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl %s -split-input-file | FileCheck %s
+
+// -----
+
+// Im2col: the patches are gathered into a buffer multiplied by the filters,
+// then the bias is added.
+func.func private @test_conv_im2col(%arg0 : tensor<1x2x8x8xf32>, %arg1 : tensor<4x2x3x3xf32>, %arg2 : tensor<4xf32>) -> tensor<1x4x6x6xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {auto_pad = "NOTSET", conv_algorithm = "IM2COL", group = 1 : si64} : (tensor<1x2x8x8xf32>, tensor<4x2x3x3xf32>, tensor<4xf32>) -> tensor<1x4x6x6xf32>
+  "func.return"(%0) : (tensor<1x4x6x6xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_conv_im2col
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<1x4x6x6xf32>
+// CHECK-DAG:       [[COL_:%.+]] = memref.alloc() {{.*}}: memref<2x3x3x6x6xf32>
+// CHECK:           krnl.memset [[COL_]]
+// CHECK:           krnl.memset [[RES_]]
+// CHECK:           krnl.iterate
+// CHECK:             krnl.iterate
+// CHECK:               krnl.load %arg0
+// CHECK:               krnl.store {{.*}}, [[COL_]]
+// CHECK:             krnl.matmul {{.*}} : memref<2x4x18xf32>, {{.*}}, memref<18x36xf32>, {{.*}}, memref<1x2x4x36xf32>
+// CHECK:           krnl.iterate
+// CHECK:             krnl.load [[RES_]]
+// CHECK:             krnl.load %arg2
+// CHECK:             arith.addf
+// CHECK:             krnl.store {{.*}}, [[RES_]]
+// CHECK:           return [[RES_]] : memref<1x4x6x6xf32>
+}
+
+// -----
+
+// Winograd F(2x2, 3x3): filter and input transforms, one matmul per position
+// in the 4x4 tiles, then the output transform.
+func.func private @test_conv_winograd_2x2(%arg0 : tensor<1x2x6x6xf32>, %arg1 : tensor<4x2x3x3xf32>) -> tensor<1x4x6x6xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", conv_algorithm = "WINOGRAD_2X2", group = 1 : si64, pads = [1, 1, 1, 1]} : (tensor<1x2x6x6xf32>, tensor<4x2x3x3xf32>, none) -> tensor<1x4x6x6xf32>
+  "func.return"(%1) : (tensor<1x4x6x6xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_conv_winograd_2x2
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<1x4x6x6xf32>
+// CHECK-DAG:       [[PADDED_:%.+]] = memref.alloc() {{.*}}: memref<1x2x8x8xf32>
+// CHECK-DAG:       [[U_:%.+]] = memref.alloc() {{.*}}: memref<16x4x2xf32>
+// CHECK-DAG:       [[V_:%.+]] = memref.alloc() {{.*}}: memref<16x2x9xf32>
+// CHECK-DAG:       [[M_:%.+]] = memref.alloc() {{.*}}: memref<16x4x9xf32>
+// CHECK:           krnl.memset [[PADDED_]]
+// CHECK:           krnl.store {{.*}}, [[PADDED_]]
+// CHECK:           krnl.store {{.*}}, [[U_]]
+// CHECK:           krnl.store {{.*}}, [[V_]]
+// CHECK:           krnl.matmul [[U_]]{{.*}}, [[V_]]{{.*}}, [[M_]]
+// CHECK:           krnl.load [[M_]]
+// CHECK:           krnl.store {{.*}}, [[RES_]]
+// CHECK:           return [[RES_]] : memref<1x4x6x6xf32>
+}
+
+// -----
+
+// The last Winograd F(4x4, 3x3) tiles are partial: their stores are guarded.
+func.func private @test_conv_winograd_4x4_partial(%arg0 : tensor<1x2x6x6xf32>, %arg1 : tensor<4x2x3x3xf32>) -> tensor<1x4x6x6xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", conv_algorithm = "WINOGRAD_4X4", group = 1 : si64, pads = [1, 1, 1, 1]} : (tensor<1x2x6x6xf32>, tensor<4x2x3x3xf32>, none) -> tensor<1x4x6x6xf32>
+  "func.return"(%1) : (tensor<1x4x6x6xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_conv_winograd_4x4_partial
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<1x4x6x6xf32>
+// CHECK-DAG:       memref.alloc() {{.*}}: memref<1x2x10x10xf32>
+// CHECK-DAG:       memref.alloc() {{.*}}: memref<36x4x2xf32>
+// CHECK:           krnl.matmul
+// CHECK:           scf.if
+// CHECK:             krnl.store {{.*}}, [[RES_]]
+// CHECK:           return [[RES_]] : memref<1x4x6x6xf32>
+}
+
+// -----
+
+// The Winograd transform of a constant filter is computed at compile time.
+func.func private @test_conv_winograd_constant_filter(%arg0 : tensor<1x1x6x6xf32>) -> tensor<1x1x6x6xf32> {
+  %0 = "onnx.Constant"() {value = dense<[[[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0], [7.0, 8.0, 9.0]]]]> : tensor<1x1x3x3xf32>} : () -> tensor<1x1x3x3xf32>
+  %1 = "onnx.NoValue"() {value} : () -> none
+  %2 = "onnx.Conv"(%arg0, %0, %1) {auto_pad = "NOTSET", conv_algorithm = "WINOGRAD_2X2", group = 1 : si64, pads = [1, 1, 1, 1]} : (tensor<1x1x6x6xf32>, tensor<1x1x3x3xf32>, none) -> tensor<1x1x6x6xf32>
+  "func.return"(%2) : (tensor<1x1x6x6xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_conv_winograd_constant_filter
+// CHECK:           [[U_:%.+]] = "krnl.global"() {alignment = 128 : i64, name = "winograd_{{.*}}", shape = [16, 1, 1], value = dense<{{.}}{{.}}[1.000000e+00]], {{.}}[3.000000e+00]], {{.}}[1.000000e+00]], {{.}}[3.000000e+00]]{{.*}}> : tensor<16x1x1xf32>} : () -> memref<16x1x1xf32>
+// CHECK-NOT:       krnl.store {{.*}}, [[U_]]
+// CHECK:           krnl.matmul [[U_]]
+}
@@ -0,0 +1,126 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl='enable-fusion' %s -split-input-file | FileCheck %s
+
+// -----
+
+// A chain of element-wise ops is computed in a single loop nest, with the
+// operands of the chain broadcast as needed.
+func.func private @test_fuse_chain(%arg0 : tensor<16x32xf32>, %arg1 : tensor<16x32xf32>, %arg2 : tensor<32xf32>) -> tensor<16x32xf32> {
+  %0 = "onnx.Mul"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<16x32xf32>) -> tensor<16x32xf32>
+  %1 = "onnx.Add"(%0, %arg2) : (tensor<16x32xf32>, tensor<32xf32>) -> tensor<16x32xf32>
+  %2 = "onnx.Sigmoid"(%1) : (tensor<16x32xf32>) -> tensor<16x32xf32>
+  %3 = "onnx.Mul"(%arg0, %2) : (tensor<16x32xf32>, tensor<16x32xf32>) -> tensor<16x32xf32>
+  "func.return"(%3) : (tensor<16x32xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_fuse_chain
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<16x32xf32>
+// CHECK-NOT:       memref.alloc
+// CHECK:           [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 16, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 32){
+// CHECK-DAG:         [[LOAD_0_:%.+]] = krnl.load %arg0{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x32xf32>
+// CHECK-DAG:         [[LOAD_1_:%.+]] = krnl.load %arg1{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x32xf32>
+// CHECK:             [[MUL_0_:%.+]] = arith.mulf [[LOAD_0_]], [[LOAD_1_]] : f32
+// CHECK-DAG:         [[LOAD_2_:%.+]] = krnl.load %arg2{{.}}[[I_1_]]{{.}} : memref<32xf32>
+// CHECK-DAG:         [[LOAD_3_:%.+]] = krnl.load %arg0{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x32xf32>
+// CHECK:             [[ADD_:%.+]] = arith.addf [[MUL_0_]], [[LOAD_2_]] : f32
+// CHECK:             math.exp
+// CHECK:             [[SIGMOID_:%.+]] = arith.divf
+// CHECK:             [[MUL_1_:%.+]] = arith.mulf [[LOAD_3_]], [[SIGMOID_]] : f32
+// CHECK:             krnl.store [[MUL_1_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x32xf32>
+// CHECK:           }
+// CHECK-NOT:       krnl.iterate
+// CHECK:           return [[RES_]] : memref<16x32xf32>
+}
+
+// -----
+
+// Results with more than one use are materialized.
+func.func private @test_no_fuse_multiple_uses(%arg0 : tensor<16x32xf32>) -> (tensor<16x32xf32>, tensor<16x32xf32>) {
+  %0 = "onnx.Relu"(%arg0) : (tensor<16x32xf32>) -> tensor<16x32xf32>
+  %1 = "onnx.Exp"(%0) : (tensor<16x32xf32>) -> tensor<16x32xf32>
+  %2 = "onnx.Sqrt"(%0) : (tensor<16x32xf32>) -> tensor<16x32xf32>
+  "func.return"(%1, %2) : (tensor<16x32xf32>, tensor<16x32xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_no_fuse_multiple_uses
+// CHECK:           memref.alloc
+// CHECK:           krnl.iterate
+// CHECK:           memref.alloc
+// CHECK:           krnl.iterate
+// CHECK:           math.exp
+// CHECK:           memref.alloc
+// CHECK:           krnl.iterate
+// CHECK:           math.sqrt
+}
+
+// -----
+
+// Element-wise ops following a Gemm are applied by its alpha/beta epilogue.
+func.func private @test_fuse_gemm_relu(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x64xf32>, %arg2 : tensor<64xf32>) -> tensor<16x64xf32> {
+  %0 = "onnx.Gemm"(%arg0, %arg1, %arg2) : (tensor<16x32xf32>, tensor<32x64xf32>, tensor<64xf32>) -> tensor<16x64xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<16x64xf32>) -> tensor<16x64xf32>
+  "func.return"(%1) : (tensor<16x64xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_fuse_gemm_relu
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<16x64xf32>
+// CHECK:           krnl.matmul
+// CHECK:           krnl.iterate
+// CHECK-DAG:         [[LOAD_R_:%.+]] = krnl.load [[RES_]]{{.}}[[I_0_:%.+]], [[I_1_:%.+]]{{.}} : memref<16x64xf32>
+// CHECK-DAG:         [[LOAD_C_:%.+]] = krnl.load %arg2{{.}}[[I_1_]]{{.}} : memref<64xf32>
+// CHECK:             [[ADD_:%.+]] = arith.addf [[LOAD_R_]], [[LOAD_C_]] : f32
+// CHECK:             [[CMP_:%.+]] = arith.cmpf oge, [[ADD_]], {{.*}} : f32
+// CHECK:             [[SEL_:%.+]] = arith.select [[CMP_]], [[ADD_]], {{.*}} : f32
+// CHECK:             krnl.store [[SEL_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x64xf32>
+// CHECK-NOT:       memref.alloc() {{.*}}: memref<16x64xf32>
+// CHECK:           return [[RES_]] : memref<16x64xf32>
+}
+
+// -----
+
+// Element-wise ops following a tiled MatMul are applied in a single pass once
+// its result is computed.
+func.func private @test_fuse_matmul_clip(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x64xf32>, %arg2 : tensor<f32>, %arg3 : tensor<f32>) -> tensor<16x64xf32> {
+  %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<32x64xf32>) -> tensor<16x64xf32>
+  %1 = "onnx.Clip"(%0, %arg2, %arg3) : (tensor<16x64xf32>, tensor<f32>, tensor<f32>) -> tensor<16x64xf32>
+  "func.return"(%1) : (tensor<16x64xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_fuse_matmul_clip
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<16x64xf32>
+// CHECK:           krnl.matmul
+// CHECK:           krnl.iterate
+// CHECK-DAG:         [[LOAD_R_:%.+]] = krnl.load [[RES_]]{{.}}[[I_0_:%.+]], [[I_1_:%.+]]{{.}} : memref<16x64xf32>
+// CHECK-DAG:         [[LOAD_MIN_:%.+]] = krnl.load %arg2[] : memref<f32>
+// CHECK-DAG:         [[LOAD_MAX_:%.+]] = krnl.load %arg3[] : memref<f32>
+// CHECK:             [[CMP_0_:%.+]] = arith.cmpf olt, [[LOAD_R_]], [[LOAD_MIN_]] : f32
+// CHECK:             [[SEL_0_:%.+]] = arith.select [[CMP_0_]], [[LOAD_MIN_]], [[LOAD_R_]] : f32
+// CHECK:             [[CMP_1_:%.+]] = arith.cmpf olt, [[SEL_0_]], [[LOAD_MAX_]] : f32
+// CHECK:             [[SEL_1_:%.+]] = arith.select [[CMP_1_]], [[SEL_0_]], [[LOAD_MAX_]] : f32
+// CHECK:             krnl.store [[SEL_1_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<16x64xf32>
+// CHECK-NOT:       memref.alloc() {{.*}}: memref<16x64xf32>
+// CHECK:           return [[RES_]] : memref<16x64xf32>
+}
+
+// -----
+
+// A residual add and an activation following a Conv are applied when storing
+// each output pixel.
+func.func private @test_fuse_conv_add_relu(%arg0 : tensor<1x2x8x8xf32>, %arg1 : tensor<4x2x3x3xf32>, %arg2 : tensor<4xf32>, %arg3 : tensor<1x4x6x6xf32>) -> tensor<1x4x6x6xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {auto_pad = "NOTSET", group = 1 : si64} : (tensor<1x2x8x8xf32>, tensor<4x2x3x3xf32>, tensor<4xf32>) -> tensor<1x4x6x6xf32>
+  %1 = "onnx.Add"(%0, %arg3) : (tensor<1x4x6x6xf32>, tensor<1x4x6x6xf32>) -> tensor<1x4x6x6xf32>
+  %2 = "onnx.Relu"(%1) : (tensor<1x4x6x6xf32>) -> tensor<1x4x6x6xf32>
+  "func.return"(%2) : (tensor<1x4x6x6xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_fuse_conv_add_relu
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<1x4x6x6xf32>
+// CHECK-NOT:       memref.alloc() {{.*}}: memref<1x4x6x6xf32>
+// CHECK:           krnl.iterate
+// CHECK:             krnl.iterate
+// CHECK:               krnl.iterate
+// CHECK:                 arith.mulf
+// CHECK:               [[LOAD_BIAS_:%.+]] = krnl.load %arg2
+// CHECK:               [[ADD_0_:%.+]] = arith.addf {{.*}}, [[LOAD_BIAS_]] : f32
+// CHECK:               [[LOAD_RESIDUAL_:%.+]] = krnl.load %arg3
+// CHECK:               [[ADD_1_:%.+]] = arith.addf [[ADD_0_]], [[LOAD_RESIDUAL_]] : f32
+// CHECK:               [[CMP_:%.+]] = arith.cmpf oge, [[ADD_1_]], {{.*}} : f32
+// CHECK:               [[SEL_:%.+]] = arith.select [[CMP_]], [[ADD_1_]], {{.*}} : f32
+// CHECK:               krnl.store [[SEL_]], [[RES_]]
+// CHECK:           return [[RES_]] : memref<1x4x6x6xf32>
+}
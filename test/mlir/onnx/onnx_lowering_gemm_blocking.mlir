@@ -0,0 +1,45 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl='enable-tiling enable-parallel l1-cache-size=32 l2-cache-size=1024 l3-cache-size=8192' %s -split-input-file | FileCheck %s
+
+// -----
+
+// Cache blocks are derived from the cache sizes: the 32-row blocks of A are
+// computed in parallel, each allocating its buffers once, packing its block of
+// A once per 200-deep panel, and packing the panels of B that it multiplies.
+func.func private @test_gemm_blocking_parallel(%arg0 : tensor<256x256xf32>, %arg1 : tensor<256x256xf32>, %arg2 : tensor<256xf32>) -> tensor<*xf32> {
+  %0 ="onnx.Gemm"(%arg0, %arg1, %arg2) : (tensor<256x256xf32>, tensor<256x256xf32>, tensor<256xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_gemm_blocking_parallel
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<256x256xf32>
+// CHECK:           krnl.memset [[RES_]]
+// CHECK-NOT:       memref.alloc
+// CHECK:           krnl.permute
+// CHECK:           krnl.parallel
+// CHECK:           krnl.iterate
+// CHECK:             [[A_BUFF_:%.+]] = memref.alloc() {{.*}}: memref<32x200xf32>
+// CHECK:             [[B_BUFF_:%.+]] = memref.alloc() {{.*}}: memref<200x256xf32>
+// CHECK:             krnl.iterate
+// CHECK:               krnl.copy_to_tile_buffer [[A_BUFF_]], %arg0
+// CHECK:               krnl.iterate
+// CHECK:                 krnl.copy_to_tile_buffer [[B_BUFF_]], %arg1
+// CHECK:                 krnl.matmul [[A_BUFF_]]{{.*}}, [[B_BUFF_]]{{.*}}, [[RES_]]
+// CHECK:           return [[RES_]] : memref<256x256xf32>
+}
+
+// -----
+
+// A constant B is transposed and packed at compile time: no copy of B is left
+// in the computations.
+func.func private @test_gemm_packed_constant_b(%arg0 : tensor<4x2xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Constant"() {value = dense<[[0.0, 1.0], [2.0, 3.0], [4.0, 5.0], [6.0, 7.0], [8.0, 9.0], [10.0, 11.0], [12.0, 13.0], [14.0, 15.0], [16.0, 17.0], [18.0, 19.0], [20.0, 21.0], [22.0, 23.0], [24.0, 25.0], [26.0, 27.0], [28.0, 29.0], [30.0, 31.0]]> : tensor<16x2xf32>} : () -> tensor<16x2xf32>
+  %1 = "onnx.NoValue"() {value} : () -> none
+  %2 ="onnx.Gemm"(%arg0, %0, %1) {transB = 1 : si64} : (tensor<4x2xf32>, tensor<16x2xf32>, none) -> tensor<*xf32>
+  "func.return"(%2) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_gemm_packed_constant_b
+// CHECK:           [[PACKED_:%.+]] = "krnl.global"() {alignment = 128 : i64, name = "packed_{{.*}}", shape = [2, 16], value = dense<{{.}}[0.000000e+00, 2.000000e+00, {{.*}}], [1.000000e+00, 3.000000e+00, {{.*}}]{{.}}> : tensor<2x16xf32>} : () -> memref<2x16xf32>
+// CHECK-NOT:       krnl.copy_to_tile_buffer {{.*}}, [[PACKED_]]
+// CHECK:           krnl.copy_to_tile_buffer {{.*}}, %arg0
+// CHECK-NOT:       krnl.copy_to_tile_buffer
+// CHECK:           krnl.matmul {{.*}}, [[PACKED_]]{{.*}}
+}
@@ -0,0 +1,57 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl='enable-in-place' %s -split-input-file | FileCheck %s
+
+// -----
+
+// An element-wise op reuses the buffer of an operand without other uses.
+func.func private @test_in_place_unary(%arg0 : tensor<10x10xf32>, %arg1 : tensor<10x10xf32>) -> tensor<10x10xf32> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<10x10xf32>, tensor<10x10xf32>) -> tensor<10x10xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  "func.return"(%1) : (tensor<10x10xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_in_place_unary
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<10x10xf32>
+// CHECK-NOT:       memref.alloc
+// CHECK:           krnl.iterate
+// CHECK:             arith.addf
+// CHECK:             krnl.store {{.*}}, [[RES_]]{{.}}[[I_0_:%.+]], [[I_1_:%.+]]{{.}} : memref<10x10xf32>
+// CHECK:           krnl.iterate
+// CHECK:             [[LOAD_:%.+]] = krnl.load [[RES_]]{{.}}[[I_2_:%.+]], [[I_3_:%.+]]{{.}} : memref<10x10xf32>
+// CHECK:             arith.cmpf
+// CHECK:             krnl.store {{.*}}, [[RES_]]{{.}}[[I_2_]], [[I_3_]]{{.}} : memref<10x10xf32>
+// CHECK:           return [[RES_]] : memref<10x10xf32>
+}
+
+// -----
+
+// Binary ops reuse the buffer of either operand.
+func.func private @test_in_place_binary(%arg0 : tensor<10x10xf32>, %arg1 : tensor<10x10xf32>) -> tensor<10x10xf32> {
+  %0 = "onnx.Exp"(%arg0) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  %1 = "onnx.Mul"(%arg1, %0) : (tensor<10x10xf32>, tensor<10x10xf32>) -> tensor<10x10xf32>
+  "func.return"(%1) : (tensor<10x10xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_in_place_binary
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<10x10xf32>
+// CHECK-NOT:       memref.alloc
+// CHECK:           math.exp
+// CHECK:           arith.mulf
+// CHECK:           krnl.store {{.*}}, [[RES_]]
+// CHECK:           return [[RES_]] : memref<10x10xf32>
+}
+
+// -----
+
+// Operands with other uses, or that are function arguments, are not reused.
+func.func private @test_no_in_place(%arg0 : tensor<10x10xf32>) -> (tensor<10x10xf32>, tensor<10x10xf32>) {
+  %0 = "onnx.Relu"(%arg0) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  %1 = "onnx.Exp"(%0) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  %2 = "onnx.Sqrt"(%0) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  "func.return"(%1, %2) : (tensor<10x10xf32>, tensor<10x10xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_no_in_place
+// CHECK:           memref.alloc
+// CHECK:           krnl.iterate
+// CHECK:           memref.alloc
+// CHECK:           math.exp
+// CHECK:           memref.alloc
+// CHECK:           math.sqrt
+}
@@ -0,0 +1,36 @@
+// RUN: onnx-mlir-opt -O3 --conv-opt-onnx='simd-data-layout' --layout-prop-onnx --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// The ops between the convolution and the end of the graph compute on NCHW4C
+// buffers: Relu, Add, MaxPool, and BatchNorm load and store their activations
+// through the NCHW4C map, and no activation is stored in the standard layout
+// until the result of the graph.
+func.func @test_lowering_layout_prop_conv_relu_add_pool_batchnorm(%arg0: tensor<1x8x16x16xf32>, %arg1: tensor<8x8x3x3xf32>, %arg2: tensor<1x8x16x16xf32>, %arg3: tensor<8xf32>, %arg4: tensor<8xf32>, %arg5: tensor<8xf32>, %arg6: tensor<8xf32>) -> tensor<1x8x8x8xf32> {
+  %0 = "onnx.NoValue"() {value} : () -> none
+  %1 = "onnx.Conv"(%arg0, %arg1, %0) {auto_pad = "NOTSET", group = 1 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x8x16x16xf32>, tensor<8x8x3x3xf32>, none) -> tensor<1x8x16x16xf32>
+  %2 = "onnx.Relu"(%1) : (tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32>
+  %3 = "onnx.Add"(%2, %arg2) : (tensor<1x8x16x16xf32>, tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32>
+  %4 = "onnx.MaxPoolSingleOut"(%3) {auto_pad = "NOTSET", kernel_shape = [2, 2], strides = [2, 2]} : (tensor<1x8x16x16xf32>) -> tensor<1x8x8x8xf32>
+  %5 = "onnx.BatchNormalizationInferenceMode"(%4, %arg3, %arg4, %arg5, %arg6) {epsilon = 1.00000007E-5 : f32} : (tensor<1x8x8x8xf32>, tensor<8xf32>, tensor<8xf32>, tensor<8xf32>, tensor<8xf32>) -> tensor<1x8x8x8xf32>
+  return %5 : tensor<1x8x8x8xf32>
+
+// CHECK-DAG:   [[MAP_NCHW4C_:#.+]] = affine_map<(d0, d1, d2, d3) -> (d0, d1 floordiv 4, d2, d3, d1 mod 4)>
+// CHECK-LABEL:  func.func @test_lowering_layout_prop_conv_relu_add_pool_batchnorm
+// CHECK-NOT:       memref.alloc() {{.*}}: memref<1x8x16x16xf32>
+// CHECK:           arith.cmpf oge
+// CHECK:           [[RELU_VAL_:%.+]] = arith.select
+// CHECK:           krnl.store [[RELU_VAL_]], [[RELU_:%[a-zA-Z0-9_]+]]{{.}}{{.*}}{{.}} : memref<1x8x16x16xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.load [[RELU_]]{{.}}{{.*}}{{.}} : memref<1x8x16x16xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.load %arg2{{.}}{{.*}}{{.}} : memref<1x8x16x16xf32>
+// CHECK:           [[ADD_VAL_:%.+]] = arith.addf
+// CHECK:           krnl.store [[ADD_VAL_]], [[ADD_:%[a-zA-Z0-9_]+]]{{.}}{{.*}}{{.}} : memref<1x8x16x16xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.load [[ADD_]]{{.}}{{.*}}{{.}} : memref<1x8x16x16xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.store {{%[a-zA-Z0-9_]+}}, [[POOL_:%[a-zA-Z0-9_]+]]{{.}}{{.*}}{{.}} : memref<1x8x8x8xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.load [[POOL_]]{{.}}{{.*}}{{.}} : memref<1x8x8x8xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.store {{%[a-zA-Z0-9_]+}}, [[BN_:%[a-zA-Z0-9_]+]]{{.}}{{.*}}{{.}} : memref<1x8x8x8xf32, [[MAP_NCHW4C_]]>
+// CHECK-NOT:       memref.alloc() {{.*}}: memref<1x8x16x16xf32>
+// CHECK:           krnl.load [[BN_]]{{.}}{{.*}}{{.}} : memref<1x8x8x8xf32, [[MAP_NCHW4C_]]>
+// CHECK:           krnl.store {{%[a-zA-Z0-9_]+}}, [[RES_:%[a-zA-Z0-9_]+]]{{.}}{{.*}}{{.}} : memref<1x8x8x8xf32>
+// CHECK:           return [[RES_]] : memref<1x8x8x8xf32>
+}
@@ -0,0 +1,63 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl='enable-parallel' %s -split-input-file | FileCheck %s
+
+// -----
+
+// Large elementwise ops run all but the innermost loop in parallel.
+func.func private @test_add_parallel(%arg0 : tensor<64x128xf32>, %arg1 : tensor<64x128xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<64x128xf32>, tensor<64x128xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_add_parallel
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<64x128xf32>
+// CHECK:           [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.parallel([[LOOP_0_]]#0) : !krnl.loop
+// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 64, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 128){
+// CHECK:             arith.addf
+// CHECK:             krnl.store {{.*}}, [[RES_]]{{.}}{{.*}}{{.}} : memref<64x128xf32>
+// CHECK:           return [[RES_]] : memref<64x128xf32>
+}
+
+// -----
+
+// Small elementwise ops stay serial.
+func.func private @test_add_serial(%arg0 : tensor<10x10xf32>, %arg1 : tensor<10x10xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<10x10xf32>, tensor<10x10xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_add_serial
+// CHECK:           [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK-NOT:       krnl.parallel
+// CHECK:           return
+}
+
+// -----
+
+// Each parallel iteration of the softmax outer loops gets its own accumulators,
+// and no accumulators are shared by the iterations.
+func.func private @test_softmax_parallel(%arg0 : tensor<64x256xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Softmax"(%arg0) {axis = 1 : si64} : (tensor<64x256xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_softmax_parallel
+// CHECK-NOT:       memref.alloc() : memref<f32>
+// CHECK:           [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.parallel([[LOOP_0_]]) : !krnl.loop
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to 64){
+// CHECK-DAG:         memref.alloca() : memref<f32>
+// CHECK-DAG:         memref.alloca() : memref<f32>
+}
+
+// -----
+
+// Reductions parallelize their leading non-reduced dimensions.
+func.func private @test_reducesum_parallel(%arg0 : tensor<64x256xf32>) -> tensor<*xf32> {
+  %0 ="onnx.ReduceSumV11"(%arg0) {axes=[1], keepdims = 0 : si64} : (tensor<64x256xf32>)-> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_reducesum_parallel
+// CHECK:           krnl.define_loops 1
+// CHECK:           [[LOOP_1_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.parallel([[LOOP_1_]]#0) : !krnl.loop
+// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1) with ([[LOOP_1_]]#0 -> [[I_0_:%.+]] = 0 to 64, [[LOOP_1_]]#1 -> [[I_1_:%.+]] = 0 to 256){
+// CHECK:             arith.addf
+}
@@ -0,0 +1,71 @@
+// RUN: onnx-mlir-opt -O3 --shape-inference --convert-onnx-to-krnl='enable-simd' %s -split-input-file | FileCheck %s
+
+// -----
+
+// Innermost dimension is a multiple of the vector length: SIMD code only.
+func.func private @test_add_simd(%arg0 : tensor<16x32xf32>, %arg1 : tensor<16x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<16x32xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_add_simd
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<16x32xf32>
+// CHECK:           [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 16, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 8){
+// CHECK:             [[VAR_1_:%.+]] = arith.muli
+// CHECK-DAG:         [[LOAD_0_:%.+]] = vector.load %arg0{{.}}[[I_0_]], [[VAR_1_]]{{.}} : memref<16x32xf32>, vector<4xf32>
+// CHECK-DAG:         [[LOAD_1_:%.+]] = vector.load %arg1{{.}}[[I_0_]], [[VAR_1_]]{{.}} : memref<16x32xf32>, vector<4xf32>
+// CHECK:             [[VAR_2_:%.+]] = arith.addf [[LOAD_0_]], [[LOAD_1_]] : vector<4xf32>
+// CHECK:             vector.store [[VAR_2_]], [[RES_]]{{.}}[[I_0_]], [[VAR_1_]]{{.}} : memref<16x32xf32>, vector<4xf32>
+// CHECK-NOT:       krnl.iterate
+// CHECK:           return [[RES_]] : memref<16x32xf32>
+}
+
+// -----
+
+// Remaining elements of the innermost dimension are computed by scalar code.
+func.func private @test_relu_simd_tail(%arg0 : tensor<10x10xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Relu"(%arg0) : (tensor<10x10xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_relu_simd_tail
+// CHECK:           [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 10, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 2){
+// CHECK:             [[LOAD_:%.+]] = vector.load
+// CHECK:             [[CST_0_:%.+]] = arith.constant dense<0.000000e+00> : vector<4xf32>
+// CHECK:             [[CMP_:%.+]] = arith.cmpf oge, [[LOAD_]], [[CST_0_]] : vector<4xf32>
+// CHECK:             [[SEL_:%.+]] = arith.select [[CMP_]], [[LOAD_]], [[CST_0_]] : vector<4xi1>, vector<4xf32>
+// CHECK:             vector.store [[SEL_]]
+// CHECK:           [[LOOP_1_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1) with ([[LOOP_1_]]#0 -> [[I_2_:%.+]] = 0 to 10, [[LOOP_1_]]#1 -> [[I_3_:%.+]] = 8 to 10){
+// CHECK:             krnl.load %arg0{{.}}[[I_2_]], [[I_3_]]{{.}} : memref<10x10xf32>
+// CHECK:             arith.cmpf oge, {{.*}} : f32
+}
+
+// -----
+
+// Single-element operands are broadcast to vectors.
+func.func private @test_mul_scalar_simd(%arg0 : tensor<8x64xf32>, %arg1 : tensor<f32>) -> tensor<*xf32> {
+  %0 = "onnx.Mul"(%arg0, %arg1) : (tensor<8x64xf32>, tensor<f32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_mul_scalar_simd
+// CHECK:           krnl.iterate
+// CHECK-DAG:         [[LOAD_0_:%.+]] = vector.load %arg0
+// CHECK-DAG:         [[LOAD_1_:%.+]] = krnl.load %arg1[] : memref<f32>
+// CHECK:             [[BCAST_:%.+]] = vector.broadcast [[LOAD_1_]] : f32 to vector<4xf32>
+// CHECK:             arith.mulf [[LOAD_0_]], [[BCAST_]] : vector<4xf32>
+// CHECK:             vector.store
+}
+
+// -----
+
+// Other broadcasts use the scalar code.
+func.func private @test_add_broadcast_no_simd(%arg0 : tensor<8x64xf32>, %arg1 : tensor<64xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<8x64xf32>, tensor<64xf32>) -> tensor<*xf32>
+  "func.return"(%0) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func private @test_add_broadcast_no_simd
+// CHECK-NOT:       vector.load
+// CHECK:           arith.addf {{.*}} : f32
+// CHECK:           return
+}
@@ -12,6 +12,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
+#include <cstring>
+#include <thread>
+
 #include "mlir/IR/BuiltinOps.h"
 
 #include "include/OnnxMlirRuntime.h"
@@ -94,6 +98,45 @@ bool ModelLibBuilder::run() {
   return true;
 }
 
+bool ModelLibBuilder::runConcurrently(int numThreads, int numRuns) {
+  assert(inputs && outputs && exec && "expected successful run");
+  std::atomic<bool> success(true);
+  auto runAndCompare = [&]() {
+    for (int i = 0; i < numRuns && success; ++i) {
+      OMTensorList *runOutputs = nullptr;
+      try {
+        runOutputs = exec->run(inputs);
+      } catch (const std::runtime_error &error) {
+        std::cerr << "error while running: " << error.what() << std::endl;
+        success = false;
+        return;
+      }
+      // Runs compute the same outputs bit for bit.
+      int64_t numOutputs = omTensorListGetSize(outputs);
+      if (omTensorListGetSize(runOutputs) != numOutputs)
+        success = false;
+      for (int64_t j = 0; j < numOutputs && success; ++j) {
+        OMTensor *res = omTensorListGetOmtByIndex(runOutputs, j);
+        OMTensor *ref = omTensorListGetOmtByIndex(outputs, j);
+        int64_t size = omTensorGetBufferSize(ref);
+        if (omTensorGetBufferSize(res) != size ||
+            memcmp(omTensorGetDataPtr(res), omTensorGetDataPtr(ref), size)) {
+          std::cerr << "output " << j << " differs in concurrent run"
+                    << std::endl;
+          success = false;
+        }
+      }
+      omTensorListDestroy(runOutputs);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i)
+    threads.emplace_back(runAndCompare);
+  for (std::thread &thread : threads)
+    thread.join();
+  return success;
+}
+
 void ModelLibBuilder::setRandomNumberGeneratorSeed(const std::string &envVar) {
   bool hasSeedValue = false;
   unsigned int seed = 0;
@@ -102,6 +102,10 @@ public:
   virtual bool prepareInputs() = 0;
   // Run model using prepared inputs, resulting in outputs. It must run fourth.
   bool run();
+  // Run model numRuns times from each of numThreads concurrent threads using
+  // the prepared inputs, and check that each run computes the same outputs as
+  // run(). It can run after run().
+  bool runConcurrently(int numThreads, int numRuns);
   // Verify outputs from a run with reference data. It can run last.
   virtual bool verifyOutputs() = 0;
 
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====-- TestConcurrentRun.cpp - test concurrent runs of a model -===========//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains the code to test that compiled models can be run
+// concurrently by several threads through a single execution session, with
+// and without per-thread scratch arenas and memory pools reused across
+// inferences.
+//
+//===----------------------------------------------------------------------===//
+
+// Common.hpp needs to be included first to correctly suppress the rapidcheck.h
+// warnings.
+#include "Common.hpp"
+
+static const llvm::StringRef SHARED_LIB_BASE("./TestConcurrentRun_main_graph");
+
+static const int NUM_THREADS = 8;
+static const int NUM_RUNS = 20;
+
+using namespace mlir;
+
+namespace onnx_mlir {
+namespace test {
+
+// Returns whether concurrent runs of an onnx-mlir compiled LSTM, which uses
+// internal buffers and a memory pool, produce the results of a single run.
+static bool isConcurrentRunTheSameAsRunFor(const bool scratchArena,
+    const bool reusePool, const int S, const int B, const int I, const int H,
+    const bool isDynamicS) {
+  static int testNum = 0;
+  printf("attempt %d with scratchArena %d, reusePool %d, S %d, B %d, I %d, "
+         "H %d, isDynS %d\n",
+      ++testNum, scratchArena, reusePool, S, B, I, H, isDynamicS);
+  useScratchArena = scratchArena;
+  enableMemoryBundling = reusePool;
+  reuseMemoryPool = reusePool;
+  LSTMLibBuilder lstm(SHARED_LIB_BASE.str(), /*direction=*/2, S, B, I, H,
+      isDynamicS, /*isDynamicB=*/false);
+  return lstm.build() && lstm.compileAndLoad() && lstm.prepareInputs() &&
+         lstm.run() && lstm.verifyOutputs() &&
+         lstm.runConcurrently(NUM_THREADS, NUM_RUNS);
+}
+
+} // namespace test
+} // namespace onnx_mlir
+
+int main(int argc, char *argv[]) {
+  using namespace onnx_mlir;
+  using namespace onnx_mlir::test;
+
+  llvm::FileRemover remover(
+      onnx_mlir::getTargetFilename(SHARED_LIB_BASE.str(), onnx_mlir::EmitLib));
+
+  ModelLibBuilder::setRandomNumberGeneratorSeed("TEST_SEED");
+  setCompilerOption(OptionKind::CompilerOptLevel, "3");
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "TestConcurrentRun\n", nullptr, "TEST_ARGS");
+  std::cout << "Target options: \""
+            << getCompilerOption(OptionKind::TargetAccel) << "\"\n";
+
+  printf("RapidCheck test case generation.\n");
+  bool success = rc::check("Concurrent runs correctness", []() {
+    const auto scratchArena = *rc::gen::arbitrary<bool>();
+    const auto reusePool = *rc::gen::arbitrary<bool>();
+    const auto S = *rc::gen::inRange(1, 5);
+    const auto B = *rc::gen::inRange(1, 5);
+    const auto I = *rc::gen::inRange(5, 10);
+    const auto H = *rc::gen::inRange(5, 10);
+    const auto isDynS = *rc::gen::arbitrary<bool>();
+    RC_ASSERT(isConcurrentRunTheSameAsRunFor(
+        scratchArena, reusePool, S, B, I, H, isDynS));
+  });
+  if (!success)
+    return 1;
+
+  printf("\n\nExhaustive test case generation.\n");
+  for (int scratchArena = 0; scratchArena < 2; scratchArena++)
+    for (int reusePool = 0; reusePool < 2; reusePool++)
+      for (int isDynS = 0; isDynS < 2; isDynS++)
+        assert(isConcurrentRunTheSameAsRunFor(
+            scratchArena == 1, reusePool == 1, 3, 2, 4, 4, isDynS == 1));
+
+  return 0;
+}
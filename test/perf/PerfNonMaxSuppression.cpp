@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- PerfNonMaxSuppression.cpp - NMS performance tests -----------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains performance tests of the NonMaxSuppression runtime
+// function, on the post-processing of the anchors of a detection model.
+//   * Time is set to report in microseconds (us)
+//   * Complexity is calculated in the original nanoseconds.
+//
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "OnnxMlirRuntime.h"
+#include "test/perf/PerfHelper.hpp"
+
+// Called by the generated code, not part of the runtime API.
+extern "C" void omTensorNonMaxSuppression(OMTensor *selectedTensor,
+    const OMTensor *boxesTensor, const OMTensor *scoresTensor,
+    int64_t maxOutputPerClass, float iouThreshold, float scoreThreshold,
+    int64_t centerPointBox);
+
+// Select at most 100 boxes per class among n anchors, whose boxes are spread
+// over a 640x640 image and whose scores are mostly low, as with the anchors of
+// a detection model.
+static void selectBoxes(benchmark::State &state, int64_t numClasses) {
+  const int64_t n = state.range(0);
+  const int64_t maxOutputPerClass = 100;
+  int64_t boxesShape[] = {1, n, 4};
+  int64_t scoresShape[] = {1, numClasses, n};
+  int64_t selectedShape[] = {numClasses * maxOutputPerClass, 3};
+  std::vector<float> boxes(n * 4), scores(numClasses * n);
+  std::vector<int64_t> selected(numClasses * maxOutputPerClass * 3);
+  srand(0);
+  for (int64_t i = 0; i < n; ++i) {
+    float y = static_cast<float>(rand() % 600);
+    float x = static_cast<float>(rand() % 600);
+    boxes[4 * i] = y;
+    boxes[4 * i + 1] = x;
+    boxes[4 * i + 2] = y + static_cast<float>(8 + rand() % 64);
+    boxes[4 * i + 3] = x + static_cast<float>(8 + rand() % 64);
+  }
+  for (int64_t i = 0; i < numClasses * n; ++i)
+    scores[i] = static_cast<float>(rand() % 10000) / 10000 *
+                static_cast<float>(rand() % 10000) / 10000;
+  OMTensor *boxesTensor =
+      omTensorCreate(boxes.data(), boxesShape, 3, ONNX_TYPE_FLOAT);
+  OMTensor *scoresTensor =
+      omTensorCreate(scores.data(), scoresShape, 3, ONNX_TYPE_FLOAT);
+  OMTensor *selectedTensor =
+      omTensorCreate(selected.data(), selectedShape, 2, ONNX_TYPE_INT64);
+  for (auto _ : state) {
+    omTensorNonMaxSuppression(selectedTensor, boxesTensor, scoresTensor,
+        maxOutputPerClass, /*iouThreshold=*/0.5f, /*scoreThreshold=*/0.05f,
+        /*centerPointBox=*/0);
+    benchmark::DoNotOptimize(selected.data());
+  }
+  state.SetComplexityN(n);
+  state.SetItemsProcessed(state.iterations() * numClasses * n);
+  omTensorDestroy(selectedTensor);
+  omTensorDestroy(scoresTensor);
+  omTensorDestroy(boxesTensor);
+}
+
+static void BM_NonMaxSuppression1Class(benchmark::State &state) {
+  selectBoxes(state, 1);
+}
+BENCHMARK(BM_NonMaxSuppression1Class)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
+
+// Anchors of the 80 classes of the COCO dataset.
+static void BM_NonMaxSuppression80Classes(benchmark::State &state) {
+  selectBoxes(state, 80);
+}
+BENCHMARK(BM_NonMaxSuppression80Classes)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 14)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
+
+PERF_MAIN()
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------------------- PerfSort.cpp - Sort performance tests -----------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains performance tests of the sort runtime function used by
+// the lowering of ops such as NonMaxSuppression.
+//   * Time is set to report in microseconds (us)
+//   * Complexity is calculated in the original nanoseconds.
+//   * The order is reset at each iteration, as the generated code does.
+//
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "OnnxMlirRuntime.h"
+#include "test/perf/PerfHelper.hpp"
+
+// Called by the generated code, not part of the runtime API.
+extern "C" void omTensorSort(OMTensor *orderTensor,
+    const OMTensor *inputTensor, uint64_t axis, uint64_t ascending);
+
+enum Pattern { RANDOM, SORTED, FEW_VALUES };
+
+template <typename T>
+static void sortSlices(benchmark::State &state, OM_DATA_TYPE dataType,
+    int64_t numSlices, Pattern pattern) {
+  int64_t n = state.range(0);
+  int64_t shape[] = {numSlices, n};
+  std::vector<T> data(numSlices * n);
+  std::vector<uint64_t> order(numSlices * n);
+  srand(0);
+  for (int64_t i = 0; i < numSlices * n; ++i) {
+    if (pattern == SORTED)
+      data[i] = static_cast<T>(i % n);
+    else if (pattern == FEW_VALUES)
+      data[i] = static_cast<T>(rand() % 16);
+    else
+      data[i] = static_cast<T>(rand() % 1000000) / static_cast<T>(7);
+  }
+  OMTensor *input = omTensorCreate(data.data(), shape, 2, dataType);
+  OMTensor *orderTensor =
+      omTensorCreate(order.data(), shape, 2, ONNX_TYPE_INT64);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < numSlices * n; ++i)
+      order[i] = i % n;
+    omTensorSort(orderTensor, input, /*axis=*/1, /*ascending=*/0);
+    benchmark::DoNotOptimize(order.data());
+  }
+  state.SetComplexityN(n);
+  state.SetItemsProcessed(state.iterations() * numSlices * n);
+  omTensorDestroy(orderTensor);
+  omTensorDestroy(input);
+}
+
+static void BM_SortFloat(benchmark::State &state) {
+  sortSlices<float>(state, ONNX_TYPE_FLOAT, 1, RANDOM);
+}
+BENCHMARK(BM_SortFloat)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 21)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
+
+// Already sorted slices, e.g. scores sorted by a previous op.
+static void BM_SortFloatSorted(benchmark::State &state) {
+  sortSlices<float>(state, ONNX_TYPE_FLOAT, 1, SORTED);
+}
+BENCHMARK(BM_SortFloatSorted)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 21)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+static void BM_SortFloatFewValues(benchmark::State &state) {
+  sortSlices<float>(state, ONNX_TYPE_FLOAT, 1, FEW_VALUES);
+}
+BENCHMARK(BM_SortFloatFewValues)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 21)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
+
+static void BM_SortInt8(benchmark::State &state) {
+  sortSlices<int8_t>(state, ONNX_TYPE_INT8, 1, FEW_VALUES);
+}
+BENCHMARK(BM_SortInt8)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 21)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
+
+// Scores of the boxes of 80 classes, sorted by NonMaxSuppression.
+static void BM_SortFloat80Slices(benchmark::State &state) {
+  sortSlices<float>(state, ONNX_TYPE_FLOAT, 80, RANDOM);
+}
+BENCHMARK(BM_SortFloat80Slices)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 15)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
+
+PERF_MAIN()
@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- OMIndexLookupTest.c - OMIndexLookup Unit Test ------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the perfect hash table lookups.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Called by the generated code, not part of the runtime API.
+uint64_t find_index_str(
+    const char *str, const int32_t G[], const int32_t V[], int32_t dictSize);
+uint64_t find_index_i64(
+    int64_t val, const int32_t G[], const int32_t V[], int32_t dictSize);
+void find_indices_str(OMTensor *indicesTensor, const OMTensor *keysTensor,
+    const OMTensor *GTensor, const OMTensor *VTensor);
+void find_indices_i64(OMTensor *indicesTensor, const OMTensor *keysTensor,
+    const OMTensor *GTensor, const OMTensor *VTensor);
+
+// The table has a free slot, as the parity of FNV only depends on the seed
+// and on the parity of the characters.
+#define NUM_KEYS 6
+#define DICT_SIZE 7
+
+// Build a table that maps the keys to their position, by searching a hash
+// function that maps them to distinct slots. The slot of a key is found by
+// looking it up in a table whose values are the slots.
+static void testIntTable() {
+  int64_t keys[NUM_KEYS] = {-5, 0, 7, 42, (int64_t)1 << 40, INT64_MIN};
+  int32_t G[DICT_SIZE], V[DICT_SIZE];
+  uint64_t slots[NUM_KEYS];
+  int found = 0;
+  for (int32_t seed = 1; seed < 100000 && !found; ++seed) {
+    for (int32_t i = 0; i < DICT_SIZE; ++i) {
+      G[i] = seed;
+      V[i] = i;
+    }
+    found = 1;
+    for (int32_t k = 0; k < NUM_KEYS && found; ++k) {
+      slots[k] = find_index_i64(keys[k], G, V, DICT_SIZE);
+      for (int32_t j = 0; j < k; ++j)
+        found &= slots[j] != slots[k];
+    }
+  }
+  assert(found && "no hash function maps the keys to distinct slots");
+  for (int32_t k = 0; k < NUM_KEYS; ++k)
+    V[slots[k]] = k;
+  for (int32_t k = 0; k < NUM_KEYS; ++k)
+    assert(find_index_i64(keys[k], G, V, DICT_SIZE) == (uint64_t)k);
+}
+
+static void testStrTable() {
+  const char *keys[NUM_KEYS] = {
+      "cat", "dog", "", "tiger", "\xc3\xa9", "beaver"};
+  int32_t G[DICT_SIZE], V[DICT_SIZE];
+  uint64_t slots[NUM_KEYS];
+  int found = 0;
+  for (int32_t seed = 1; seed < 100000 && !found; ++seed) {
+    for (int32_t i = 0; i < DICT_SIZE; ++i) {
+      G[i] = seed;
+      V[i] = i;
+    }
+    found = 1;
+    for (int32_t k = 0; k < NUM_KEYS && found; ++k) {
+      slots[k] = find_index_str(keys[k], G, V, DICT_SIZE);
+      for (int32_t j = 0; j < k; ++j)
+        found &= slots[j] != slots[k];
+    }
+  }
+  assert(found && "no hash function maps the keys to distinct slots");
+  for (int32_t k = 0; k < NUM_KEYS; ++k)
+    V[slots[k]] = k;
+  for (int32_t k = 0; k < NUM_KEYS; ++k)
+    assert(find_index_str(keys[k], G, V, DICT_SIZE) == (uint64_t)k);
+}
+
+// Check that the lookup of a tensor of keys matches the lookup of each key,
+// with an arbitrary table mixing direct and hashed slots.
+static void testBatch(int64_t numKeys, int32_t dictSize) {
+  int64_t tableShape[] = {dictSize};
+  int64_t keysShape[] = {numKeys};
+  OMTensor *GTensor = omTensorCreateEmpty(tableShape, 1, ONNX_TYPE_INT32);
+  OMTensor *VTensor = omTensorCreateEmpty(tableShape, 1, ONNX_TYPE_INT32);
+  int32_t *G = (int32_t *)omTensorGetDataPtr(GTensor);
+  int32_t *V = (int32_t *)omTensorGetDataPtr(VTensor);
+  for (int32_t i = 0; i < dictSize; ++i) {
+    G[i] = rand() % 3 ? rand() % 1000 : -(rand() % dictSize) - 1;
+    V[i] = rand() % dictSize;
+  }
+
+  OMTensor *ints = omTensorCreateEmpty(keysShape, 1, ONNX_TYPE_INT64);
+  OMTensor *indices = omTensorCreateEmpty(keysShape, 1, ONNX_TYPE_INT64);
+  int64_t *intKeys = (int64_t *)omTensorGetDataPtr(ints);
+  uint64_t *result = (uint64_t *)omTensorGetDataPtr(indices);
+  for (int64_t i = 0; i < numKeys; ++i)
+    intKeys[i] = ((int64_t)rand() << 20) - i;
+  find_indices_i64(indices, ints, GTensor, VTensor);
+  for (int64_t i = 0; i < numKeys; ++i)
+    assert(result[i] == find_index_i64(intKeys[i], G, V, dictSize));
+
+  // String tensors hold the pointers to the strings.
+  const char **strKeys = (const char **)malloc(numKeys * sizeof(char *));
+  char *buffer = (char *)malloc(numKeys * 16);
+  for (int64_t i = 0; i < numKeys; ++i) {
+    snprintf(buffer + i * 16, 16, "key%d", rand() % 100000);
+    strKeys[i] = buffer + i * 16;
+  }
+  OMTensor *strs = omTensorCreate(strKeys, keysShape, 1, ONNX_TYPE_STRING);
+  find_indices_str(indices, strs, GTensor, VTensor);
+  for (int64_t i = 0; i < numKeys; ++i)
+    assert(result[i] == find_index_str(strKeys[i], G, V, dictSize));
+
+  omTensorDestroy(strs);
+  free(buffer);
+  free(strKeys);
+  omTensorDestroy(indices);
+  omTensorDestroy(ints);
+  omTensorDestroy(VTensor);
+  omTensorDestroy(GTensor);
+}
+
+int main(int argc, char *argv[]) {
+  srand(0);
+  testIntTable();
+  testStrTable();
+  testBatch(100, 7);
+  // Large enough to look up the keys in parallel.
+  testBatch(100000, 1000);
+  printf("OMIndexLookupTest passed\n");
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ OMMemoryPoolTest.c - OMMemoryPool Unit Test -------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the runtime memory pools.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+#define NUM_THREADS 8
+#define NUM_INFERENCES 1000
+#define POOL_SIZE (1 << 16)
+
+// Check that memory pools are aligned and kept across inferences.
+static void testReuse() {
+  char *a = (char *)omMemoryPoolAcquire(1000, 64);
+  assert(a && (uintptr_t)a % 64 == 0);
+  memset(a, 1, 1000);
+  omMemoryPoolRelease(a);
+  // The released memory pool is acquired again.
+  assert(omMemoryPoolAcquire(1000, 64) == a);
+  // Concurrent inferences use different memory pools.
+  char *b = (char *)omMemoryPoolAcquire(1000, 64);
+  assert(b && b != a);
+  memset(b, 2, 1000);
+  omMemoryPoolRelease(a);
+  omMemoryPoolRelease(b);
+  // Larger memory pools than the released ones are allocated.
+  char *c = (char *)omMemoryPoolAcquire(10000, 4096);
+  assert(c && (uintptr_t)c % 4096 == 0 && c != a && c != b);
+  memset(c, 3, 10000);
+  omMemoryPoolRelease(c);
+  assert(omMemoryPoolGetMaxSize() >= 10000 + 4095);
+  omMemoryPoolReleaseAll();
+  omMemoryPoolRelease(NULL);
+}
+
+// Check that the buffer of the caller is used by one inference at a time.
+static void testCallerBuffer() {
+  int64_t size = 2048 + 63;
+  char *buffer = (char *)malloc(size);
+  assert(omMemoryPoolSetBuffer(buffer, size) == 0);
+  char *a = (char *)omMemoryPoolAcquire(2048, 64);
+  assert(a >= buffer && a + 2048 <= buffer + size && (uintptr_t)a % 64 == 0);
+  // The buffer is in use, another memory pool is allocated.
+  char *b = (char *)omMemoryPoolAcquire(2048, 64);
+  assert(b && (b + 2048 <= buffer || b >= buffer + size));
+  // The buffer cannot be replaced while it is in use, but it can while only
+  // memory pools allocated by the runtime are.
+  errno = 0;
+  assert(omMemoryPoolSetBuffer(NULL, 0) == -1 && errno == EBUSY);
+  omMemoryPoolRelease(a);
+  assert(omMemoryPoolSetBuffer(buffer, size) == 0);
+  omMemoryPoolRelease(b);
+  assert(omMemoryPoolAcquire(2048, 64) == a);
+  omMemoryPoolRelease(a);
+  // Memory pools larger than the buffer are allocated.
+  char *c = (char *)omMemoryPoolAcquire(4096, 64);
+  assert(c && (c + 4096 <= buffer || c >= buffer + size));
+  omMemoryPoolRelease(c);
+  assert(omMemoryPoolSetBuffer(NULL, 0) == 0);
+  omMemoryPoolReleaseAll();
+  free(buffer);
+}
+
+// Simulate inferences acquiring a memory pool, and check that the memory
+// pools of concurrent threads do not overlap.
+static void *runInferences(void *arg) {
+  int64_t id = (int64_t)arg;
+  for (int64_t i = 0; i < NUM_INFERENCES; ++i) {
+    char *pool = (char *)omMemoryPoolAcquire(POOL_SIZE, 64);
+    assert(pool && (uintptr_t)pool % 64 == 0);
+    memset(pool, (int)id, POOL_SIZE);
+    for (int64_t j = 0; j < POOL_SIZE; j += 4093)
+      assert(pool[j] == (char)id);
+    omMemoryPoolRelease(pool);
+  }
+  return NULL;
+}
+
+static void testConcurrentThreads() {
+  char *buffer = (char *)malloc(POOL_SIZE + 63);
+  assert(omMemoryPoolSetBuffer(buffer, POOL_SIZE + 63) == 0);
+  pthread_t threads[NUM_THREADS];
+  for (int64_t i = 0; i < NUM_THREADS; ++i)
+    pthread_create(&threads[i], NULL, runInferences, (void *)(i + 1));
+  for (int64_t i = 0; i < NUM_THREADS; ++i)
+    pthread_join(threads[i], NULL);
+  assert(omMemoryPoolSetBuffer(NULL, 0) == 0);
+  omMemoryPoolReleaseAll();
+  free(buffer);
+}
+
+int main() {
+  testReuse();
+  testCallerBuffer();
+  testConcurrentThreads();
+  printf("OMMemoryPoolTest passed\n");
+  return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------ OMNonMaxSuppressionTest.c - OMNonMaxSuppression Unit Test -----===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the NonMaxSuppression runtime function.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Called by the generated code, not part of the runtime API.
+void omTensorNonMaxSuppression(OMTensor *selectedTensor,
+    const OMTensor *boxesTensor, const OMTensor *scoresTensor,
+    int64_t maxOutputPerClass, float iouThreshold, float scoreThreshold,
+    int64_t centerPointBox);
+
+static float min(float a, float b) { return a < b ? a : b; }
+static float max(float a, float b) { return a > b ? a : b; }
+
+// Compute the IOU of two boxes as the python implementation at the end of
+// NonMaxSuppression.cpp.
+static float iou(const float *box1, const float *box2, int64_t centerPointBox) {
+  float y1Min, x1Min, y1Max, x1Max, y2Min, x2Min, y2Max, x2Max, area1, area2;
+  if (centerPointBox) {
+    x1Min = box1[0] - box1[2] / 2;
+    x1Max = box1[0] + box1[2] / 2;
+    y1Min = box1[1] - box1[3] / 2;
+    y1Max = box1[1] + box1[3] / 2;
+    x2Min = box2[0] - box2[2] / 2;
+    x2Max = box2[0] + box2[2] / 2;
+    y2Min = box2[1] - box2[3] / 2;
+    y2Max = box2[1] + box2[3] / 2;
+    area1 = box1[3] * box1[2];
+    area2 = box2[3] * box2[2];
+  } else {
+    y1Min = min(box1[0], box1[2]);
+    y1Max = max(box1[0], box1[2]);
+    x1Min = min(box1[1], box1[3]);
+    x1Max = max(box1[1], box1[3]);
+    y2Min = min(box2[0], box2[2]);
+    y2Max = max(box2[0], box2[2]);
+    x2Min = min(box2[1], box2[3]);
+    x2Max = max(box2[1], box2[3]);
+    area1 = (y1Max - y1Min) * (x1Max - x1Min);
+    area2 = (y2Max - y2Min) * (x2Max - x2Min);
+  }
+  float w = max(min(x1Max, x2Max) - max(x1Min, x2Min), 0);
+  float h = max(min(y1Max, y2Max) - max(y1Min, y2Min), 0);
+  float intersection = w * h;
+  return intersection / (area1 + area2 - intersection + 1e-8f);
+}
+
+// Run NonMaxSuppression on contiguous boxes and scores and compare the rows
+// selected to the ones of the python implementation: the boxes are visited in
+// the descending order of scores, and each selected box removes the boxes it
+// overlaps. Return the number of selected rows.
+static int64_t testNMS(const float *boxes, const float *scores,
+    int64_t numBatches, int64_t numClasses, int64_t numBoxes,
+    int64_t maxOutputPerClass, float iouThreshold, float scoreThreshold,
+    int64_t centerPointBox) {
+  // Bound the number of boxes per class as the lowering does.
+  int64_t maxPerClass = 0;
+  for (int64_t p = 0; p < numBatches * numClasses; ++p) {
+    int64_t count = 0;
+    for (int64_t s = 0; s < numBoxes; ++s)
+      count += scores[p * numBoxes + s] > scoreThreshold;
+    maxPerClass = count > maxPerClass ? count : maxPerClass;
+  }
+  if (maxOutputPerClass > maxPerClass)
+    maxOutputPerClass = maxPerClass;
+  int64_t numRows = numBatches * numClasses * maxOutputPerClass;
+
+  int64_t boxesShape[] = {numBatches, numBoxes, 4};
+  int64_t scoresShape[] = {numBatches, numClasses, numBoxes};
+  int64_t selectedShape[] = {numRows, 3};
+  OMTensor *boxesTensor =
+      omTensorCreate((void *)boxes, boxesShape, 3, ONNX_TYPE_FLOAT);
+  OMTensor *scoresTensor =
+      omTensorCreate((void *)scores, scoresShape, 3, ONNX_TYPE_FLOAT);
+  OMTensor *selectedTensor =
+      omTensorCreateEmpty(selectedShape, 2, ONNX_TYPE_INT64);
+  omTensorNonMaxSuppression(selectedTensor, boxesTensor, scoresTensor,
+      maxOutputPerClass, iouThreshold, scoreThreshold, centerPointBox);
+  const int64_t *selected = (const int64_t *)omTensorGetDataPtr(selectedTensor);
+
+  int64_t *order = (int64_t *)malloc(numBoxes * sizeof(int64_t));
+  char *removed = (char *)malloc(numBoxes);
+  int64_t row = 0;
+  for (int64_t b = 0; b < numBatches; ++b) {
+    for (int64_t c = 0; c < numClasses; ++c) {
+      const float *classScores = scores + (b * numClasses + c) * numBoxes;
+      // Stable insertion sort in the descending order of scores.
+      for (int64_t i = 0; i < numBoxes; ++i) {
+        int64_t j = i;
+        for (; j > 0 && classScores[order[j - 1]] < classScores[i]; --j)
+          order[j] = order[j - 1];
+        order[j] = i;
+      }
+      for (int64_t i = 0; i < numBoxes; ++i)
+        removed[i] = 0;
+      int64_t count = 0;
+      for (int64_t i = 0; i < numBoxes; ++i) {
+        int64_t s = order[i];
+        if (classScores[s] <= scoreThreshold || count >= maxOutputPerClass ||
+            removed[s])
+          continue;
+        assert(row < numRows);
+        if (selected[3 * row] != b || selected[3 * row + 1] != c ||
+            selected[3 * row + 2] != s) {
+          fprintf(stderr, "row %lld: expected [%lld, %lld, %lld], got "
+                          "[%lld, %lld, %lld]\n",
+              (long long)row, (long long)b, (long long)c, (long long)s,
+              (long long)selected[3 * row], (long long)selected[3 * row + 1],
+              (long long)selected[3 * row + 2]);
+          assert(0 && "unexpected NonMaxSuppression result");
+        }
+        row++;
+        count++;
+        const float *box = boxes + (b * numBoxes + s) * 4;
+        for (int64_t o = 0; o < numBoxes; ++o)
+          if (!removed[o] && iou(box, boxes + (b * numBoxes + o) * 4,
+                                 centerPointBox) >= iouThreshold)
+            removed[o] = 1;
+      }
+    }
+  }
+  // The rows that are not used are set to -1.
+  for (int64_t i = 3 * row; i < 3 * numRows; ++i)
+    assert(selected[i] == -1);
+
+  free(removed);
+  free(order);
+  omTensorDestroy(selectedTensor);
+  omTensorDestroy(scoresTensor);
+  omTensorDestroy(boxesTensor);
+  return row;
+}
+
+// Generate random boxes in a small area, so that they overlap, with scores
+// that have ties, and run NonMaxSuppression on them.
+static void testRandom(int64_t numBatches, int64_t numClasses,
+    int64_t numBoxes, int64_t maxOutputPerClass, float iouThreshold,
+    float scoreThreshold, int64_t centerPointBox) {
+  float *boxes = (float *)malloc(numBatches * numBoxes * 4 * sizeof(float));
+  float *scores =
+      (float *)malloc(numBatches * numClasses * numBoxes * sizeof(float));
+  for (int64_t i = 0; i < numBatches * numBoxes * 4; ++i)
+    boxes[i] = (float)(rand() % 1000) / 50;
+  if (centerPointBox)
+    for (int64_t i = 0; i < numBatches * numBoxes; ++i) {
+      boxes[4 * i + 2] /= 4;
+      boxes[4 * i + 3] /= 4;
+    }
+  for (int64_t i = 0; i < numBatches * numClasses * numBoxes; ++i)
+    scores[i] = (float)(rand() % 100) / 100;
+  testNMS(boxes, scores, numBatches, numClasses, numBoxes, maxOutputPerClass,
+      iouThreshold, scoreThreshold, centerPointBox);
+  free(scores);
+  free(boxes);
+}
+
+int main(int argc, char *argv[]) {
+  // Examples of the ONNX NonMaxSuppression tests.
+  float boxes[] = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.1f, 1.0f, 1.1f, 0.0f,
+      -0.1f, 1.0f, 0.9f, 0.0f, 10.0f, 1.0f, 11.0f, 0.0f, 10.1f, 1.0f, 11.1f,
+      0.0f, 100.0f, 1.0f, 101.0f};
+  float flippedBoxes[] = {1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.1f, 1.0f, 1.1f,
+      0.0f, 0.9f, 1.0f, -0.1f, 0.0f, 10.0f, 1.0f, 11.0f, 1.0f, 10.1f, 0.0f,
+      11.1f, 1.0f, 101.0f, 0.0f, 100.0f};
+  float centerBoxes[] = {0.5f, 0.5f, 1.0f, 1.0f, 0.5f, 0.6f, 1.0f, 1.0f, 0.5f,
+      0.4f, 1.0f, 1.0f, 0.5f, 10.5f, 1.0f, 1.0f, 0.5f, 10.6f, 1.0f, 1.0f, 0.5f,
+      100.5f, 1.0f, 1.0f};
+  float scores[] = {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f};
+  float identicalBoxes[40], identicalScores[10];
+  for (int i = 0; i < 10; ++i) {
+    float box[] = {0.0f, 0.0f, 1.0f, 1.0f};
+    memcpy(identicalBoxes + 4 * i, box, sizeof(box));
+    identicalScores[i] = 0.9f;
+  }
+  assert(testNMS(centerBoxes, scores, 1, 1, 6, 3, 0.5f, 0.0f, 1) == 3);
+  assert(testNMS(flippedBoxes, scores, 1, 1, 6, 3, 0.5f, 0.0f, 0) == 3);
+  assert(testNMS(identicalBoxes, identicalScores, 1, 1, 10, 3, 0.5f, 0.0f,
+             0) == 1);
+  assert(testNMS(boxes, scores, 1, 1, 6, 2, 0.5f, 0.0f, 0) == 2);
+  assert(testNMS(boxes, scores, 1, 1, 1, 3, 0.5f, 0.0f, 0) == 1);
+  assert(testNMS(boxes, scores, 1, 1, 6, 3, 0.5f, 0.0f, 0) == 3);
+  assert(testNMS(boxes, scores, 1, 1, 6, 3, 0.5f, 0.4f, 0) == 2);
+  assert(testNMS(boxes, scores, 1, 1, 6, 0, 0.5f, 0.0f, 0) == 0);
+
+  srand(0);
+  for (int64_t center = 0; center <= 1; ++center) {
+    testRandom(2, 3, 50, 10, 0.5f, 0.2f, center);
+    testRandom(1, 2, 100, 100, 0.3f, 0.0f, center);
+    testRandom(3, 1, 40, 5, 0.0f, 0.5f, center);
+    testRandom(2, 2, 30, 30, 1.0f, 0.0f, center);
+  }
+  // Large enough to process the pairs in parallel.
+  testRandom(2, 8, 2000, 50, 0.5f, 0.1f, 0);
+  printf("OMNonMaxSuppressionTest passed\n");
+  return 0;
+}
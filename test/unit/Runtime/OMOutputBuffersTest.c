@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- OMOutputBuffersTest.c - OMOutputBuffers Unit Test ---------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the output buffers supplied by the caller.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Simulate an inference with five outputs of 2x3 floats. The first one is
+// computed in the supplied buffer, the supplied tensor of the second one is
+// larger, and the supplied buffer of the third one is misaligned. The
+// supplied tensors of the last two ones have the size of the output, but
+// another shape or data type.
+static void testOutputs() {
+  int64_t shape[] = {2, 3};
+  int64_t otherShape[] = {4, 3};
+  int64_t transposedShape[] = {3, 2};
+  int64_t size = 6 * sizeof(float);
+  float *misaligned = (float *)((char *)malloc(size + 64) + 4);
+  OMTensor *outputs[] = {
+      omTensorCreateEmpty(shape, 2, ONNX_TYPE_FLOAT),
+      omTensorCreateEmpty(otherShape, 2, ONNX_TYPE_FLOAT),
+      omTensorCreate(misaligned, shape, 2, ONNX_TYPE_FLOAT),
+      omTensorCreateEmpty(transposedShape, 2, ONNX_TYPE_FLOAT),
+      omTensorCreateEmpty(shape, 2, ONNX_TYPE_INT32),
+  };
+  OMTensorList *outputList = omTensorListCreate(outputs, 5);
+  memset(omTensorGetDataPtr(outputs[1]), 0, 2 * size);
+  memset(misaligned, 0, size);
+  memset(omTensorGetDataPtr(outputs[3]), 0, size);
+  memset(omTensorGetDataPtr(outputs[4]), 0, size);
+
+  omOutputBuffersBegin(outputList);
+  OMTensor **results = (OMTensor **)malloc(5 * sizeof(OMTensor *));
+  for (int64_t i = 0; i < 5; ++i) {
+    float *data =
+        (float *)omOutputAlloc(i, ONNX_TYPE_FLOAT, 2, shape, size, 16);
+    assert(data && (i == 0) == (data == omTensorGetDataPtr(outputs[i])));
+    for (int64_t j = 0; j < 6; ++j)
+      data[j] = (float)(10 * i + j);
+    results[i] = omTensorCreateWithOwnership(
+        data, shape, 2, ONNX_TYPE_FLOAT, /*owning=*/1);
+  }
+  OMTensorList *resultList =
+      omOutputBuffersEnd(omTensorListCreateWithOwnership(results, 5, 1));
+
+  // The first result does not own the supplied buffer.
+  assert(omTensorGetOwning(results[0]) == 0);
+  assert(((float *)omTensorGetDataPtr(outputs[0]))[5] == 5);
+  // The second result does not match the supplied tensor.
+  assert(omTensorGetOwning(results[1]) == 1);
+  assert(((float *)omTensorGetDataPtr(outputs[1]))[5] == 0);
+  // The third result is copied.
+  assert(omTensorGetOwning(results[2]) == 1);
+  assert(misaligned[5] == 25);
+  // The last results have another shape or data type than the supplied
+  // tensors, which are left unchanged.
+  for (int64_t i = 3; i < 5; ++i) {
+    assert(omTensorGetOwning(results[i]) == 1);
+    assert(((int32_t *)omTensorGetDataPtr(outputs[i]))[5] == 0);
+  }
+
+  // Allocations outside of an inference with supplied outputs use malloc.
+  void *data = omOutputAlloc(0, ONNX_TYPE_FLOAT, 2, shape, size, 16);
+  assert(data && data != omTensorGetDataPtr(outputs[0]));
+  free(data);
+
+  omTensorListDestroy(resultList);
+  omTensorListDestroy(outputList);
+  free((char *)misaligned - 4);
+}
+
+int main() {
+  testOutputs();
+  printf("OMOutputBuffersTest passed\n");
+  return 0;
+}
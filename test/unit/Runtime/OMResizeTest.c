@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------------- OMResizeTest.c - OMResize Unit Test -------------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the Resize runtime function.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Called by the generated code, not part of the runtime API.
+void omTensorResize(OMTensor *output, const OMTensor *input,
+    const OMTensor *scales, int64_t mode, int64_t coordinateMode,
+    int64_t nearestMode, float cubicCoeffA, int64_t excludeOutside);
+
+enum { NEAREST, LINEAR, CUBIC };
+enum { HALF_PIXEL, ASYMMETRIC, ALIGN_CORNERS, PYTORCH_HALF_PIXEL };
+enum { ROUND_PREFER_FLOOR, ROUND_PREFER_CEIL, FLOOR, CEIL };
+
+typedef struct {
+  int64_t mode, coordinateMode, nearestMode, excludeOutside;
+  float cubicCoeffA;
+} Attributes;
+
+// Compute the input indices and weights of output index x of an axis, as in
+// the ONNX reference implementation. Return the number of taps.
+static int getTaps(const Attributes *attrs, int64_t x, float scale,
+    int64_t inSize, int64_t outSize, int64_t indices[4], double weights[4]) {
+  double xOri;
+  if (attrs->coordinateMode == ASYMMETRIC)
+    xOri = x / (double)scale;
+  else if (attrs->coordinateMode == ALIGN_CORNERS)
+    xOri = outSize == 1 ? 0 : x * (double)(inSize - 1) / (outSize - 1);
+  else if (attrs->coordinateMode == PYTORCH_HALF_PIXEL && outSize == 1)
+    xOri = 0;
+  else
+    xOri = (x + 0.5) / scale - 0.5;
+
+  int taps = attrs->mode == NEAREST ? 1 : (attrs->mode == LINEAR ? 2 : 4);
+  double r = xOri - floor(xOri);
+  int64_t first = (int64_t)floor(xOri) - (taps == 4 ? 1 : 0);
+  if (attrs->mode == NEAREST) {
+    weights[0] = 1;
+    if (attrs->nearestMode == FLOOR)
+      first = (int64_t)floor(xOri);
+    else if (attrs->nearestMode == CEIL)
+      first = (int64_t)ceil(xOri);
+    else if (r == 0.5)
+      first += attrs->nearestMode == ROUND_PREFER_CEIL;
+    else
+      first += r > 0.5;
+  } else if (attrs->mode == LINEAR) {
+    weights[0] = 1 - r;
+    weights[1] = r;
+  } else {
+    double a = attrs->cubicCoeffA;
+    for (int t = 0; t < 4; ++t) {
+      double d = fabs(r + 1 - t);
+      weights[t] = d <= 1 ? ((a + 2) * d - (a + 3)) * d * d + 1
+                          : ((a * d - 5 * a) * d + 8 * a) * d - 4 * a;
+    }
+  }
+  double sum = 0;
+  for (int t = 0; t < taps; ++t) {
+    indices[t] = first + t;
+    if (indices[t] < 0 || indices[t] >= inSize) {
+      indices[t] = indices[t] < 0 ? 0 : inSize - 1;
+      if (attrs->excludeOutside)
+        weights[t] = 0;
+    }
+    sum += weights[t];
+  }
+  if (attrs->excludeOutside)
+    for (int t = 0; t < taps; ++t)
+      weights[t] /= sum;
+  return taps;
+}
+
+// Interpolate output element offset of a contiguous tensor from the axes d
+// and after, by recursing over the taps of axis d.
+static double interpolate(const Attributes *attrs, const double *input,
+    const int64_t *inShape, const int64_t *outShape, const float *scales,
+    int64_t rank, int64_t d, const int64_t *outIndices) {
+  if (d == rank)
+    return input[0];
+  int64_t inner = 1;
+  for (int64_t e = d + 1; e < rank; ++e)
+    inner *= inShape[e];
+  int64_t indices[4];
+  double weights[4];
+  int taps = getTaps(attrs, outIndices[d], scales[d], inShape[d], outShape[d],
+      indices, weights);
+  double value = 0;
+  for (int t = 0; t < taps; ++t)
+    value += weights[t] * interpolate(attrs, input + indices[t] * inner,
+                              inShape, outShape, scales, rank, d + 1,
+                              outIndices);
+  return value;
+}
+
+static float halfToFloat(uint16_t half) {
+  int exponent = (half >> 10) & 0x1f, mantissa = half & 0x3ff;
+  float value = exponent ? ldexpf((float)(mantissa | 0x400), exponent - 25)
+                         : ldexpf((float)mantissa, -24);
+  return half & 0x8000 ? -value : value;
+}
+
+// Resize a tensor of the given type whose element i is values[i % 11], and
+// compare every output element to the reference interpolation, with the
+// tolerance of the type.
+static void testResize(OM_DATA_TYPE dataType, const Attributes *attrs,
+    int64_t rank, const int64_t *inShape, const float *scales,
+    const int64_t *sizes) {
+  static const double values[] = {
+      3, 250, 17, 96, 0, 128, 255, 40, 77, 201, 9};
+  int64_t outShape[4], inSize = 1, outSize = 1;
+  float scaleValues[4];
+  for (int64_t d = 0; d < rank; ++d) {
+    if (sizes) {
+      outShape[d] = sizes[d];
+      scaleValues[d] = (float)sizes[d] / inShape[d];
+    } else {
+      outShape[d] = (int64_t)(inShape[d] * scales[d]);
+      scaleValues[d] = scales[d];
+    }
+    inSize *= inShape[d];
+    outSize *= outShape[d];
+  }
+  OMTensor *input = omTensorCreateEmpty((int64_t *)inShape, rank, dataType);
+  OMTensor *output = omTensorCreateEmpty(outShape, rank, dataType);
+  int64_t scalesShape[] = {rank};
+  OMTensor *scalesTensor =
+      omTensorCreate(scaleValues, scalesShape, 1, ONNX_TYPE_FLOAT);
+  double *reference = (double *)malloc(inSize * sizeof(double));
+  void *data = omTensorGetDataPtr(input);
+  for (int64_t i = 0; i < inSize; ++i) {
+    double value = values[i % 11];
+    if (dataType == ONNX_TYPE_FLOAT) {
+      value = value / 8 - 10;
+      ((float *)data)[i] = (float)value;
+    } else if (dataType == ONNX_TYPE_FLOAT16) {
+      // 0x4000 + v * 4 is 2 + v / 128.
+      ((uint16_t *)data)[i] = 0x4000 + (uint16_t)value * 4;
+      value = halfToFloat(((uint16_t *)data)[i]);
+    } else if (dataType == ONNX_TYPE_INT8) {
+      value -= 128;
+      ((int8_t *)data)[i] = (int8_t)value;
+    } else {
+      ((uint8_t *)data)[i] = (uint8_t)value;
+    }
+    reference[i] = value;
+  }
+  omTensorResize(output, input, scalesTensor, attrs->mode,
+      attrs->coordinateMode, attrs->nearestMode, attrs->cubicCoeffA,
+      attrs->excludeOutside);
+
+  const void *result = omTensorGetDataPtr(output);
+  int64_t outIndices[4];
+  for (int64_t i = 0; i < outSize; ++i) {
+    for (int64_t d = rank - 1, rest = i; d >= 0; --d) {
+      outIndices[d] = rest % outShape[d];
+      rest /= outShape[d];
+    }
+    double expected = interpolate(attrs, reference, inShape, outShape,
+        scaleValues, rank, 0, outIndices);
+    double actual, tolerance;
+    if (dataType == ONNX_TYPE_FLOAT) {
+      actual = ((const float *)result)[i];
+      tolerance = 1e-4 * (1 + fabs(expected));
+    } else if (dataType == ONNX_TYPE_FLOAT16) {
+      actual = halfToFloat(((const uint16_t *)result)[i]);
+      tolerance = 2e-3 * (1 + fabs(expected));
+    } else {
+      double low = dataType == ONNX_TYPE_INT8 ? -128 : 0;
+      actual = dataType == ONNX_TYPE_INT8 ? ((const int8_t *)result)[i]
+                                          : ((const uint8_t *)result)[i];
+      expected = fmin(fmax(expected, low), low + 255);
+      tolerance = 0.51;
+    }
+    if (fabs(actual - expected) > tolerance) {
+      fprintf(stderr, "element %lld: expected %f, got %f\n", (long long)i,
+          expected, actual);
+      assert(0 && "unexpected Resize result");
+    }
+  }
+  free(reference);
+  omTensorDestroy(scalesTensor);
+  omTensorDestroy(output);
+  omTensorDestroy(input);
+}
+
+int main(int argc, char *argv[]) {
+  int64_t image[] = {2, 3, 5, 7};
+  float upsample[] = {1, 1, 2, 2.5f};
+  float downsample[] = {1, 1, 0.6f, 0.5f};
+  float allAxes[] = {1.5f, 0.7f, 1.4f, 1};
+  int64_t sizes[] = {1, 5, 9, 4};
+  int64_t row[] = {9};
+  float rowScale[] = {1.7f};
+
+  OM_DATA_TYPE types[] = {
+      ONNX_TYPE_FLOAT, ONNX_TYPE_FLOAT16, ONNX_TYPE_UINT8, ONNX_TYPE_INT8};
+  for (int type = 0; type < 4; ++type) {
+    for (int64_t mode = NEAREST; mode <= CUBIC; ++mode) {
+      for (int64_t coordinateMode = HALF_PIXEL;
+           coordinateMode <= PYTORCH_HALF_PIXEL; ++coordinateMode) {
+        for (int64_t nearestMode = ROUND_PREFER_FLOOR; nearestMode <= CEIL;
+             ++nearestMode) {
+          if (mode != NEAREST && nearestMode != ROUND_PREFER_FLOOR)
+            continue;
+          for (int64_t exclude = 0; exclude <= (mode == CUBIC); ++exclude) {
+            Attributes attrs = {
+                mode, coordinateMode, nearestMode, exclude, -0.75f};
+            testResize(types[type], &attrs, 4, image, upsample, NULL);
+            testResize(types[type], &attrs, 4, image, downsample, NULL);
+            testResize(types[type], &attrs, 4, image, allAxes, NULL);
+            testResize(types[type], &attrs, 4, image, NULL, sizes);
+            testResize(types[type], &attrs, 1, row, rowScale, NULL);
+          }
+        }
+      }
+    }
+  }
+  // Large enough to resize the rows in parallel, with the cubic coefficient
+  // of PyTorch.
+  Attributes cubic = {CUBIC, HALF_PIXEL, ROUND_PREFER_FLOOR, 0, -0.5f};
+  int64_t large[] = {2, 8, 40, 60};
+  float largeScales[] = {1, 1, 2, 2};
+  float largeAllAxes[] = {1, 2, 2, 0.5f};
+  testResize(ONNX_TYPE_FLOAT, &cubic, 4, large, largeScales, NULL);
+  testResize(ONNX_TYPE_UINT8, &cubic, 4, large, largeAllAxes, NULL);
+  printf("OMResizeTest passed\n");
+  return 0;
+}
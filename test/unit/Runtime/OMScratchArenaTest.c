@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- OMScratchArenaTest.c - OMScratchArena Unit Test -----------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the runtime scratch arenas.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+#define NUM_THREADS 8
+#define NUM_INFERENCES 1000
+
+// Check that buffers are aligned and that freed buffers are reused.
+static void testReuse() {
+  char *a = (char *)omScratchAlloc(1000, 64);
+  assert(a && (uintptr_t)a % 64 == 0);
+  memset(a, 1, 1000);
+  char *b = (char *)omScratchAlloc(4096, 4096);
+  assert(b && (uintptr_t)b % 4096 == 0 && b != a);
+  memset(b, 2, 4096);
+  omScratchFree(a);
+  omScratchFree(b);
+  // The smallest buffer that fits is reused.
+  assert(omScratchAlloc(1000, 64) == a);
+  assert(omScratchAlloc(500, 4096) == b);
+  omScratchFree(a);
+  omScratchFree(b);
+  // Larger buffers than the freed ones are allocated.
+  char *c = (char *)omScratchAlloc(10000, 8);
+  assert(c && c != a && c != b);
+  memset(c, 3, 10000);
+  omScratchFree(c);
+  omScratchRelease();
+  omScratchFree(NULL);
+}
+
+// Simulate inferences allocating a memory pool and temporary buffers, and
+// check that the buffers of concurrent threads do not overlap.
+static void *runInferences(void *arg) {
+  int64_t id = (int64_t)arg;
+  void *firstPool = NULL;
+  for (int64_t i = 0; i < NUM_INFERENCES; ++i) {
+    char *pool = (char *)omScratchAlloc(1 << 16, 64);
+    char *tmp = (char *)omScratchAlloc(128 + i % 7, 16);
+    assert(pool && tmp);
+    memset(pool, (int)id, 1 << 16);
+    memset(tmp, (int)id, 128);
+    for (int64_t j = 0; j < (1 << 16); j += 4093)
+      assert(pool[j] == (char)id);
+    assert(tmp[127] == (char)id);
+    // The memory pool is allocated once per thread.
+    if (i == 0)
+      firstPool = pool;
+    assert(pool == firstPool);
+    omScratchFree(tmp);
+    omScratchFree(pool);
+  }
+  return NULL;
+}
+
+static void testConcurrentThreads() {
+  pthread_t threads[NUM_THREADS];
+  for (int64_t i = 0; i < NUM_THREADS; ++i)
+    pthread_create(&threads[i], NULL, runInferences, (void *)(i + 1));
+  for (int64_t i = 0; i < NUM_THREADS; ++i)
+    pthread_join(threads[i], NULL);
+}
+
+int main() {
+  testReuse();
+  testConcurrentThreads();
+  printf("OMScratchArenaTest passed\n");
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------------- OMSortTest.c - OMSort Unit Test ---------------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the sort runtime function.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Called by the generated code, not part of the runtime API.
+void omTensorSort(OMTensor *orderTensor, const OMTensor *inputTensor,
+    uint64_t axis, uint64_t ascending);
+
+// Patterns of the input of the sorts.
+enum { RANDOM, SORTED, REVERSED, EQUAL, PIPE_ORGAN };
+
+static double getValue(int pattern, int64_t i, int64_t n, int numValues) {
+  switch (pattern) {
+  case SORTED:
+    return (double)i;
+  case REVERSED:
+    return (double)(n - i);
+  case EQUAL:
+    return 1.0;
+  case PIPE_ORGAN:
+    return (double)(i < n / 2 ? i : n - i);
+  default:
+    return (double)(rand() % numValues - numValues / 2);
+  }
+}
+
+// Sort a 2D tensor of the given type along axis, and check that the
+// elements are in order, with equal elements in the order of their indices.
+#define DEFINE_TEST(fname, typeName, dtype)                                    \
+  static void test##fname(int64_t d0, int64_t d1, int64_t axis, int ascending, \
+      int pattern, int numValues) {                                            \
+    int64_t shape[] = {d0, d1};                                                \
+    OMTensor *input = omTensorCreateEmpty(shape, 2, dtype);                    \
+    OMTensor *order = omTensorCreateEmpty(shape, 2, ONNX_TYPE_INT64);          \
+    typeName *data = (typeName *)omTensorGetDataPtr(input);                    \
+    uint64_t *result = (uint64_t *)omTensorGetDataPtr(order);                  \
+    int64_t n = shape[axis];                                                   \
+    for (int64_t i0 = 0; i0 < d0; ++i0)                                        \
+      for (int64_t i1 = 0; i1 < d1; ++i1) {                                    \
+        int64_t i = axis == 0 ? i0 : i1;                                       \
+        data[i0 * d1 + i1] = (typeName)getValue(pattern, i, n, numValues);     \
+        result[i0 * d1 + i1] = i;                                              \
+      }                                                                        \
+    omTensorSort(order, input, axis, ascending);                               \
+                                                                               \
+    int64_t stride = axis == 0 ? d1 : 1;                                       \
+    char *seen = (char *)malloc(n);                                            \
+    for (int64_t s = 0; s < (axis == 0 ? d1 : d0); ++s) {                      \
+      int64_t offset = axis == 0 ? s : s * d1;                                 \
+      const typeName *slice = data + offset;                                   \
+      const uint64_t *sliceOrder = result + offset;                            \
+      memset(seen, 0, n);                                                      \
+      for (int64_t j = 0; j < n; ++j) {                                        \
+        uint64_t index = sliceOrder[j * stride];                               \
+        assert(index < (uint64_t)n && !seen[index]);                           \
+        seen[index] = 1;                                                       \
+        if (j == 0)                                                            \
+          continue;                                                            \
+        uint64_t prev = sliceOrder[(j - 1) * stride];                          \
+        typeName x = slice[prev * stride], y = slice[index * stride];          \
+        assert(ascending ? x <= y : x >= y);                                   \
+        assert(x != y || prev < index);                                        \
+      }                                                                        \
+    }                                                                          \
+    free(seen);                                                                \
+    omTensorDestroy(order);                                                    \
+    omTensorDestroy(input);                                                    \
+  }
+
+DEFINE_TEST(Float, float, ONNX_TYPE_FLOAT)
+DEFINE_TEST(Double, double, ONNX_TYPE_DOUBLE)
+DEFINE_TEST(Int8, int8_t, ONNX_TYPE_INT8)
+DEFINE_TEST(Uint8, uint8_t, ONNX_TYPE_UINT8)
+DEFINE_TEST(Int16, int16_t, ONNX_TYPE_INT16)
+DEFINE_TEST(Int32, int32_t, ONNX_TYPE_INT32)
+DEFINE_TEST(Int64, int64_t, ONNX_TYPE_INT64)
+
+// Check the order of float16 values, including infinities and zeros.
+static void testFloat16() {
+  // 1.5, -0, -2, 65504, -inf, +0, 0.25 and a subnormal.
+  uint16_t halves[] = {
+      0x3e00, 0x8000, 0xc000, 0x7bff, 0xfc00, 0x0000, 0x3400, 0x0001};
+  int64_t shape[] = {8};
+  uint64_t result[8];
+  uint64_t expected[] = {4, 2, 1, 5, 7, 6, 0, 3};
+  OMTensor *input = omTensorCreate(halves, shape, 1, ONNX_TYPE_FLOAT16);
+  OMTensor *order = omTensorCreate(result, shape, 1, ONNX_TYPE_INT64);
+  for (uint64_t i = 0; i < 8; ++i)
+    result[i] = i;
+  omTensorSort(order, input, 0, 1);
+  assert(memcmp(result, expected, sizeof(expected)) == 0);
+  omTensorDestroy(order);
+  omTensorDestroy(input);
+}
+
+int main(int argc, char *argv[]) {
+  srand(0);
+  for (int ascending = 0; ascending <= 1; ++ascending) {
+    for (int pattern = RANDOM; pattern <= PIPE_ORGAN; ++pattern) {
+      for (int64_t axis = 0; axis < 2; ++axis) {
+        testFloat(7, 300, axis, ascending, pattern, 50);
+        testFloat(7, 5000, axis, ascending, pattern, 1000000);
+        testDouble(9, 1000, axis, ascending, pattern, 1000);
+        testInt8(5, 300, axis, ascending, pattern, 200);
+        testUint8(5, 20, axis, ascending, pattern, 10);
+        testInt16(5, 3000, axis, ascending, pattern, 60000);
+        testInt32(5, 3000, axis, ascending, pattern, 100);
+        testInt64(5, 3000, axis, ascending, pattern, 100000);
+      }
+    }
+    // Large enough to sort the slices in parallel.
+    testFloat(64, 1000, 1, ascending, RANDOM, 1000);
+    testInt8(64, 1000, 1, ascending, RANDOM, 200);
+  }
+  testFloat16();
+  printf("OMSortTest passed\n");
+  return 0;
+}
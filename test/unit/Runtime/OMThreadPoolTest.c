@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ OMThreadPoolTest.c - OMThreadPool Unit Test -------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the runtime thread pool.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+#define NUM_ITERATIONS 100003
+
+static int32_t visits[NUM_ITERATIONS];
+
+static void visit(int64_t begin, int64_t end, void *ctx) {
+  int32_t *counts = (int32_t *)ctx;
+  assert(0 <= begin && begin < end && end <= NUM_ITERATIONS);
+  for (int64_t i = begin; i < end; ++i)
+    counts[i]++;
+}
+
+static void nestedVisit(int64_t begin, int64_t end, void *ctx) {
+  // Nested parallel loops are run by the calling thread.
+  for (int64_t i = begin; i < end; ++i)
+    omParallelFor(visit, 10, (int32_t *)ctx + 10 * i);
+}
+
+// Check that each iteration is executed exactly once.
+static void testParallelFor(int64_t numThreads, int64_t numIterations) {
+  omSetNumThreads(numThreads);
+  memset(visits, 0, sizeof(visits));
+  omParallelFor(visit, numIterations, visits);
+  for (int64_t i = 0; i < NUM_ITERATIONS; ++i)
+    assert(visits[i] == (i < numIterations ? 1 : 0));
+}
+
+static void testNestedParallelFor(int64_t numThreads) {
+  omSetNumThreads(numThreads);
+  memset(visits, 0, sizeof(visits));
+  omParallelFor(nestedVisit, 1000, visits);
+  for (int64_t i = 0; i < NUM_ITERATIONS; ++i)
+    assert(visits[i] == (i < 10000 ? 1 : 0));
+}
+
+int main() {
+  int64_t numThreads[] = {1, 2, 3, 8, 0};
+  for (int i = 0; i < 5; ++i) {
+    testParallelFor(numThreads[i], 0);
+    testParallelFor(numThreads[i], 1);
+    testParallelFor(numThreads[i], 5);
+    testParallelFor(numThreads[i], NUM_ITERATIONS);
+    // The pool is reused across loops.
+    testParallelFor(numThreads[i], NUM_ITERATIONS - 1);
+    testNestedParallelFor(numThreads[i]);
+  }
+  omSetNumThreads(4);
+  assert(omGetNumThreads() == 4);
+  omSetNumThreads(0);
+  assert(omGetNumThreads() >= 1);
+  printf("OMThreadPoolTest passed\n");
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------------- OMTopKTest.c - OMTopK Unit Test ---------------------===//
+//
+// Copyright 2023 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the TopK runtime function.
+//
+//===----------------------------------------------------------------------===//
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OnnxMlirRuntime.h"
+
+// Called by the generated code, not part of the runtime API.
+void omTensorTopK(OMTensor *indicesTensor, const OMTensor *inputTensor,
+    int64_t axis, int64_t largest);
+
+// Return whether element i of the slice at offset is before element j.
+static int isBefore(
+    const float *data, int64_t stride, int64_t i, int64_t j, int largest) {
+  float x = data[i * stride], y = data[j * stride];
+  if (x != y)
+    return largest ? x > y : x < y;
+  return i < j;
+}
+
+// Select the top k elements of a 3D tensor along axis, and compare them to a
+// selection by repeatedly taking the best remaining element.
+static void testFloat(int64_t d0, int64_t d1, int64_t d2, int64_t axis,
+    int64_t k, int largest, int numValues) {
+  int64_t shape[] = {d0, d1, d2};
+  OMTensor *input = omTensorCreateEmpty(shape, 3, ONNX_TYPE_FLOAT);
+  float *data = (float *)omTensorGetDataPtr(input);
+  int64_t size = d0 * d1 * d2;
+  // Few distinct values to check the order of equal elements.
+  for (int64_t i = 0; i < size; ++i)
+    data[i] = (float)(rand() % numValues) - numValues / 2;
+
+  int64_t indicesShape[] = {d0, d1, d2};
+  indicesShape[axis] = k;
+  OMTensor *indices = omTensorCreateEmpty(indicesShape, 3, ONNX_TYPE_INT64);
+  int64_t *result = (int64_t *)omTensorGetDataPtr(indices);
+  omTensorTopK(indices, input, axis, largest);
+
+  const int64_t *strides = omTensorGetStrides(input);
+  const int64_t *indicesStrides = omTensorGetStrides(indices);
+  int64_t n = shape[axis];
+  char *taken = (char *)malloc(n);
+  for (int64_t i0 = 0; i0 < (axis == 0 ? 1 : d0); ++i0)
+    for (int64_t i1 = 0; i1 < (axis == 1 ? 1 : d1); ++i1)
+      for (int64_t i2 = 0; i2 < (axis == 2 ? 1 : d2); ++i2) {
+        const float *slice =
+            data + i0 * strides[0] + i1 * strides[1] + i2 * strides[2];
+        const int64_t *sliceResult = result + i0 * indicesStrides[0] +
+                                     i1 * indicesStrides[1] +
+                                     i2 * indicesStrides[2];
+        memset(taken, 0, n);
+        for (int64_t j = 0; j < k; ++j) {
+          int64_t best = -1;
+          for (int64_t i = 0; i < n; ++i)
+            if (!taken[i] && (best < 0 || isBefore(slice, strides[axis], i,
+                                              best, largest)))
+              best = i;
+          taken[best] = 1;
+          assert(sliceResult[j * indicesStrides[axis]] == best);
+        }
+      }
+  free(taken);
+  omTensorDestroy(indices);
+  omTensorDestroy(input);
+}
+
+// Check the selection of integers and float16 values, whose values are
+// compared after conversion.
+static void testTypes() {
+  int64_t shape[] = {6};
+  int64_t indicesShape[] = {3};
+  int32_t ints[] = {4, -7, 9, 4, 0, 9};
+  // 1.5, -2, 65504, -inf, 0.25 and a subnormal.
+  uint16_t halves[] = {0x3e00, 0xc000, 0x7bff, 0xfc00, 0x3400, 0x0001};
+  OMTensor *indices = omTensorCreateEmpty(indicesShape, 1, ONNX_TYPE_INT64);
+  int64_t *result = (int64_t *)omTensorGetDataPtr(indices);
+
+  OMTensor *input = omTensorCreate(ints, shape, 1, ONNX_TYPE_INT32);
+  omTensorTopK(indices, input, 0, 1);
+  assert(result[0] == 2 && result[1] == 5 && result[2] == 0);
+  omTensorTopK(indices, input, 0, 0);
+  assert(result[0] == 1 && result[1] == 4 && result[2] == 0);
+  omTensorDestroy(input);
+
+  input = omTensorCreate(halves, shape, 1, ONNX_TYPE_FLOAT16);
+  omTensorTopK(indices, input, 0, 1);
+  assert(result[0] == 2 && result[1] == 0 && result[2] == 4);
+  omTensorTopK(indices, input, 0, 0);
+  assert(result[0] == 3 && result[1] == 1 && result[2] == 5);
+  omTensorDestroy(input);
+  omTensorDestroy(indices);
+}
+
+int main(int argc, char *argv[]) {
+  srand(0);
+  for (int largest = 0; largest <= 1; ++largest) {
+    for (int64_t axis = 0; axis < 3; ++axis) {
+      testFloat(3, 5, 7, axis, 1, largest, 4);
+      testFloat(3, 5, 7, axis, 3, largest, 4);
+      testFloat(3, 5, 7, axis, axis == 0 ? 3 : (axis == 1 ? 5 : 7), largest,
+          100);
+    }
+    // Large enough to select the slices in parallel.
+    testFloat(64, 1000, 2, 1, 10, largest, 1000);
+    testFloat(64, 2, 1000, 2, 500, largest, 50);
+  }
+  testTypes();
+  printf("OMTopKTest passed\n");
+  return 0;
+}